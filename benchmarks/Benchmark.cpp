@@ -0,0 +1,72 @@
+#include "Benchmark.h"
+#include <iomanip>
+#include <iostream>
+
+/* *************************************************************************
+                        ---------- CONSOLE OUTPUT ----------
+   *************************************************************************  */
+
+void BenchmarkRecorder::printProgress(const BenchmarkResult &result) const
+{
+    std::cerr << std::left << std::setw(12) << result.group << std::setw(48) << result.name << std::right
+              << std::fixed << std::setprecision(3) << std::setw(14) << result.perCallUs << " us/call"
+              << std::setw(12) << result.rows << " rows\n";
+}
+
+/* *************************************************************************
+                         ---------- JSON REPORT ----------
+   *************************************************************************  */
+
+static void writeJsonString(std::ostream &out, const std::string &text)
+{
+    out << '"';
+    for (char c : text)
+    {
+        if (c == '"' || c == '\\')
+            out << '\\';
+        out << c;
+    }
+    out << '"';
+}
+
+void BenchmarkRecorder::writeJson(std::ostream &out, const SeedVolumes &volumes) const
+{
+    out << std::fixed << std::setprecision(3);
+    out << "{\n";
+    out << "  \"sqlite_version\": ";
+    writeJsonString(out, sqlite3_libversion());
+    out << ",\n";
+    out << "  \"volumes\": {\"users\": " << volumes.users << ", \"resources\": " << volumes.resources
+        << ", \"transactions\": " << volumes.transactions << "},\n";
+    out << "  \"results\": [\n";
+
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const BenchmarkResult &r = results[i];
+        out << "    {\"group\": ";
+        writeJsonString(out, r.group);
+        out << ", \"name\": ";
+        writeJsonString(out, r.name);
+        out << ", \"iterations\": " << r.iterations << ", \"rows\": " << r.rows
+            << ", \"total_ms\": " << r.totalMs << ", \"per_call_us\": " << r.perCallUs << "}"
+            << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+
+    out << "  ]\n}\n";
+}
+
+/* *************************************************************************
+                          ---------- CSV REPORT ----------
+   *************************************************************************  */
+
+void BenchmarkRecorder::writeCsv(std::ostream &out, const SeedVolumes &volumes) const
+{
+    out << std::fixed << std::setprecision(3);
+    out << "group,name,users,resources,transactions,iterations,rows,total_ms,per_call_us\n";
+    for (const BenchmarkResult &r : results)
+    {
+        out << r.group << ',' << r.name << ',' << volumes.users << ',' << volumes.resources << ','
+            << volumes.transactions << ',' << r.iterations << ',' << r.rows << ','
+            << r.totalMs << ',' << r.perCallUs << '\n';
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "infrastructure/database/DataSeeder.h"
+
+// One timed scenario. "rows" is whatever the scenario processed in total
+// (records read, transactions scanned, ...) so throughput can be derived.
+struct BenchmarkResult
+{
+    std::string group;
+    std::string name;
+    int iterations;
+    long long rows;
+    double totalMs;
+    double perCallUs;
+};
+
+// Runs scenarios and keeps their timings for the JSON/CSV report.
+class BenchmarkRecorder
+{
+private:
+    std::vector<BenchmarkResult> results;
+
+public:
+    // body(i) is called `iterations` times and returns the rows it touched.
+    template <typename Body>
+    void measure(const std::string &group, const std::string &name, int iterations, Body body)
+    {
+        long long rows = 0;
+        auto started = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++)
+            rows += body(i);
+        double totalMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+
+        results.push_back({group, name, iterations, rows, totalMs, totalMs * 1000.0 / iterations});
+        printProgress(results.back());
+    }
+
+    const std::vector<BenchmarkResult> &getResults() const { return results; }
+
+    void printProgress(const BenchmarkResult &result) const;
+    void writeJson(std::ostream &out, const SeedVolumes &volumes) const;
+    void writeCsv(std::ostream &out, const SeedVolumes &volumes) const;
+};
+
+// Scenario groups, one per source file.
+void runDateBenchmarks(BenchmarkRecorder &recorder, int iterations);
+void runHotPathBenchmarks(BenchmarkRecorder &recorder, sqlite3 *db, StatementCache &statements,
+                          const SeedVolumes &volumes, int iterations, int repeats);
@@ -0,0 +1,135 @@
+// Benchmark suite for the repository and service hot paths.
+//
+//     LibraryBenchmarks [--users N] [--resources N] [--transactions N]
+//                       [--iterations N] [--repeats N] [--seed N]
+//                       [--db FILE] [--format json|csv] [--output FILE]
+//
+// A fresh database is built from synthetic data (10k rows per table by
+// default, scale up with the volume options), every scenario is timed, and the
+// results are written as JSON or CSV to stdout or --output. Progress goes to stderr so
+// stdout can be redirected straight into a results file.
+
+#include "Benchmark.h"
+#include "infrastructure/database/DatabaseInitializer.h"
+#include "infrastructure/database/StatementCache.h"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+static void printUsage()
+{
+    std::cerr << "Usage: LibraryBenchmarks [--users N] [--resources N] [--transactions N]\n"
+              << "                         [--iterations N] [--repeats N] [--seed N]\n"
+              << "                         [--db FILE] [--format json|csv] [--output FILE]\n";
+}
+
+int main(int argc, char *argv[])
+{
+    SeedVolumes volumes;
+    int iterations = 2000;
+    int repeats = 3;
+    unsigned seed = 7;
+    std::string dbFile = "benchmark.db";
+    std::string format = "json";
+    std::string outputFile;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string option = argv[i];
+        if (option == "--help")
+        {
+            printUsage();
+            return 0;
+        }
+        if (i + 1 >= argc)
+        {
+            printUsage();
+            return 1;
+        }
+
+        std::string value = argv[++i];
+        if (option == "--users")
+            volumes.users = std::atoi(value.c_str());
+        else if (option == "--resources")
+            volumes.resources = std::atoi(value.c_str());
+        else if (option == "--transactions")
+            volumes.transactions = std::atoi(value.c_str());
+        else if (option == "--iterations")
+            iterations = std::atoi(value.c_str());
+        else if (option == "--repeats")
+            repeats = std::atoi(value.c_str());
+        else if (option == "--seed")
+            seed = static_cast<unsigned>(std::strtoul(value.c_str(), nullptr, 10));
+        else if (option == "--db")
+            dbFile = value;
+        else if (option == "--format")
+            format = value;
+        else if (option == "--output")
+            outputFile = value;
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+
+    if (volumes.users <= 0 || volumes.resources <= 0 || volumes.transactions < 0 ||
+        iterations <= 0 || repeats <= 0 || (format != "json" && format != "csv"))
+    {
+        printUsage();
+        return 1;
+    }
+
+    // Always start from an empty database so runs are comparable.
+    std::remove(dbFile.c_str());
+    std::remove((dbFile + "-wal").c_str());
+    std::remove((dbFile + "-shm").c_str());
+
+    DatabaseInitializer database(dbFile);
+    if (!database.open() || !database.createTables() || !database.runMigrations())
+    {
+        std::cerr << "Failed to prepare benchmark database " << dbFile << "\n";
+        return 1;
+    }
+
+    sqlite3 *db = database.getConnection();
+    StatementCache &statements = database.getStatementCache();
+
+    std::cerr << "Generating " << volumes.users << " users, " << volumes.resources << " resources, "
+              << volumes.transactions << " transactions...\n";
+    // The hot-path scenarios run the fine engine as of the same date.
+    DataSeeder seeder(db, statements, seed, CivilDate::fromCivil(2024, 7, 15));
+    if (!seeder.seed(volumes))
+        return 1;
+    std::cerr << "Generated " << seeder.getSummary().totalRows() << " rows in "
+              << seeder.getSummary().elapsedMs / 1000.0 << " s\n\n";
+
+    BenchmarkRecorder recorder;
+    runDateBenchmarks(recorder, iterations * 50);
+    runHotPathBenchmarks(recorder, db, statements, volumes, iterations, repeats);
+
+    if (outputFile.empty())
+    {
+        if (format == "json")
+            recorder.writeJson(std::cout, volumes);
+        else
+            recorder.writeCsv(std::cout, volumes);
+        return 0;
+    }
+
+    std::ofstream out(outputFile);
+    if (!out)
+    {
+        std::cerr << "Cannot write " << outputFile << "\n";
+        return 1;
+    }
+    if (format == "json")
+        recorder.writeJson(out, volumes);
+    else
+        recorder.writeCsv(out, volumes);
+
+    std::cerr << "\nResults written to " << outputFile << "\n";
+    return 0;
+}
@@ -0,0 +1,108 @@
+// Micro-benchmark: per-call cost of the date helpers in src/Utility against the
+// std::tm / mktime versions they replaced. The legacy functions are kept here,
+// verbatim apart from their names, so the comparison can be re-run at any time.
+
+#include "Benchmark.h"
+#include "Utility/date.h"
+#include "Utility/CivilDate.h"
+
+#include <cstdio>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    /* *************************************************************************
+                  ---------- LEGACY IMPLEMENTATIONS (BASELINE) ----------
+       *************************************************************************  */
+
+    std::string legacyGetDueDate(int daysToAdd, std::string currentDate)
+    {
+        int year, month, day;
+        sscanf(currentDate.c_str(), "%d-%d-%d", &year, &month, &day);
+
+        day += daysToAdd;
+
+        if (day > 30)
+        {
+            day -= 30;
+            month += 1;
+            if (month > 12)
+            {
+                month = 1;
+                year += 1;
+            }
+        }
+
+        return std::to_string(year) + "-" + std::to_string(month) + "-" + std::to_string(day);
+    }
+
+    int legacyCalculateDaysOverdue(const std::string &dueDateStr, const std::string &todayStr)
+    {
+        std::tm dueTm = {};
+        std::tm todayTm = {};
+
+        std::istringstream ssDue(dueDateStr);
+        std::istringstream ssToday(todayStr);
+
+        ssDue >> std::get_time(&dueTm, "%Y-%m-%d");
+        ssToday >> std::get_time(&todayTm, "%Y-%m-%d");
+
+        std::time_t dueTime = std::mktime(&dueTm);
+        std::time_t todayTime = std::mktime(&todayTm);
+
+        if (dueTime == -1 || todayTime == -1)
+            return 0;
+
+        double difference = std::difftime(todayTime, dueTime);
+        return difference / (60 * 60 * 24);
+    }
+}
+
+void runDateBenchmarks(BenchmarkRecorder &recorder, int iterations)
+{
+    // A spread of real due dates and "today" values, in the stored format.
+    std::vector<std::string> dueDates;
+    std::vector<std::string> todays;
+    for (int i = 0; i < 1024; i++)
+    {
+        CivilDate due = CivilDate::fromCivil(2020, 1, 1).addDays(i * 3);
+        dueDates.push_back(due.toString());
+        todays.push_back(due.addDays(i % 45).toString());
+    }
+    const std::size_t mask = dueDates.size() - 1;
+
+    recorder.measure("date", "calculateDaysOverdue (legacy mktime)", iterations, [&](int i)
+                     { return legacyCalculateDaysOverdue(dueDates[i & mask], todays[i & mask]) >= 0; });
+    recorder.measure("date", "calculateDaysOverdue", iterations, [&](int i)
+                     { return calculateDaysOverdue(dueDates[i & mask], todays[i & mask]) >= 0; });
+
+    recorder.measure("date", "getDueDate (legacy 30-day months)", iterations, [&](int i)
+                     { return !legacyGetDueDate(14, todays[i & mask]).empty(); });
+    recorder.measure("date", "getDueDate", iterations, [&](int i)
+                     { return !getDueDate(14, todays[i & mask]).empty(); });
+
+    // The fine engine's inner step once "today" has been parsed up front.
+    CivilDate today;
+    CivilDate::parse(todays[0], today);
+    recorder.measure("date", "CivilDate::parse + difference", iterations, [&](int i)
+                     {
+                         CivilDate due;
+                         return CivilDate::parse(dueDates[i & mask], due) && today - due != 0; });
+
+    std::vector<CivilDate> parsedDates(dueDates.size());
+    for (std::size_t i = 0; i < dueDates.size(); i++)
+        CivilDate::parse(dueDates[i], parsedDates[i]);
+
+    // The last digit is stored through a volatile so the formatting cannot be elided.
+    char buffer[10];
+    volatile char lastDigit = 0;
+    recorder.measure("date", "CivilDate::formatIso", iterations, [&](int i)
+                     {
+                         parsedDates[i & mask].formatIso(buffer);
+                         lastDigit = buffer[9];
+                         return 1; });
+}
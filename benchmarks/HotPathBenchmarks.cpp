@@ -0,0 +1,234 @@
+// Timed scenarios for the repository and service calls that scale with the
+// size of the library. Bulk reads run `repeats` times; point lookups and
+// single-user workflows run `iterations` times against random ids.
+
+#include "Benchmark.h"
+#include "infrastructure/database/StatementCache.h"
+#include "infrastructure/repositories/UserRepository.h"
+#include "infrastructure/repositories/AdministratorRepository.h"
+#include "infrastructure/repositories/ResourceRepository.h"
+#include "infrastructure/repositories/CategoryRepository.h"
+#include "infrastructure/repositories/TransactionRepository.h"
+#include "infrastructure/repositories/FineRepository.h"
+#include "infrastructure/repositories/BorrowingHistoryRepository.h"
+#include "infrastructure/repositories/FundRequestRepository.h"
+#include "infrastructure/repositories/MembershipTypeRepository.h"
+#include "infrastructure/repositories/ReservationRepository.h"
+#include "export/TableExporter.h"
+#include "infrastructure/database/ConnectionPool.h"
+#include "services/AdminService.h"
+#include "services/UserService.h"
+#include <atomic>
+#include <cstdio>
+#include <random>
+#include <thread>
+
+void runHotPathBenchmarks(BenchmarkRecorder &recorder, sqlite3 *db, StatementCache &statements,
+                          const SeedVolumes &volumes, int iterations, int repeats)
+{
+    UserRepository userRepo(db, statements);
+    AdministratorRepository adminRepo(db, statements);
+    ResourceRepository resourceRepo(db, statements);
+    CategoryRepository categoryRepo(db, statements);
+    TransactionRepository transactionRepo(db, statements);
+    FineRepository fineRepo(db, statements);
+    BorrowingHistoryRepository historyRepo(db, statements);
+    FundRequestRepository fundRequestRepo(db, statements);
+    MembershipTypeRepository membershipRepo(db, statements);
+    ReservationRepository reservationRepo(db, statements);
+    TableExporter tableExporter(db, statements);
+
+    AdminService adminService(userRepo, fineRepo, resourceRepo, categoryRepo, fundRequestRepo,
+                              transactionRepo, reservationRepo, membershipRepo, historyRepo, adminRepo,
+                              tableExporter);
+    UserService userService(userRepo, resourceRepo, transactionRepo, fineRepo, historyRepo,
+                            fundRequestRepo, membershipRepo);
+
+    // Random ids are drawn up front so the generator is not part of the timing.
+    std::mt19937 random(42);
+    std::vector<int> userIds(iterations);
+    std::vector<int> resourceIds(iterations);
+    for (int i = 0; i < iterations; i++)
+    {
+        userIds[i] = std::uniform_int_distribution<int>(1, volumes.users)(random);
+        resourceIds[i] = std::uniform_int_distribution<int>(1, volumes.resources)(random);
+    }
+
+    /* *************************************************************************
+                         ---------- REPOSITORIES ----------
+       *************************************************************************  */
+
+    recorder.measure("repository", "ResourceRepository::getAll", repeats, [&](int)
+                     { return static_cast<long long>(resourceRepo.getAll().size()); });
+
+    recorder.measure("repository", "ResourceRepository::forEachResource", repeats, [&](int)
+                     {
+                         long long rows = 0;
+                         resourceRepo.forEachResource([&rows](const Resource &)
+                                                      { rows++; });
+                         return rows; });
+
+    recorder.measure("repository", "ResourceRepository::getCatalogueSnapshot (full load)", repeats, [&](int)
+                     {
+                         ResourceRepository freshRepo(db, statements);
+                         return static_cast<long long>(freshRepo.getCatalogueSnapshot().resourceCount()); });
+
+    std::vector<std::uint32_t> availableRows;
+    recorder.measure("repository", "CatalogueSnapshot::collectAvailable", iterations, [&](int)
+                     { return static_cast<long long>(resourceRepo.getCatalogueSnapshot().collectAvailable(availableRows)); });
+
+    recorder.measure("repository", "ResourceRepository::getById", iterations, [&](int i)
+                     { return resourceRepo.getById(resourceIds[i]) ? 1LL : 0LL; });
+
+    // The same lookups against the hottest 100 titles, with and without the LRU cache.
+    ResourceRepository uncachedResourceRepo(db, statements, 0);
+    recorder.measure("repository", "ResourceRepository::getById hot set (no cache)", iterations, [&](int i)
+                     { return uncachedResourceRepo.getById(1 + resourceIds[i] % 100) ? 1LL : 0LL; });
+
+    recorder.measure("repository", "ResourceRepository::getById hot set (cached)", iterations, [&](int i)
+                     { return resourceRepo.getById(1 + resourceIds[i] % 100) ? 1LL : 0LL; });
+
+    recorder.measure("repository", "ResourceRepository::getPageAfter", iterations, [&](int i)
+                     { return static_cast<long long>(resourceRepo.getPageAfter(resourceIds[i], 20).size()); });
+
+    recorder.measure("repository", "ResourceRepository::search", iterations, [&](int i)
+                     { return static_cast<long long>(resourceRepo.search("title " + std::to_string(resourceIds[i] % 100), 20, 0).size()); });
+
+    recorder.measure("repository", "UserRepository::getAllUsers", repeats, [&](int)
+                     { return static_cast<long long>(userRepo.getAllUsers().size()); });
+
+    recorder.measure("repository", "UserRepository::getById", iterations, [&](int i)
+                     { return userRepo.getById(userIds[i]) ? 1LL : 0LL; });
+
+    recorder.measure("repository", "TransactionRepository::getAllTransactions", repeats, [&](int)
+                     { return static_cast<long long>(transactionRepo.getAllTransactions().size()); });
+
+    recorder.measure("repository", "TransactionRepository::getActiveIssues", repeats, [&](int)
+                     { return static_cast<long long>(transactionRepo.getActiveIssues().size()); });
+
+    // Seeded "today"; the range queries walk the integer day indexes.
+    const CivilDate seedToday = CivilDate::fromCivil(2024, 7, 15);
+    recorder.measure("repository", "TransactionRepository::getOverdueIssues", repeats, [&](int)
+                     { return static_cast<long long>(transactionRepo.getOverdueIssues(seedToday).size()); });
+
+    recorder.measure("repository", "TransactionRepository::getIssuesDueBetween (7 days)", iterations, [&](int i)
+                     {
+                         CivilDate from = seedToday.addDays(i % 30);
+                         return static_cast<long long>(transactionRepo.getIssuesDueBetween(from, from.addDays(7)).size()); });
+
+    recorder.measure("repository", "TransactionRepository::getIssuedBetween (1 day)", iterations, [&](int i)
+                     {
+                         CivilDate day = seedToday.addDays(-(i % 365));
+                         return static_cast<long long>(transactionRepo.getIssuedBetween(day, day).size()); });
+
+    recorder.measure("repository", "ReservationRepository::getExpiredBefore", repeats, [&](int)
+                     { return static_cast<long long>(reservationRepo.getExpiredBefore(seedToday).size()); });
+
+    recorder.measure("repository", "TransactionRepository::getByUserId", iterations, [&](int i)
+                     { return static_cast<long long>(transactionRepo.getByUserId(userIds[i]).size()); });
+
+    recorder.measure("repository", "FineRepository::getByUserId", iterations, [&](int i)
+                     { return static_cast<long long>(fineRepo.getByUserId(userIds[i]).size()); });
+
+    recorder.measure("repository", "BorrowingHistoryRepository::forEachUserHistory", repeats, [&](int)
+                     {
+                         long long rows = 0;
+                         historyRepo.forEachUserHistory([&rows](const UserHistoryRow &)
+                                                        { rows++; });
+                         return rows; });
+
+    /* *************************************************************************
+                           ---------- SERVICES ----------
+       *************************************************************************  */
+
+    recorder.measure("service", "AdminService::updateDailyFines", repeats, [&](int)
+                     { return static_cast<long long>(adminService.updateDailyFines("2024-07-15").transactionsScanned); });
+
+    recorder.measure("service", "UserService::searchCatalogue", iterations, [&](int i)
+                     { return static_cast<long long>(userService.searchCatalogue("author " + std::to_string(resourceIds[i] % 1500)).size()); });
+
+    // Runs last among the point workloads because it inserts PENDING requests.
+    recorder.measure("service", "UserService::requestToBorrow", iterations, [&](int i)
+                     { return userService.requestToBorrow(userIds[i], resourceIds[i]).empty() ? 0LL : 1LL; });
+
+    const std::string reportFile = "benchmark_report.txt";
+    recorder.measure("service", "AdminService::generateUserHistoryReport", repeats, [&](int)
+                     { return adminService.generateUserHistoryReport(reportFile) ? 1LL : 0LL; });
+
+    recorder.measure("service", "AdminService::generateIssuedAndOverdueReport", repeats, [&](int)
+                     { return adminService.generateIssuedAndOverdueReport(reportFile) ? 1LL : 0LL; });
+
+    std::remove(reportFile.c_str());
+
+    const std::string exportFile = "benchmark_export.csv";
+    recorder.measure("service", "AdminService::exportTable transactions (CSV)", repeats, [&](int)
+                     {
+                         ExportOptions options;
+                         options.table = "transactions";
+                         return adminService.exportTable(options, exportFile).rows; });
+
+    std::remove(exportFile.c_str());
+
+    /* *************************************************************************
+                        ---------- CONNECTION POOL ----------
+       *************************************************************************  */
+
+    // The same four full-table reads, one after another on the main
+    // connection and then side by side on pooled readers.
+    const int parallelReads = 4;
+    recorder.measure("pool", "4x TransactionRepository::getAllTransactions (sequential)", repeats, [&](int)
+                     {
+                         long long rows = 0;
+                         for (int i = 0; i < parallelReads; i++)
+                             rows += static_cast<long long>(transactionRepo.getAllTransactions().size());
+                         return rows; });
+
+    ConnectionPool pool(sqlite3_db_filename(db, "main"), ConnectionProfile(), parallelReads);
+    if (pool.open())
+    {
+        recorder.measure("pool", "4x TransactionRepository::getAllTransactions (pooled readers)", repeats, [&](int)
+                         {
+                             std::atomic<long long> rows{0};
+                             std::vector<std::thread> workers;
+                             for (int i = 0; i < parallelReads; i++)
+                                 workers.emplace_back([&pool, &rows]
+                                                      {
+                                                          ConnectionPool::ReadLease lease = pool.acquireReader();
+                                                          TransactionRepository reader(lease.connection(), lease.statements());
+                                                          rows += static_cast<long long>(reader.getAllTransactions().size()); });
+                             for (std::thread &worker : workers)
+                                 worker.join();
+                             return rows.load(); });
+    }
+
+    /* *************************************************************************
+                           ---------- BULK WRITES ----------
+       *************************************************************************  */
+
+    // Last, because both add rows. Each call writes a fresh batch of 1000.
+    const int batchRows = 1000;
+    auto makeBatch = [&](int call)
+    {
+        std::vector<Resource> batch;
+        batch.reserve(batchRows);
+        for (int i = 0; i < batchRows; i++)
+            batch.emplace_back(0, "Bulk title " + std::to_string(call * batchRows + i), "Bulk author", "Bulk publisher",
+                               2024, "9790000000000", 1, 1, 1, "", "2024-07-15", true);
+        return batch;
+    };
+
+    recorder.measure("bulk", "ResourceRepository::save x1000 (autocommit)", repeats, [&](int call)
+                     {
+                         std::vector<Resource> batch = makeBatch(call);
+                         long long rows = 0;
+                         for (Resource &resource : batch)
+                             rows += resourceRepo.save(resource) ? 1 : 0;
+                         return rows; });
+
+    recorder.measure("bulk", "ResourceRepository::saveAll x1000", repeats, [&](int call)
+                     {
+                         std::vector<Resource> batch = makeBatch(repeats + call);
+                         BatchSaveResult result;
+                         resourceRepo.saveAll(batch, result);
+                         return static_cast<long long>(result.saved); });
+}
@@ -1,28 +1,73 @@
 #include "PDFGenerator.h"
-#include <fstream>
-#include <cstdlib>
-#include <iostream>
+#include "ReportWriter.h"
+#include <streambuf>
 
-void makePdf(std::string filename, std::string title, std::string contentString)
+namespace
 {
-    // 1. Create the blueprint
-    std::ofstream html("temp_file.html");
-
-    html << "<html><head><style>"
-         << "body { font-family: 'Courier New', Courier, monospace; margin: 50px; }"
-         << "h2 { color: #2c3e50; border-bottom: 1px solid #ccc; }"
-         << ".content { white-space: pre-wrap; font-size: 14px; line-height: 1.5; }"
-         << "</style></head><body>"
-         << "<h2>" << title << "</h2>"
-         << "<div class='content'>" << contentString << "</div>"
-         << "</body></html>";
-
-    html.close();
-
-    // 2. Convert using the exe in your build folder
-    std::string command = "wkhtmltopdf --quiet temp_file.html " + filename;
-    std::system(command.c_str());
-
-    // 3. Cleanup
-    std::remove("temp_file.html");
-}
\ No newline at end of file
+    // Output buffer that cuts whatever is streamed into it at '\n' and hands
+    // each complete line to the report writer.
+    class LineBuffer : public std::streambuf
+    {
+    private:
+        ReportWriter &writer;
+        std::string line;
+
+    protected:
+        int_type overflow(int_type ch) override
+        {
+            if (traits_type::eq_int_type(ch, traits_type::eof()))
+                return traits_type::not_eof(ch);
+
+            char c = traits_type::to_char_type(ch);
+            if (c == '\n')
+            {
+                writer.writeLine(line);
+                line.clear();
+            }
+            else if (c != '\r')
+                line += c;
+            return ch;
+        }
+
+        std::streamsize xsputn(const char *text, std::streamsize count) override
+        {
+            for (std::streamsize i = 0; i < count; i++)
+                overflow(traits_type::to_int_type(text[i]));
+            return count;
+        }
+
+    public:
+        explicit LineBuffer(ReportWriter &reportWriter) : writer(reportWriter) {}
+
+        // Emits a last line that was not terminated by '\n'.
+        void flushPending()
+        {
+            if (!line.empty())
+            {
+                writer.writeLine(line);
+                line.clear();
+            }
+        }
+    };
+}
+
+bool makePdf(const std::string &filename, const std::string &title,
+             const std::function<void(std::ostream &)> &writeBody)
+{
+    std::unique_ptr<ReportWriter> writer = createReportWriter(filename);
+    if (!writer->begin(filename, title))
+        return false;
+
+    LineBuffer buffer(*writer);
+    std::ostream out(&buffer);
+    writeBody(out);
+    buffer.flushPending();
+
+    return writer->finish();
+}
+
+bool makePdf(const std::string &filename, const std::string &title, const std::string &contentString)
+{
+    return makePdf(filename, title, [&contentString](std::ostream &out)
+                   { out << contentString; });
+}
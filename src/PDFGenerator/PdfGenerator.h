@@ -2,8 +2,17 @@
 #define PDF_GENERATOR_H
 
 #include <string>
+#include <ostream>
+#include <functional>
 
-// Function to convert a string to a PDF
-void makePdf(std::string filename, std::string title, std::string body);
+// Writes a report file. The format follows the extension of filename:
+// .html/.htm, .txt, anything else is rendered as PDF. Returns false if the
+// file could not be written.
+bool makePdf(const std::string &filename, const std::string &title, const std::string &body);
+
+// Streaming variant: writeBody prints the report text straight into the page,
+// so large reports never have to be assembled in memory first.
+bool makePdf(const std::string &filename, const std::string &title,
+             const std::function<void(std::ostream &)> &writeBody);
 
 #endif
@@ -0,0 +1,326 @@
+#include "ReportWriter.h"
+#include <cstdio>
+#include <cctype>
+
+/* *************************************************************************
+                     ---------- PAGE GEOMETRY ----------
+   *************************************************************************  */
+
+// A4 portrait in points, Courier 10pt (6pt per glyph) with 12pt leading.
+namespace
+{
+    const int pageWidth = 595;
+    const int pageHeight = 842;
+    const int margin = 50;
+    const int bodyTop = 780;
+    const int leading = 12;
+    const int charsPerLine = (pageWidth - 2 * margin) / 6;
+    const int linesPerPage = (bodyTop - margin) / leading;
+
+    // Fixed object numbers; page i uses content 6 + 2i and page object 7 + 2i.
+    const int catalogObject = 1;
+    const int pagesObject = 2;
+    const int regularFontObject = 3;
+    const int boldFontObject = 4;
+    const int infoObject = 5;
+    const int firstPageObject = 6;
+
+    // Report text is UTF-8, the Courier fonts use WinAnsi (close to Latin-1).
+    // Anything outside Latin-1 is shown as '?'.
+    std::string toLatin1(std::string_view text)
+    {
+        std::string out;
+        out.reserve(text.size());
+
+        for (size_t i = 0; i < text.size(); i++)
+        {
+            unsigned char c = static_cast<unsigned char>(text[i]);
+
+            if (c == '\t')
+                out += "    ";
+            else if (c < 0x80)
+                out += static_cast<char>(c);
+            else if ((c & 0xE0) == 0xC0 && i + 1 < text.size())
+            {
+                unsigned int codePoint = ((c & 0x1Fu) << 6) | (static_cast<unsigned char>(text[++i]) & 0x3Fu);
+                out += codePoint < 0x100 ? static_cast<char>(codePoint) : '?';
+            }
+            else if ((c & 0xC0) != 0x80)
+            {
+                // Lead byte of a 3- or 4-byte sequence; skip its continuation bytes.
+                while (i + 1 < text.size() && (static_cast<unsigned char>(text[i + 1]) & 0xC0) == 0x80)
+                    i++;
+                out += '?';
+            }
+        }
+        return out;
+    }
+
+    // Escapes a Latin-1 string for use inside a PDF literal string ( ... ).
+    void appendPdfString(std::string &out, std::string_view latin1)
+    {
+        for (char ch : latin1)
+        {
+            unsigned char c = static_cast<unsigned char>(ch);
+            if (c == '(' || c == ')' || c == '\\')
+            {
+                out += '\\';
+                out += ch;
+            }
+            else if (c < 0x20)
+                out += ' ';
+            else if (c >= 0x80)
+            {
+                char octal[5];
+                std::snprintf(octal, sizeof(octal), "\\%03o", c);
+                out += octal;
+            }
+            else
+                out += ch;
+        }
+    }
+
+    void writeHtmlEscaped(std::ofstream &file, std::string_view text)
+    {
+        for (char ch : text)
+        {
+            switch (ch)
+            {
+            case '<':
+                file << "&lt;";
+                break;
+            case '>':
+                file << "&gt;";
+                break;
+            case '&':
+                file << "&amp;";
+                break;
+            default:
+                file << ch;
+            }
+        }
+    }
+}
+
+/* *************************************************************************
+                        ---------- PDF WRITER ----------
+   *************************************************************************  */
+
+PdfReportWriter::PdfReportWriter() : linesOnPage(0), pageCount(0) {}
+
+void PdfReportWriter::beginObject(int number)
+{
+    if (static_cast<int>(offsets.size()) <= number)
+        offsets.resize(number + 1, 0);
+    offsets[number] = file.tellp();
+    file << number << " 0 obj\n";
+}
+
+bool PdfReportWriter::begin(const std::string &filename, const std::string &reportTitle)
+{
+    file.open(filename, std::ios::binary | std::ios::trunc);
+    if (!file)
+        return false;
+
+    title = toLatin1(reportTitle);
+
+    // The binary comment tells transfer tools the file is not plain text.
+    file << "%PDF-1.4\n%\xE2\xE3\xCF\xD3\n";
+
+    beginObject(catalogObject);
+    file << "<< /Type /Catalog /Pages " << pagesObject << " 0 R >>\nendobj\n";
+
+    beginObject(regularFontObject);
+    file << "<< /Type /Font /Subtype /Type1 /BaseFont /Courier /Encoding /WinAnsiEncoding >>\nendobj\n";
+
+    beginObject(boldFontObject);
+    file << "<< /Type /Font /Subtype /Type1 /BaseFont /Courier-Bold /Encoding /WinAnsiEncoding >>\nendobj\n";
+
+    std::string info = "<< /Title (";
+    appendPdfString(info, title);
+    info += ") /Producer (Library Management System) >>";
+    beginObject(infoObject);
+    file << info << "\nendobj\n";
+
+    startPage();
+    return static_cast<bool>(file);
+}
+
+void PdfReportWriter::startPage()
+{
+    page.clear();
+    page += "BT /F2 12 Tf " + std::to_string(margin) + " " + std::to_string(bodyTop + 20) + " Td (";
+    appendPdfString(page, title);
+    page += ") Tj ET\n";
+    page += "BT /F1 10 Tf " + std::to_string(leading) + " TL " + std::to_string(margin) + " " +
+            std::to_string(bodyTop) + " Td\n";
+    linesOnPage = 0;
+}
+
+void PdfReportWriter::flushPage()
+{
+    page += "ET\n";
+    page += "BT /F1 8 Tf " + std::to_string(margin) + " 30 Td (Page " + std::to_string(pageCount + 1) + ") Tj ET\n";
+
+    int contentObject = firstPageObject + 2 * pageCount;
+    int pageObject = contentObject + 1;
+
+    beginObject(contentObject);
+    file << "<< /Length " << page.size() << " >>\nstream\n"
+         << page << "\nendstream\nendobj\n";
+
+    beginObject(pageObject);
+    file << "<< /Type /Page /Parent " << pagesObject << " 0 R"
+         << " /MediaBox [0 0 " << pageWidth << " " << pageHeight << "]"
+         << " /Resources << /Font << /F1 " << regularFontObject << " 0 R /F2 " << boldFontObject << " 0 R >> >>"
+         << " /Contents " << contentObject << " 0 R >>\nendobj\n";
+
+    pageCount++;
+}
+
+void PdfReportWriter::appendText(std::string_view text)
+{
+    if (linesOnPage == linesPerPage)
+    {
+        flushPage();
+        startPage();
+    }
+
+    page += '(';
+    appendPdfString(page, text);
+    page += ") Tj T*\n";
+    linesOnPage++;
+}
+
+void PdfReportWriter::writeLine(std::string_view line)
+{
+    std::string latin1 = toLatin1(line);
+    std::string_view rest(latin1);
+
+    // Long lines wrap onto the next line rather than running off the page.
+    while (static_cast<int>(rest.size()) > charsPerLine)
+    {
+        appendText(rest.substr(0, charsPerLine));
+        rest.remove_prefix(charsPerLine);
+    }
+    appendText(rest);
+}
+
+bool PdfReportWriter::finish()
+{
+    if (!file.is_open())
+        return false;
+
+    if (linesOnPage > 0 || pageCount == 0)
+        flushPage();
+
+    beginObject(pagesObject);
+    file << "<< /Type /Pages /Count " << pageCount << " /Kids [";
+    for (int i = 0; i < pageCount; i++)
+        file << (i ? " " : "") << firstPageObject + 2 * i + 1 << " 0 R";
+    file << "] >>\nendobj\n";
+
+    std::streamoff xrefOffset = file.tellp();
+    file << "xref\n0 " << offsets.size() << "\n";
+    file << "0000000000 65535 f \n";
+
+    char entry[24];
+    for (size_t i = 1; i < offsets.size(); i++)
+    {
+        std::snprintf(entry, sizeof(entry), "%010lld 00000 n \n", static_cast<long long>(offsets[i]));
+        file << entry;
+    }
+
+    file << "trailer\n<< /Size " << offsets.size() << " /Root " << catalogObject << " 0 R /Info "
+         << infoObject << " 0 R >>\nstartxref\n"
+         << xrefOffset << "\n%%EOF\n";
+
+    file.close();
+    return !file.fail();
+}
+
+/* *************************************************************************
+                        ---------- HTML WRITER ----------
+   *************************************************************************  */
+
+bool HtmlReportWriter::begin(const std::string &filename, const std::string &title)
+{
+    file.open(filename, std::ios::trunc);
+    if (!file)
+        return false;
+
+    file << "<html><head><meta charset='utf-8'><style>"
+         << "body { font-family: 'Courier New', Courier, monospace; margin: 50px; }"
+         << "h2 { color: #2c3e50; border-bottom: 1px solid #ccc; }"
+         << ".content { white-space: pre-wrap; font-size: 14px; line-height: 1.5; }"
+         << "</style></head><body>"
+         << "<h2>";
+    writeHtmlEscaped(file, title);
+    file << "</h2><pre class='content'>";
+    return static_cast<bool>(file);
+}
+
+void HtmlReportWriter::writeLine(std::string_view line)
+{
+    writeHtmlEscaped(file, line);
+    file << '\n';
+}
+
+bool HtmlReportWriter::finish()
+{
+    if (!file.is_open())
+        return false;
+
+    file << "</pre></body></html>\n";
+    file.close();
+    return !file.fail();
+}
+
+/* *************************************************************************
+                        ---------- TEXT WRITER ----------
+   *************************************************************************  */
+
+bool TextReportWriter::begin(const std::string &filename, const std::string &title)
+{
+    file.open(filename, std::ios::trunc);
+    if (!file)
+        return false;
+
+    file << title << "\n\n";
+    return static_cast<bool>(file);
+}
+
+void TextReportWriter::writeLine(std::string_view line)
+{
+    file << line << '\n';
+}
+
+bool TextReportWriter::finish()
+{
+    if (!file.is_open())
+        return false;
+
+    file.close();
+    return !file.fail();
+}
+
+/* *************************************************************************
+                       ---------- WRITER FACTORY ----------
+   *************************************************************************  */
+
+std::unique_ptr<ReportWriter> createReportWriter(const std::string &filename)
+{
+    std::string extension;
+    size_t dot = filename.find_last_of('.');
+    if (dot != std::string::npos)
+    {
+        for (char c : filename.substr(dot + 1))
+            extension += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+
+    if (extension == "html" || extension == "htm")
+        return std::make_unique<HtmlReportWriter>();
+    if (extension == "txt")
+        return std::make_unique<TextReportWriter>();
+    return std::make_unique<PdfReportWriter>();
+}
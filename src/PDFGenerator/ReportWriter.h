@@ -0,0 +1,76 @@
+#ifndef REPORT_WRITER_H
+#define REPORT_WRITER_H
+
+#include <string>
+#include <string_view>
+#include <fstream>
+#include <vector>
+#include <memory>
+
+// Receives a report one text line at a time and writes it straight to disk.
+// Only the current page (PDF) or nothing at all (HTML/TXT) is kept in memory,
+// so report size is bounded by the disk rather than by RAM.
+class ReportWriter
+{
+protected:
+    std::ofstream file;
+
+public:
+    virtual ~ReportWriter() = default;
+
+    // Opens the output file and writes the heading.
+    virtual bool begin(const std::string &filename, const std::string &title) = 0;
+
+    // Appends one line of report text (without the trailing newline).
+    virtual void writeLine(std::string_view line) = 0;
+
+    // Writes any trailer and closes the file. Returns false on I/O errors.
+    virtual bool finish() = 0;
+};
+
+// Plain-text PDF 1.4 using the built-in Courier fonts, so nothing is embedded
+// and no external converter is needed.
+class PdfReportWriter : public ReportWriter
+{
+private:
+    std::string title;
+    std::string page;                // content stream of the page being filled
+    int linesOnPage;
+    int pageCount;
+    std::vector<std::streamoff> offsets; // byte offset of each object, for the xref table
+
+    void beginObject(int number);
+    void startPage();
+    void flushPage();
+    void appendText(std::string_view text);
+
+public:
+    PdfReportWriter();
+
+    bool begin(const std::string &filename, const std::string &title) override;
+    void writeLine(std::string_view line) override;
+    bool finish() override;
+};
+
+// Single <pre> block; text is HTML-escaped as it streams through.
+class HtmlReportWriter : public ReportWriter
+{
+public:
+    bool begin(const std::string &filename, const std::string &title) override;
+    void writeLine(std::string_view line) override;
+    bool finish() override;
+};
+
+// Raw text, useful for diffing reports or piping them into other tools.
+class TextReportWriter : public ReportWriter
+{
+public:
+    bool begin(const std::string &filename, const std::string &title) override;
+    void writeLine(std::string_view line) override;
+    bool finish() override;
+};
+
+// Picks the writer from the file extension: .html/.htm, .txt, otherwise PDF.
+std::unique_ptr<ReportWriter> createReportWriter(const std::string &filename);
+
+#endif
@@ -0,0 +1,292 @@
+#include "AllocationProfiler.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iterator>
+#include <mutex>
+#include <new>
+#include <ostream>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+namespace
+{
+    // Per-thread counters, so a scope only sees its own thread's work. Plain
+    // data with constant initialisation: safe to touch from operator new.
+    thread_local AllocationCounters threadCounters;
+    thread_local AllocationScope *currentScope = nullptr;
+
+    std::atomic<std::uint64_t> totalAllocations{0};
+    std::atomic<std::uint64_t> totalFrees{0};
+    std::atomic<std::uint64_t> totalBytes{0};
+    std::atomic<std::int64_t> totalLive{0};
+    std::atomic<std::int64_t> totalPeak{0};
+
+    std::mutex scopesMutex;
+
+    std::vector<AllocationScopeStats> &scopeTable()
+    {
+        static std::vector<AllocationScopeStats> table;
+        return table;
+    }
+
+    double nowMs()
+    {
+        using namespace std::chrono;
+        return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+    }
+}
+
+#ifdef LIBRARY_ALLOC_PROFILING
+
+/* *************************************************************************
+                  ---------- COUNTING GLOBAL ALLOCATOR ----------
+   *************************************************************************  */
+
+namespace
+{
+    // Every block carries its size in a header so delete can account for it.
+    constexpr std::size_t headerSize = alignof(std::max_align_t);
+
+    void *countedAllocate(std::size_t size) noexcept
+    {
+        void *block = std::malloc(size + headerSize);
+        if (!block)
+            return nullptr;
+        *static_cast<std::size_t *>(block) = size;
+
+        std::int64_t signedSize = static_cast<std::int64_t>(size);
+        threadCounters.allocations++;
+        threadCounters.bytes += size;
+        threadCounters.liveBytes += signedSize;
+        if (threadCounters.liveBytes > threadCounters.peakLiveBytes)
+            threadCounters.peakLiveBytes = threadCounters.liveBytes;
+
+        totalAllocations.fetch_add(1, std::memory_order_relaxed);
+        totalBytes.fetch_add(size, std::memory_order_relaxed);
+        std::int64_t live = totalLive.fetch_add(signedSize, std::memory_order_relaxed) + signedSize;
+        std::int64_t peak = totalPeak.load(std::memory_order_relaxed);
+        while (live > peak && !totalPeak.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+        {
+        }
+
+        return static_cast<char *>(block) + headerSize;
+    }
+
+    void countedFree(void *pointer) noexcept
+    {
+        if (!pointer)
+            return;
+        void *block = static_cast<char *>(pointer) - headerSize;
+        std::int64_t size = static_cast<std::int64_t>(*static_cast<std::size_t *>(block));
+
+        threadCounters.frees++;
+        threadCounters.liveBytes -= size;
+        totalFrees.fetch_add(1, std::memory_order_relaxed);
+        totalLive.fetch_sub(size, std::memory_order_relaxed);
+
+        std::free(block);
+    }
+}
+
+void *operator new(std::size_t size)
+{
+    void *pointer = countedAllocate(size);
+    if (!pointer)
+        throw std::bad_alloc();
+    return pointer;
+}
+
+void *operator new[](std::size_t size)
+{
+    void *pointer = countedAllocate(size);
+    if (!pointer)
+        throw std::bad_alloc();
+    return pointer;
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept { return countedAllocate(size); }
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept { return countedAllocate(size); }
+
+void operator delete(void *pointer) noexcept { countedFree(pointer); }
+void operator delete[](void *pointer) noexcept { countedFree(pointer); }
+void operator delete(void *pointer, std::size_t) noexcept { countedFree(pointer); }
+void operator delete[](void *pointer, std::size_t) noexcept { countedFree(pointer); }
+void operator delete(void *pointer, const std::nothrow_t &) noexcept { countedFree(pointer); }
+void operator delete[](void *pointer, const std::nothrow_t &) noexcept { countedFree(pointer); }
+
+#endif
+
+/* *************************************************************************
+                      ---------- ALLOCATION SCOPES ----------
+   *************************************************************************  */
+
+AllocationScope::AllocationScope(const char *scopeName)
+    : name(scopeName), start(threadCounters), outerPeak(threadCounters.peakLiveBytes), startMs(nowMs()),
+      owner(std::this_thread::get_id()), enclosing(currentScope)
+{
+    // Restart the peak so it measures growth inside this scope only.
+    threadCounters.peakLiveBytes = threadCounters.liveBytes;
+    currentScope = this;
+}
+
+AllocationScope::~AllocationScope()
+{
+    AllocationCounters end = threadCounters;
+    double elapsed = nowMs() - startMs;
+    threadCounters.peakLiveBytes = std::max(outerPeak, end.peakLiveBytes);
+    currentScope = enclosing;
+
+    // Helper threads have all been joined by the time the scope closes.
+    std::uint64_t helperAllocations = workerAllocations.load(std::memory_order_relaxed);
+    std::uint64_t helperBytes = workerBytes.load(std::memory_order_relaxed);
+    std::int64_t helperPeak = workerPeak.load(std::memory_order_relaxed);
+
+    long rss = AllocationProfiler::peakRssKb();
+
+    std::lock_guard<std::mutex> lock(scopesMutex);
+    std::vector<AllocationScopeStats> &table = scopeTable();
+    auto found = std::find_if(table.begin(), table.end(), [this](const AllocationScopeStats &entry)
+                              { return entry.name == name; });
+    if (found == table.end())
+    {
+        table.push_back(AllocationScopeStats());
+        found = std::prev(table.end());
+        found->name = name;
+    }
+
+    found->calls++;
+    found->allocations += end.allocations - start.allocations + helperAllocations;
+    found->bytes += end.bytes - start.bytes + helperBytes;
+    found->peakLiveBytes = std::max({found->peakLiveBytes, end.peakLiveBytes - start.liveBytes, helperPeak});
+    found->peakRssKb = std::max(found->peakRssKb, rss);
+    found->totalMs += elapsed;
+}
+
+AllocationScope *AllocationScope::current()
+{
+    return currentScope;
+}
+
+AllocationWorkerScope::AllocationWorkerScope(AllocationScope *parentScope)
+    : parent(parentScope && parentScope->owner != std::this_thread::get_id() ? parentScope : nullptr)
+{
+    if (!parent)
+        return;
+    start = threadCounters;
+    outerPeak = threadCounters.peakLiveBytes;
+    threadCounters.peakLiveBytes = threadCounters.liveBytes;
+}
+
+AllocationWorkerScope::~AllocationWorkerScope()
+{
+    if (!parent)
+        return;
+    AllocationCounters end = threadCounters;
+    threadCounters.peakLiveBytes = std::max(outerPeak, end.peakLiveBytes);
+
+    parent->workerAllocations.fetch_add(end.allocations - start.allocations, std::memory_order_relaxed);
+    parent->workerBytes.fetch_add(end.bytes - start.bytes, std::memory_order_relaxed);
+    std::int64_t growth = end.peakLiveBytes - start.liveBytes;
+    std::int64_t peak = parent->workerPeak.load(std::memory_order_relaxed);
+    while (growth > peak && !parent->workerPeak.compare_exchange_weak(peak, growth, std::memory_order_relaxed))
+    {
+    }
+}
+
+/* *************************************************************************
+                         ---------- REPORTING ----------
+   *************************************************************************  */
+
+namespace AllocationProfiler
+{
+    bool enabled()
+    {
+#ifdef LIBRARY_ALLOC_PROFILING
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    AllocationCounters totals()
+    {
+        AllocationCounters counters;
+        counters.allocations = totalAllocations.load(std::memory_order_relaxed);
+        counters.frees = totalFrees.load(std::memory_order_relaxed);
+        counters.bytes = totalBytes.load(std::memory_order_relaxed);
+        counters.liveBytes = totalLive.load(std::memory_order_relaxed);
+        counters.peakLiveBytes = totalPeak.load(std::memory_order_relaxed);
+        return counters;
+    }
+
+    long peakRssKb()
+    {
+#ifndef _WIN32
+        rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) == 0)
+            return usage.ru_maxrss; // KB on Linux
+#endif
+        return 0;
+    }
+
+    std::vector<AllocationScopeStats> scopes()
+    {
+        std::lock_guard<std::mutex> lock(scopesMutex);
+        return scopeTable();
+    }
+
+    void report(std::ostream &out)
+    {
+        if (!enabled())
+        {
+            out << "Allocation profiling is off in this build (configure with -DLIBRARY_ALLOC_PROFILING=ON).\n";
+            return;
+        }
+
+        AllocationCounters total = totals();
+        out << "Heap: " << total.allocations << " allocations, " << total.frees << " frees, "
+            << total.bytes << " bytes requested, " << total.liveBytes << " bytes live, peak "
+            << total.peakLiveBytes << " bytes. Peak RSS: " << peakRssKb() << " KB.\n";
+
+        std::vector<AllocationScopeStats> entries = scopes();
+        if (entries.empty())
+        {
+            out << "No profiled service calls yet.\n";
+            return;
+        }
+
+        std::sort(entries.begin(), entries.end(), [](const AllocationScopeStats &a, const AllocationScopeStats &b)
+                  { return a.bytes > b.bytes; });
+
+        out << std::left << std::setw(48) << "Scope" << std::right << std::setw(7) << "Calls"
+            << std::setw(12) << "Allocs/call" << std::setw(14) << "Bytes/call" << std::setw(14) << "Peak bytes"
+            << std::setw(12) << "RSS KB" << std::setw(10) << "ms/call" << "\n";
+
+        for (const AllocationScopeStats &entry : entries)
+        {
+            out << std::left << std::setw(48) << entry.name << std::right << std::setw(7) << entry.calls
+                << std::setw(12) << entry.allocations / entry.calls
+                << std::setw(14) << entry.bytes / entry.calls
+                << std::setw(14) << entry.peakLiveBytes
+                << std::setw(12) << entry.peakRssKb
+                << std::setw(10) << std::fixed << std::setprecision(2) << entry.totalMs / entry.calls << "\n";
+        }
+        out << std::defaultfloat;
+    }
+
+    void reset()
+    {
+        totalAllocations.store(0, std::memory_order_relaxed);
+        totalFrees.store(0, std::memory_order_relaxed);
+        totalBytes.store(0, std::memory_order_relaxed);
+        totalPeak.store(totalLive.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+        std::lock_guard<std::mutex> lock(scopesMutex);
+        scopeTable().clear();
+    }
+}
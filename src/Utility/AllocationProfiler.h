@@ -0,0 +1,110 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <iosfwd>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Heap accounting for profiling builds (configure with
+// -DLIBRARY_ALLOC_PROFILING=ON). That build replaces the global operator
+// new/delete with counting versions, and PROFILE_ALLOCATIONS("name") records
+// what the enclosing scope allocated under that name. In a normal build the
+// macro expands to nothing and the functions below report no data.
+//
+// Counting is per thread. A call that fans work out to helper threads opens
+// PROFILE_WORKER_ALLOCATIONS(parent) in each helper task to charge that work
+// to its own scope; for such calls the peak is the largest single thread's.
+
+struct AllocationCounters
+{
+    std::uint64_t allocations = 0;
+    std::uint64_t frees = 0;
+    std::uint64_t bytes = 0;     // total requested, not net
+    std::int64_t liveBytes = 0;  // allocated minus freed
+    std::int64_t peakLiveBytes = 0;
+};
+
+struct AllocationScopeStats
+{
+    std::string name;
+    std::uint64_t calls = 0;
+    std::uint64_t allocations = 0;
+    std::uint64_t bytes = 0;
+    std::int64_t peakLiveBytes = 0; // highest heap growth seen within one call
+    long peakRssKb = 0;             // process high-water mark when a call finished
+    double totalMs = 0.0;
+};
+
+namespace AllocationProfiler
+{
+    bool enabled();
+
+    // Process-wide totals since start-up (or the last reset).
+    AllocationCounters totals();
+    // Peak resident set size of the process in KB, 0 where unsupported.
+    long peakRssKb();
+
+    std::vector<AllocationScopeStats> scopes();
+    void report(std::ostream &out);
+    void reset();
+}
+
+// Records allocations made on the current thread between construction and
+// destruction. Scopes may nest; each one reports what it saw in full.
+class AllocationScope
+{
+private:
+    const char *name;
+    AllocationCounters start;
+    std::int64_t outerPeak;
+    double startMs;
+    std::thread::id owner;
+    AllocationScope *enclosing; // scope this one is nested in on the same thread
+
+    // Folded in by AllocationWorkerScope from other threads.
+    std::atomic<std::uint64_t> workerAllocations{0};
+    std::atomic<std::uint64_t> workerBytes{0};
+    std::atomic<std::int64_t> workerPeak{0};
+
+    friend class AllocationWorkerScope;
+
+public:
+    explicit AllocationScope(const char *scopeName);
+    ~AllocationScope();
+
+    AllocationScope(const AllocationScope &) = delete;
+    AllocationScope &operator=(const AllocationScope &) = delete;
+
+    // Innermost scope open on the calling thread, or nullptr.
+    static AllocationScope *current();
+};
+
+// Charges allocations made on a helper thread to a scope opened on another
+// thread. Does nothing for a null parent, or on the parent's own thread,
+// which the parent already counts.
+class AllocationWorkerScope
+{
+private:
+    AllocationScope *parent;
+    AllocationCounters start;
+    std::int64_t outerPeak = 0;
+
+public:
+    explicit AllocationWorkerScope(AllocationScope *parentScope);
+    ~AllocationWorkerScope();
+
+    AllocationWorkerScope(const AllocationWorkerScope &) = delete;
+    AllocationWorkerScope &operator=(const AllocationWorkerScope &) = delete;
+};
+
+#ifdef LIBRARY_ALLOC_PROFILING
+#define PROFILE_ALLOCATIONS_CONCAT2(a, b) a##b
+#define PROFILE_ALLOCATIONS_CONCAT(a, b) PROFILE_ALLOCATIONS_CONCAT2(a, b)
+#define PROFILE_ALLOCATIONS(name) AllocationScope PROFILE_ALLOCATIONS_CONCAT(allocationScope_, __LINE__)(name)
+#define PROFILE_WORKER_ALLOCATIONS(parent) AllocationWorkerScope PROFILE_ALLOCATIONS_CONCAT(allocationWorkerScope_, __LINE__)(parent)
+#else
+#define PROFILE_ALLOCATIONS(name) ((void)0)
+#define PROFILE_WORKER_ALLOCATIONS(parent) ((void)(parent))
+#endif
@@ -0,0 +1,64 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+
+// Blocking FIFO with a fixed capacity, used to hand work between pipeline
+// threads. push() waits while the queue is full, which is what keeps a fast
+// producer from running ahead of a slow consumer and growing memory.
+// close() wakes everyone: pending items are still popped, then pop() returns
+// nullopt and push() returns false.
+template <typename T>
+class BoundedQueue
+{
+private:
+    std::deque<T> items;
+    std::size_t capacity;
+    bool closed;
+    std::mutex lock;
+    std::condition_variable notFull;
+    std::condition_variable notEmpty;
+
+public:
+    explicit BoundedQueue(std::size_t maxItems) : capacity(maxItems > 0 ? maxItems : 1), closed(false) {}
+
+    BoundedQueue(const BoundedQueue &) = delete;
+    BoundedQueue &operator=(const BoundedQueue &) = delete;
+
+    bool push(T item)
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        notFull.wait(guard, [this]
+                     { return closed || items.size() < capacity; });
+        if (closed)
+            return false;
+
+        items.push_back(std::move(item));
+        notEmpty.notify_one();
+        return true;
+    }
+
+    std::optional<T> pop()
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        notEmpty.wait(guard, [this]
+                      { return closed || !items.empty(); });
+        if (items.empty())
+            return std::nullopt;
+
+        T item = std::move(items.front());
+        items.pop_front();
+        notFull.notify_one();
+        return item;
+    }
+
+    void close()
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        closed = true;
+        notFull.notify_all();
+        notEmpty.notify_all();
+    }
+};
@@ -0,0 +1,168 @@
+#pragma once
+#include <string>
+#include <string_view>
+
+// A calendar date stored as the number of days since 1970-01-01 (proleptic
+// Gregorian calendar). Comparing, subtracting and adding days are plain integer
+// operations; converting to and from year/month/day uses Howard Hinnant's
+// days_from_civil / civil_from_days algorithms, which are exact for every year
+// and need no lookup tables, time zones or std::tm.
+class CivilDate
+{
+public:
+    struct Civil
+    {
+        int year;
+        int month; // 1-12
+        int day;   // 1-31
+    };
+
+private:
+    int days;
+
+public:
+    constexpr CivilDate() : days(0) {}
+    constexpr explicit CivilDate(int daysSinceEpoch) : days(daysSinceEpoch) {}
+
+    /* *************************************************************************
+                        ---------- CALENDAR RULES ----------
+       *************************************************************************  */
+
+    static constexpr bool isLeapYear(int year)
+    {
+        return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    }
+
+    static constexpr int daysInMonth(int year, int month)
+    {
+        constexpr int lengths[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+        return (month == 2 && isLeapYear(year)) ? 29 : lengths[month - 1];
+    }
+
+    static constexpr bool isValid(int year, int month, int day)
+    {
+        return month >= 1 && month <= 12 && day >= 1 && day <= daysInMonth(year, month);
+    }
+
+    /* *************************************************************************
+                     ---------- CIVIL <-> DAY NUMBER ----------
+       *************************************************************************  */
+
+    static constexpr int daysFromCivil(int year, int month, int day)
+    {
+        // Shift the year to start in March so the leap day is the last day.
+        year -= month <= 2;
+        const int era = (year >= 0 ? year : year - 399) / 400;
+        const int yearOfEra = year - era * 400;
+        const int dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+        const int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+        return era * 146097 + dayOfEra - 719468;
+    }
+
+    static constexpr Civil civilFromDays(int daysSinceEpoch)
+    {
+        const int shifted = daysSinceEpoch + 719468;
+        const int era = (shifted >= 0 ? shifted : shifted - 146096) / 146097;
+        const int dayOfEra = shifted - era * 146097;
+        const int yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+        const int dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+        const int monthIndex = (5 * dayOfYear + 2) / 153;
+        const int day = dayOfYear - (153 * monthIndex + 2) / 5 + 1;
+        const int month = monthIndex + (monthIndex < 10 ? 3 : -9);
+        return Civil{yearOfEra + era * 400 + (month <= 2), month, day};
+    }
+
+    static constexpr CivilDate fromCivil(int year, int month, int day)
+    {
+        return CivilDate(daysFromCivil(year, month, day));
+    }
+
+    constexpr Civil toCivil() const { return civilFromDays(days); }
+    constexpr int getDaysSinceEpoch() const { return days; }
+
+    /* *************************************************************************
+                        ---------- PARSE & FORMAT ----------
+       *************************************************************************  */
+
+    // Accepts "YYYY-MM-DD" as well as the unpadded "YYYY-M-D" the application
+    // has always stored. Rejects trailing text and impossible dates (2023-02-29).
+    // Reads the characters in place; nothing is allocated.
+    static constexpr bool parse(std::string_view text, CivilDate &out)
+    {
+        int fields[3] = {0, 0, 0};
+        const int maxDigits[3] = {4, 2, 2};
+        std::size_t pos = 0;
+
+        for (int field = 0; field < 3; field++)
+        {
+            if (field > 0)
+            {
+                if (pos >= text.size() || text[pos] != '-')
+                    return false;
+                pos++;
+            }
+
+            int digits = 0;
+            while (pos < text.size() && text[pos] >= '0' && text[pos] <= '9' && digits < maxDigits[field])
+            {
+                fields[field] = fields[field] * 10 + (text[pos] - '0');
+                pos++;
+                digits++;
+            }
+            if (digits == 0 || (field == 0 && digits != 4))
+                return false;
+        }
+
+        if (pos != text.size() || !isValid(fields[0], fields[1], fields[2]))
+            return false;
+
+        out = fromCivil(fields[0], fields[1], fields[2]);
+        return true;
+    }
+
+    // Writes exactly 10 characters, "YYYY-MM-DD", with no terminator.
+    // Years outside 0-9999 are not representable in this format.
+    constexpr void formatIso(char *out) const
+    {
+        const Civil civil = toCivil();
+        out[0] = static_cast<char>('0' + civil.year / 1000 % 10);
+        out[1] = static_cast<char>('0' + civil.year / 100 % 10);
+        out[2] = static_cast<char>('0' + civil.year / 10 % 10);
+        out[3] = static_cast<char>('0' + civil.year % 10);
+        out[4] = '-';
+        out[5] = static_cast<char>('0' + civil.month / 10);
+        out[6] = static_cast<char>('0' + civil.month % 10);
+        out[7] = '-';
+        out[8] = static_cast<char>('0' + civil.day / 10);
+        out[9] = static_cast<char>('0' + civil.day % 10);
+    }
+
+    std::string toString() const
+    {
+        char buffer[10] = {};
+        formatIso(buffer);
+        return std::string(buffer, sizeof(buffer));
+    }
+
+    /* *************************************************************************
+                          ---------- ARITHMETIC ----------
+       *************************************************************************  */
+
+    constexpr CivilDate addDays(int count) const { return CivilDate(days + count); }
+
+    constexpr CivilDate operator+(int count) const { return addDays(count); }
+    constexpr int operator-(CivilDate other) const { return days - other.days; }
+
+    constexpr bool operator==(CivilDate other) const { return days == other.days; }
+    constexpr bool operator!=(CivilDate other) const { return days != other.days; }
+    constexpr bool operator<(CivilDate other) const { return days < other.days; }
+    constexpr bool operator<=(CivilDate other) const { return days <= other.days; }
+    constexpr bool operator>(CivilDate other) const { return days > other.days; }
+    constexpr bool operator>=(CivilDate other) const { return days >= other.days; }
+};
+
+// The conversions are constexpr, so the calendar rules are checked at compile time.
+static_assert(CivilDate::daysFromCivil(1970, 1, 1) == 0, "epoch");
+static_assert(CivilDate::daysFromCivil(2000, 3, 1) - CivilDate::daysFromCivil(2000, 2, 28) == 2, "2000 is a leap year");
+static_assert(CivilDate::daysFromCivil(2100, 3, 1) - CivilDate::daysFromCivil(2100, 2, 28) == 1, "2100 is not a leap year");
+static_assert(CivilDate::civilFromDays(CivilDate::daysFromCivil(2024, 2, 29)).day == 29, "round trip");
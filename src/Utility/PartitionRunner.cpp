@@ -0,0 +1,88 @@
+#include "PartitionRunner.h"
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    struct WorkerQueue
+    {
+        std::mutex lock;
+        std::deque<std::size_t> partitions;
+
+        bool popFront(std::size_t &partition)
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (partitions.empty())
+                return false;
+            partition = partitions.front();
+            partitions.pop_front();
+            return true;
+        }
+
+        bool stealBack(std::size_t &partition)
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (partitions.empty())
+                return false;
+            partition = partitions.back();
+            partitions.pop_back();
+            return true;
+        }
+    };
+}
+
+PartitionRunStats runPartitions(std::size_t partitions, std::size_t workers,
+                                const std::function<void(std::size_t partition, std::size_t worker)> &task)
+{
+    PartitionRunStats stats;
+    stats.partitions = partitions;
+    if (partitions == 0)
+        return stats;
+
+    stats.workers = workers == 0 ? 1 : (workers > partitions ? partitions : workers);
+
+    // No work is added once the run starts, so a worker whose own queue and
+    // every victim's are empty can simply stop.
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    for (std::size_t worker = 0; worker < stats.workers; worker++)
+    {
+        auto queue = std::make_unique<WorkerQueue>();
+        std::size_t first = partitions * worker / stats.workers;
+        std::size_t last = partitions * (worker + 1) / stats.workers;
+        for (std::size_t partition = first; partition < last; partition++)
+            queue->partitions.push_back(partition);
+        queues.push_back(std::move(queue));
+    }
+
+    std::atomic<std::size_t> steals{0};
+    auto work = [&](std::size_t worker)
+    {
+        std::size_t partition;
+        while (queues[worker]->popFront(partition))
+            task(partition, worker);
+
+        for (std::size_t offset = 1; offset < stats.workers; offset++)
+        {
+            WorkerQueue &victim = *queues[(worker + offset) % stats.workers];
+            while (victim.stealBack(partition))
+            {
+                steals.fetch_add(1, std::memory_order_relaxed);
+                task(partition, worker);
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (std::size_t worker = 1; worker < stats.workers; worker++)
+        threads.emplace_back(work, worker);
+    work(0);
+    for (std::thread &thread : threads)
+        thread.join();
+
+    stats.steals = steals.load();
+    return stats;
+}
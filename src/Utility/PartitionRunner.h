@@ -0,0 +1,22 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+
+struct PartitionRunStats
+{
+    std::size_t workers = 0;
+    std::size_t partitions = 0;
+    std::size_t steals = 0; // partitions run by a worker other than their owner
+};
+
+// Runs task(partition, worker) once for every partition in [0, partitions)
+// on up to `workers` threads (the caller is worker 0) and returns when all
+// have finished. worker is below the returned stats.workers, so callers can
+// set up per-worker state, such as a connection, before the run.
+//
+// Work stealing: each worker starts with a contiguous run of partitions and
+// takes them from the front; one that runs dry steals from the back of
+// another worker's run. Uneven partitions therefore still keep every worker
+// busy until the end.
+PartitionRunStats runPartitions(std::size_t partitions, std::size_t workers,
+                                const std::function<void(std::size_t partition, std::size_t worker)> &task);
@@ -0,0 +1,97 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Append-only store of interned strings. Each distinct string is copied once
+// into large blocks and referred to by a 32-bit id afterwards, so thousands
+// of rows sharing an author or publisher cost one copy, and views handed out
+// stay valid until clear() because blocks never move.
+class StringArena
+{
+private:
+    static constexpr std::size_t blockSize = 64 * 1024;
+
+    std::vector<std::unique_ptr<char[]>> blocks;
+    char *current = nullptr; // block being filled
+    std::size_t currentUsed = 0;
+    std::size_t totalBytes = 0;
+
+    std::vector<std::string_view> strings;
+    std::unordered_map<std::string_view, std::uint32_t> ids;
+
+    std::string_view store(std::string_view text)
+    {
+        if (text.empty())
+            return std::string_view();
+
+        char *target;
+        if (text.size() > blockSize / 4)
+        {
+            // Oversized strings get a block of their own; the current one stays open.
+            blocks.push_back(std::unique_ptr<char[]>(new char[text.size()]));
+            target = blocks.back().get();
+        }
+        else
+        {
+            if (!current || blockSize - currentUsed < text.size())
+            {
+                blocks.push_back(std::unique_ptr<char[]>(new char[blockSize]));
+                current = blocks.back().get();
+                currentUsed = 0;
+            }
+            target = current + currentUsed;
+            currentUsed += text.size();
+        }
+
+        std::memcpy(target, text.data(), text.size());
+        totalBytes += text.size();
+        return std::string_view(target, text.size());
+    }
+
+public:
+    StringArena() { intern(std::string_view()); } // id 0 is always the empty string
+
+    StringArena(const StringArena &) = delete;
+    StringArena &operator=(const StringArena &) = delete;
+    StringArena(StringArena &&) = default;
+    StringArena &operator=(StringArena &&) = default;
+
+    // Returns the id of text, copying it in the first time it is seen.
+    std::uint32_t intern(std::string_view text)
+    {
+        auto found = ids.find(text);
+        if (found != ids.end())
+            return found->second;
+
+        std::string_view stored = store(text);
+        std::uint32_t id = static_cast<std::uint32_t>(strings.size());
+        strings.push_back(stored);
+        ids.emplace(stored, id);
+        return id;
+    }
+
+    // Copies text in without interning it. For columns that are mostly
+    // unique, where the hash lookup would cost more than it saves.
+    std::string_view copy(std::string_view text) { return store(text); }
+
+    std::string_view view(std::uint32_t id) const { return strings[id]; }
+
+    std::size_t size() const { return strings.size(); }
+    std::size_t bytes() const { return totalBytes; }
+
+    void clear()
+    {
+        blocks.clear();
+        current = nullptr;
+        currentUsed = 0;
+        totalBytes = 0;
+        strings.clear();
+        ids.clear();
+        intern(std::string_view());
+    }
+};
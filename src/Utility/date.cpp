@@ -1,4 +1,5 @@
 #include"date.h"
+#include "CivilDate.h"
 #include <iostream>
 std::string getCurrentDate()
 {
@@ -12,55 +13,27 @@ std::string getCurrentDate()
     int day;
     std::cin >> day;
 
-    return std::to_string(year) + "-" + std::to_string(month) + "-" + std::to_string(day);
+    return CivilDate::fromCivil(year, month, day).toString();
 }
 
 std::string getDueDate(int daysToAdd, std::string currentDate)
 {
-    // parse currentDate
-    int year, month, day;
-    sscanf(currentDate.c_str(), "%d-%d-%d", &year, &month, &day);
+    CivilDate start;
+    if (!CivilDate::parse(currentDate, start))
+        return currentDate; // Unparseable input is passed through unchanged
 
-    // Simple logic to add days 
-    day += daysToAdd;
-
-    // Handle simple overflow of days 
-    if (day > 30)
-    {
-        day -= 30;
-        month += 1;
-        if (month > 12)
-        {
-            month = 1;
-            year += 1;
-        }
-    }
-
-    return std::to_string(year) + "-" + std::to_string(month) + "-" + std::to_string(day);
+    // Real month lengths and leap years, unlike the old 30-day approximation
+    return start.addDays(daysToAdd).toString();
 }
 
-#include <ctime>
-#include <iomanip>
-#include <sstream>
-
 // Helper to calculate difference in days
 int calculateDaysOverdue(const std::string &dueDateStr, const std::string &todayStr)
 {
-    std::tm dueTm = {};
-    std::tm todayTm = {};
-
-    std::istringstream ssDue(dueDateStr);
-    std::istringstream ssToday(todayStr);
+    CivilDate due;
+    CivilDate today;
 
-    ssDue >> std::get_time(&dueTm, "%Y-%m-%d");
-    ssToday >> std::get_time(&todayTm, "%Y-%m-%d");
-
-    std::time_t dueTime = std::mktime(&dueTm);
-    std::time_t todayTime = std::mktime(&todayTm);
-
-    if (dueTime == -1 || todayTime == -1)
+    if (!CivilDate::parse(dueDateStr, due) || !CivilDate::parse(todayStr, today))
         return 0; // Error parsing
 
-    double difference = std::difftime(todayTime, dueTime);
-    return difference / (60 * 60 * 24); // Convert seconds to days
-}
\ No newline at end of file
+    return today - due;
+}
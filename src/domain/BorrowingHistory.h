@@ -29,9 +29,9 @@ public:
     int getId() const { return historyId; }
     int getUserId() const { return userId; }
     int getResourceId() const { return resourceId; }
-    string getIssueDate() const { return issueDate; }
-    string getDueDate() const { return dueDate; }
-    string getReturnDate() const { return returnDate; }
+    const string &getIssueDate() const { return issueDate; }
+    const string &getDueDate() const { return dueDate; }
+    const string &getReturnDate() const { return returnDate; }
     double getFineAmount() const { return fineAmount; }
 
     // Setter
@@ -0,0 +1,13 @@
+#pragma once
+
+// A user's standing at the circulation desk, kept up to date by triggers on
+// transactions and fines (table user_circulation). All zero for a user who
+// has nothing open.
+struct CirculationSummary
+{
+    int userId = 0;
+    int activeBorrows = 0;   // ISSUED and not yet returned
+    int pendingRequests = 0; // PENDING borrow requests
+    int unpaidFineCount = 0;
+    double unpaidFineTotal = 0.0;
+};
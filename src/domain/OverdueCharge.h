@@ -0,0 +1,12 @@
+#pragma once
+
+// One overdue issue as computed by the daily fine engine.
+// Carries only the keys and figures needed to upsert the fine row and
+// stamp the transaction, so a whole batch stays cheap to build.
+struct OverdueCharge
+{
+    int transactionId;
+    int userId;
+    int daysOverdue;
+    double fineAmount;
+};
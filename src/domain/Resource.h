@@ -30,16 +30,16 @@ public:
 
     // Getters
     int getResourceId() const { return resourceId; }
-    std::string getTitle() const { return title; }
-    std::string getAuthor() const { return author; }
-    std::string getPublisher() const { return publisher; }
+    const std::string &getTitle() const { return title; }
+    const std::string &getAuthor() const { return author; }
+    const std::string &getPublisher() const { return publisher; }
     int getPublicationYear() const { return publicationYear; }
-    std::string getIsbn() const { return isbn; }
+    const std::string &getIsbn() const { return isbn; }
     int getCategoryId() const { return categoryId; }
     int getTotalCopies() const { return totalCopies; }
     int getAvailableCopies() const { return availableCopies; }
-    std::string getDescription() const { return description; }
-    std::string getAddedDate() const { return addedDate; }
+    const std::string &getDescription() const { return description; }
+    const std::string &getAddedDate() const { return addedDate; }
     bool getIsActive() const { return isActive; }
 
     // Setters
@@ -29,14 +29,14 @@ public:
     int getTransactionId() const { return transactionId; }
     int getUserId() const { return userId; }
     int getResourceId() const { return resourceId; }
-    std::string getIssueDate() const { return issueDate; }
-    std::string getDueDate() const { return dueDate; }
-    std::string getReturnDate() const { return returnDate; }
+    const std::string &getIssueDate() const { return issueDate; }
+    const std::string &getDueDate() const { return dueDate; }
+    const std::string &getReturnDate() const { return returnDate; }
     double getFineAmount() const { return fineAmount; }
     bool getIsReturned() const { return isReturned; }
     bool getIsOverdue() const { return isOverdue; }
     int getRenewalCount() const { return renewalCount; }
-    std::string getTransactionStatus() const { return transactionStatus; }
+    const std::string &getTransactionStatus() const { return transactionStatus; }
 
     // Setters
     void setTransactionId(int id) { transactionId = id; }
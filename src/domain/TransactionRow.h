@@ -0,0 +1,20 @@
+#pragma once
+#include <string_view>
+
+// Read-only Transaction for bulk paths; text views the caller's StringArena.
+// Dates are copied in row by row; the status is interned, so each distinct
+// status is stored once.
+struct TransactionRow
+{
+    int transactionId;
+    int userId;
+    int resourceId;
+    std::string_view issueDate;
+    std::string_view dueDate;
+    std::string_view returnDate;
+    double fineAmount;
+    bool isReturned;
+    bool isOverdue;
+    int renewalCount;
+    std::string_view transactionStatus;
+};
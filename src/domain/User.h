@@ -33,16 +33,16 @@ public:
 
     // Getters
     int getUserId() const { return userId; }
-    std::string getUsername() const { return username; }
-    std::string getPassword() const { return password; }
-    std::string getFirstName() const { return firstName; }
-    std::string getLastName() const { return lastName; }
-    std::string getEmail() const { return email; }
-    std::string getAddress() const { return address; }
-    std::string getPhone() const { return phone; }
+    const std::string &getUsername() const { return username; }
+    const std::string &getPassword() const { return password; }
+    const std::string &getFirstName() const { return firstName; }
+    const std::string &getLastName() const { return lastName; }
+    const std::string &getEmail() const { return email; }
+    const std::string &getAddress() const { return address; }
+    const std::string &getPhone() const { return phone; }
     double getBalance() const { return balance; }
     int getMembershipTypeId() const { return membershipTypeId; }
-    std::string getRegistrationDate() const { return registrationDate; }
+    const std::string &getRegistrationDate() const { return registrationDate; }
     bool getIsActive() const { return isActive; }
     bool getDeletionRequested() const { return deletionRequested; }
 
@@ -0,0 +1,22 @@
+#pragma once
+#include <string_view>
+
+// One row of the users x borrowing_history x resources join used by the
+// customer history report. Text fields view SQLite's row buffer, so a row is
+// only valid inside the callback that receives it.
+struct UserHistoryRow
+{
+    int userId;
+    std::string_view firstName;
+    std::string_view lastName;
+    std::string_view email;
+
+    bool hasHistory; // false when the user has never borrowed anything
+    int resourceId;
+    bool hasResource; // false when the resource row has since been deleted
+    std::string_view resourceTitle;
+    std::string_view issueDate;
+    std::string_view dueDate;
+    std::string_view returnDate;
+    double fineAmount;
+};
@@ -0,0 +1,413 @@
+#include "TableExporter.h"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <utility>
+
+namespace
+{
+    /* *************************************************************************
+                        ---------- OUTPUT BUFFER ----------
+       *************************************************************************  */
+
+    // Fixed-size staging buffer in front of a FILE*. stdio's own buffering is
+    // switched off so every byte is copied exactly once before the write().
+    class BufferedFileWriter
+    {
+    private:
+        std::FILE *file;
+        std::vector<char> buffer;
+        std::size_t used;
+        long long written;
+        bool failed;
+
+    public:
+        BufferedFileWriter(std::FILE *output, std::size_t capacity)
+            : file(output), buffer(std::max<std::size_t>(capacity, 4096)), used(0), written(0), failed(false)
+        {
+            std::setvbuf(file, nullptr, _IONBF, 0);
+        }
+
+        void flush()
+        {
+            if (used > 0 && !failed && std::fwrite(buffer.data(), 1, used, file) != used)
+                failed = true;
+            written += static_cast<long long>(used);
+            used = 0;
+        }
+
+        void put(char c)
+        {
+            if (used == buffer.size())
+                flush();
+            buffer[used++] = c;
+        }
+
+        void append(const char *data, std::size_t length)
+        {
+            if (length > buffer.size() - used)
+            {
+                flush();
+                if (length > buffer.size())
+                {
+                    if (!failed && std::fwrite(data, 1, length, file) != length)
+                        failed = true;
+                    written += static_cast<long long>(length);
+                    return;
+                }
+            }
+            std::memcpy(buffer.data() + used, data, length);
+            used += length;
+        }
+
+        void append(const std::string &text) { append(text.data(), text.size()); }
+
+        bool hasFailed() const { return failed; }
+        long long bytesWritten() const { return written + static_cast<long long>(used); }
+    };
+
+    /* *************************************************************************
+                          ---------- ENCODING ----------
+       *************************************************************************  */
+
+    void writeInteger(BufferedFileWriter &out, sqlite3_int64 value)
+    {
+        char digits[24];
+        auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        out.append(digits, static_cast<std::size_t>(result.ptr - digits));
+    }
+
+    // Shortest text that reads back as the same double; whole numbers keep a
+    // ".0" so REAL columns (fine amounts, balances) still look like reals.
+    void writeReal(BufferedFileWriter &out, double value)
+    {
+        char digits[32];
+        auto result = std::to_chars(digits, digits + sizeof(digits) - 2, value);
+        char *end = result.ptr;
+        if (std::find_if(digits, end, [](char c)
+                         { return c == '.' || c == 'e' || c == 'n' || c == 'i'; }) == end)
+        {
+            *end++ = '.';
+            *end++ = '0';
+        }
+        out.append(digits, static_cast<std::size_t>(end - digits));
+    }
+
+    // Quotes only when the value needs it (comma, quote or line break).
+    void writeCsvText(BufferedFileWriter &out, const char *text, std::size_t length)
+    {
+        bool needsQuotes = false;
+        for (std::size_t i = 0; i < length && !needsQuotes; i++)
+            needsQuotes = text[i] == ',' || text[i] == '"' || text[i] == '\n' || text[i] == '\r';
+
+        if (!needsQuotes)
+        {
+            out.append(text, length);
+            return;
+        }
+
+        out.put('"');
+        std::size_t start = 0;
+        for (std::size_t i = 0; i < length; i++)
+        {
+            if (text[i] == '"')
+            {
+                out.append(text + start, i + 1 - start);
+                out.put('"');
+                start = i + 1;
+            }
+        }
+        out.append(text + start, length - start);
+        out.put('"');
+    }
+
+    void writeJsonText(BufferedFileWriter &out, const char *text, std::size_t length)
+    {
+        static const char hex[] = "0123456789abcdef";
+
+        out.put('"');
+        std::size_t start = 0;
+        for (std::size_t i = 0; i < length; i++)
+        {
+            unsigned char c = static_cast<unsigned char>(text[i]);
+            if (c >= 0x20 && c != '"' && c != '\\')
+                continue;
+
+            out.append(text + start, i - start);
+            start = i + 1;
+            switch (c)
+            {
+            case '"':
+                out.append("\\\"", 2);
+                break;
+            case '\\':
+                out.append("\\\\", 2);
+                break;
+            case '\n':
+                out.append("\\n", 2);
+                break;
+            case '\r':
+                out.append("\\r", 2);
+                break;
+            case '\t':
+                out.append("\\t", 2);
+                break;
+            default:
+            {
+                char escape[6] = {'\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xF]};
+                out.append(escape, sizeof(escape));
+                break;
+            }
+            }
+        }
+        out.append(text + start, length - start);
+        out.put('"');
+    }
+
+    bool isJsonLines(const std::string &path)
+    {
+        std::size_t dot = path.find_last_of('.');
+        if (dot == std::string::npos)
+            return false;
+        std::string extension = path.substr(dot + 1);
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+                       [](unsigned char c)
+                       { return static_cast<char>(std::tolower(c)); });
+        return extension == "jsonl" || extension == "ndjson" || extension == "json";
+    }
+
+    bool isAllowedOperator(const std::string &op)
+    {
+        static const char *allowed[] = {"=", "!=", "<", "<=", ">", ">=", "LIKE"};
+        for (const char *candidate : allowed)
+        {
+            if (op == candidate)
+                return true;
+        }
+        return false;
+    }
+
+    // Columns that never leave the database, whatever the caller asks for.
+    bool isWithheldColumn(const std::string &table, const std::string &column)
+    {
+        static const std::pair<const char *, const char *> withheld[] =
+            {{"users", "password"}};
+        for (const auto &entry : withheld)
+        {
+            if (table == entry.first && column == entry.second)
+                return true;
+        }
+        return false;
+    }
+}
+
+/* *************************************************************************
+                     ---------- CONSTRUCTOR ----------
+   *************************************************************************  */
+
+TableExporter::TableExporter(sqlite3 *connection, StatementCache &statementCache)
+    : db(connection), statements(statementCache) {}
+
+/* *************************************************************************
+                        ---------- SCHEMA ----------
+   *************************************************************************  */
+
+const std::vector<std::string> &TableExporter::getExportableTables()
+{
+    static const std::vector<std::string> tables =
+        {"resources", "users", "transactions", "fines", "borrowing_history", "reservations"};
+    return tables;
+}
+
+std::vector<std::string> TableExporter::getColumns(const std::string &table)
+{
+    std::vector<std::string> columns;
+    const std::vector<std::string> &tables = getExportableTables();
+    if (std::find(tables.begin(), tables.end(), table) == tables.end())
+        return columns;
+
+    CachedStatement stmt(statements, "SELECT name FROM pragma_table_info(?) ORDER BY cid;");
+    if (!stmt)
+    {
+        std::cerr << "Failed to read columns of " << table << ": " << sqlite3_errmsg(db) << std::endl;
+        return columns;
+    }
+
+    sqlite3_bind_text(stmt, 1, table.c_str(), -1, SQLITE_TRANSIENT);
+    while (sqlite3_step(stmt) == SQLITE_ROW)
+    {
+        std::string column = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 0));
+        if (!isWithheldColumn(table, column))
+            columns.push_back(std::move(column));
+    }
+    return columns;
+}
+
+/* *************************************************************************
+                        ---------- EXPORT ----------
+   *************************************************************************  */
+
+ExportSummary TableExporter::exportTable(const ExportOptions &options, const std::string &path)
+{
+    ExportSummary summary;
+    auto started = std::chrono::steady_clock::now();
+
+    // Table and column names cannot be bound, so they are checked against the
+    // schema before they go anywhere near the SQL text.
+    std::vector<std::string> tableColumns = getColumns(options.table);
+    if (tableColumns.empty())
+    {
+        summary.error = "\"" + options.table + "\" cannot be exported";
+        return summary;
+    }
+    auto isColumn = [&tableColumns](const std::string &name)
+    {
+        return std::find(tableColumns.begin(), tableColumns.end(), name) != tableColumns.end();
+    };
+
+    const std::vector<std::string> &columns = options.columns.empty() ? tableColumns : options.columns;
+    for (const std::string &column : columns)
+    {
+        if (isWithheldColumn(options.table, column))
+        {
+            summary.error = options.table + "." + column + " cannot be exported";
+            return summary;
+        }
+        if (!isColumn(column))
+        {
+            summary.error = options.table + " has no column \"" + column + "\"";
+            return summary;
+        }
+    }
+
+    std::string sql = "SELECT ";
+    for (std::size_t c = 0; c < columns.size(); c++)
+        sql += (c > 0 ? ", \"" : "\"") + columns[c] + "\"";
+    sql += " FROM \"" + options.table + "\"";
+
+    for (std::size_t f = 0; f < options.filters.size(); f++)
+    {
+        const ExportFilter &filter = options.filters[f];
+        if (isWithheldColumn(options.table, filter.column))
+        {
+            summary.error = options.table + "." + filter.column + " cannot be filtered on";
+            return summary;
+        }
+        if (!isColumn(filter.column))
+        {
+            summary.error = options.table + " has no column \"" + filter.column + "\"";
+            return summary;
+        }
+        if (!isAllowedOperator(filter.op))
+        {
+            summary.error = "unsupported filter operator \"" + filter.op + "\"";
+            return summary;
+        }
+        sql += (f == 0 ? " WHERE \"" : " AND \"") + filter.column + "\" " + filter.op + " ?";
+    }
+    sql += ";";
+
+    // Every projection/filter combination is a different SQL text, so this
+    // one is prepared directly rather than kept in the statement cache.
+    sqlite3_stmt *stmt = nullptr;
+    if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK)
+    {
+        summary.error = sqlite3_errmsg(db);
+        sqlite3_finalize(stmt);
+        return summary;
+    }
+    for (std::size_t f = 0; f < options.filters.size(); f++)
+        sqlite3_bind_text(stmt, static_cast<int>(f + 1), options.filters[f].value.c_str(), -1, SQLITE_TRANSIENT);
+
+    std::FILE *file = std::fopen(path.c_str(), "wb");
+    if (!file)
+    {
+        summary.error = "cannot write " + path;
+        sqlite3_finalize(stmt);
+        return summary;
+    }
+
+    BufferedFileWriter out(file, options.bufferBytes);
+    bool json = isJsonLines(path);
+    int columnCount = static_cast<int>(columns.size());
+
+    // Per-column text that never changes: the CSV header, or each JSON key
+    // with its surrounding punctuation ({"id": / ,"title": ...).
+    std::vector<std::string> keyPrefixes;
+    if (json)
+    {
+        for (int c = 0; c < columnCount; c++)
+            keyPrefixes.push_back((c == 0 ? "{\"" : ",\"") + columns[c] + "\":");
+    }
+    else
+    {
+        for (int c = 0; c < columnCount; c++)
+        {
+            if (c > 0)
+                out.put(',');
+            writeCsvText(out, columns[c].data(), columns[c].size());
+        }
+        out.put('\n');
+    }
+
+    int rc;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
+    {
+        for (int c = 0; c < columnCount; c++)
+        {
+            if (json)
+                out.append(keyPrefixes[c]);
+            else if (c > 0)
+                out.put(',');
+
+            switch (sqlite3_column_type(stmt, c))
+            {
+            case SQLITE_INTEGER:
+                writeInteger(out, sqlite3_column_int64(stmt, c));
+                break;
+            case SQLITE_FLOAT:
+                writeReal(out, sqlite3_column_double(stmt, c));
+                break;
+            case SQLITE_NULL:
+                if (json)
+                    out.append("null", 4);
+                break;
+            default:
+            {
+                const char *text = reinterpret_cast<const char *>(sqlite3_column_text(stmt, c));
+                std::size_t length = static_cast<std::size_t>(sqlite3_column_bytes(stmt, c));
+                if (json)
+                    writeJsonText(out, text, length);
+                else
+                    writeCsvText(out, text, length);
+                break;
+            }
+            }
+        }
+
+        if (json)
+            out.put('}');
+        out.put('\n');
+        summary.rows++;
+
+        if (out.hasFailed())
+            break;
+    }
+
+    if (rc != SQLITE_DONE && rc != SQLITE_ROW)
+        summary.error = sqlite3_errmsg(db);
+    sqlite3_finalize(stmt);
+
+    out.flush();
+    if (std::fclose(file) != 0 || out.hasFailed())
+        summary.error = "write to " + path + " failed";
+
+    summary.bytes = out.bytesWritten();
+    summary.success = summary.error.empty();
+    summary.elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+    return summary;
+}
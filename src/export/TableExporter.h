@@ -0,0 +1,61 @@
+#pragma once
+extern "C"
+{
+#include "sqlite3.h"
+}
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "../infrastructure/database/StatementCache.h"
+
+// One WHERE condition. op is one of = != < <= > >= LIKE; value is always bound
+// as a parameter, and SQLite converts it to the column's type when comparing.
+struct ExportFilter
+{
+    std::string column;
+    std::string op;
+    std::string value;
+};
+
+struct ExportOptions
+{
+    std::string table;
+    std::vector<std::string> columns; // empty = every column, in table order
+    std::vector<ExportFilter> filters; // ANDed together
+    std::size_t bufferBytes = 1 << 20; // output is written to disk in blocks of this size
+};
+
+struct ExportSummary
+{
+    bool success = false;
+    long long rows = 0;
+    long long bytes = 0;
+    std::string error;
+    double elapsedMs = 0.0;
+};
+
+// Streams a table straight from the SELECT cursor into the output file. Each
+// column value is copied from sqlite3_column_text()/int64() into a fixed
+// write buffer (escaped on the way), so no Resource/User/... objects and no
+// per-row strings are built, and memory use is the same for ten rows or ten
+// million. Files ending in .jsonl, .ndjson or .json are written as JSON Lines
+// (one object per row, numbers unquoted, NULL as null), everything else as
+// CSV with a header row.
+class TableExporter
+{
+private:
+    sqlite3 *db;
+    StatementCache &statements;
+
+public:
+    TableExporter(sqlite3 *connection, StatementCache &statementCache);
+
+    // resources, users, transactions, fines, borrowing_history, reservations
+    static const std::vector<std::string> &getExportableTables();
+
+    // Column names of an exportable table, in table order; empty if the table is not exportable.
+    // Password columns are left out, and exportTable() refuses them by name.
+    std::vector<std::string> getColumns(const std::string &table);
+
+    ExportSummary exportTable(const ExportOptions &options, const std::string &path);
+};
@@ -0,0 +1,771 @@
+#include "CatalogueImporter.h"
+#include "../domain/Resource.h"
+#include "../infrastructure/repositories/ResourceRepository.h"
+#include "../validation/validator.h"
+#include "../Utility/BoundedQueue.h"
+#include "../Utility/CivilDate.h"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <fstream>
+#include <limits>
+#include <string_view>
+#include <thread>
+
+namespace
+{
+    /* *************************************************************************
+                      ---------- COLUMNS ----------
+       *************************************************************************  */
+
+    enum Column
+    {
+        Title,
+        Author,
+        Publisher,
+        PublicationYear,
+        Isbn,
+        CategoryId,
+        TotalCopies,
+        AvailableCopies,
+        Description,
+        AddedDate,
+        IsActive,
+        ColumnCount
+    };
+
+    const char *columnNames[ColumnCount] =
+        {"title", "author", "publisher", "publication_year", "isbn", "category_id",
+         "total_copies", "available_copies", "description", "added_date", "is_active"};
+
+    const Column requiredColumns[] =
+        {Title, Author, Publisher, PublicationYear, Isbn, CategoryId, TotalCopies};
+
+    int columnFromName(std::string_view name)
+    {
+        for (int c = 0; c < ColumnCount; c++)
+        {
+            if (name == columnNames[c])
+                return c;
+        }
+        return -1;
+    }
+
+    // One parsed record: the text of each known column and whether it was present.
+    // The strings are reused from row to row, so steady-state parsing does not allocate.
+    struct RowValues
+    {
+        std::string values[ColumnCount];
+        bool present[ColumnCount];
+
+        void clear()
+        {
+            for (int c = 0; c < ColumnCount; c++)
+            {
+                values[c].clear();
+                present[c] = false;
+            }
+        }
+    };
+
+    /* *************************************************************************
+                      ---------- PIPELINE ITEMS ----------
+       *************************************************************************  */
+
+    struct RecordSpan
+    {
+        std::size_t offset;
+        std::size_t length;
+        long long line;
+    };
+
+    // Complete records cut from the file; spans point into text.
+    struct RecordChunk
+    {
+        std::string text;
+        std::vector<RecordSpan> records;
+    };
+
+    struct ParsedBatch
+    {
+        std::vector<Resource> resources;
+        std::vector<long long> lines;
+        std::vector<ImportRejection> rejections;
+        long long rowsRead = 0;
+    };
+
+    /* *************************************************************************
+                          ---------- CSV ----------
+       *************************************************************************  */
+
+    // RFC 4180: fields may be quoted, quotes inside are doubled, and quoted
+    // fields may contain commas and line breaks.
+    void splitCsv(std::string_view record, std::vector<std::string> &fields)
+    {
+        std::size_t count = 0;
+        std::size_t i = 0;
+
+        auto nextField = [&]() -> std::string &
+        {
+            if (count == fields.size())
+                fields.emplace_back();
+            std::string &field = fields[count++];
+            field.clear();
+            return field;
+        };
+
+        while (true)
+        {
+            std::string &field = nextField();
+            if (i < record.size() && record[i] == '"')
+            {
+                i++;
+                while (i < record.size())
+                {
+                    if (record[i] == '"')
+                    {
+                        if (i + 1 < record.size() && record[i + 1] == '"')
+                        {
+                            field += '"';
+                            i += 2;
+                            continue;
+                        }
+                        i++;
+                        break;
+                    }
+                    field += record[i++];
+                }
+                // Anything between the closing quote and the comma is kept as-is.
+                while (i < record.size() && record[i] != ',')
+                    field += record[i++];
+            }
+            else
+            {
+                std::size_t end = record.find(',', i);
+                if (end == std::string_view::npos)
+                    end = record.size();
+                field.append(record.data() + i, end - i);
+                i = end;
+            }
+
+            if (i >= record.size())
+                break;
+            i++; // comma
+        }
+
+        fields.resize(count);
+    }
+
+    /* *************************************************************************
+                       ---------- JSON LINES ----------
+       *************************************************************************  */
+
+    void skipSpace(std::string_view text, std::size_t &i)
+    {
+        while (i < text.size() && std::isspace(static_cast<unsigned char>(text[i])))
+            i++;
+    }
+
+    void appendUtf8(std::string &out, unsigned codePoint)
+    {
+        if (codePoint < 0x80)
+            out += static_cast<char>(codePoint);
+        else if (codePoint < 0x800)
+        {
+            out += static_cast<char>(0xC0 | (codePoint >> 6));
+            out += static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+        else if (codePoint < 0x10000)
+        {
+            out += static_cast<char>(0xE0 | (codePoint >> 12));
+            out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+        else
+        {
+            out += static_cast<char>(0xF0 | (codePoint >> 18));
+            out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+    }
+
+    bool readHex4(std::string_view text, std::size_t &i, unsigned &value)
+    {
+        if (i + 4 > text.size())
+            return false;
+        value = 0;
+        for (int k = 0; k < 4; k++)
+        {
+            char c = text[i++];
+            value <<= 4;
+            if (c >= '0' && c <= '9')
+                value |= c - '0';
+            else if (c >= 'a' && c <= 'f')
+                value |= c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F')
+                value |= c - 'A' + 10;
+            else
+                return false;
+        }
+        return true;
+    }
+
+    // Reads a JSON string starting at the opening quote.
+    bool readJsonString(std::string_view text, std::size_t &i, std::string &out)
+    {
+        out.clear();
+        if (i >= text.size() || text[i] != '"')
+            return false;
+        i++;
+
+        while (i < text.size())
+        {
+            char c = text[i++];
+            if (c == '"')
+                return true;
+            if (c != '\\')
+            {
+                out += c;
+                continue;
+            }
+            if (i >= text.size())
+                return false;
+
+            char escape = text[i++];
+            switch (escape)
+            {
+            case '"':
+            case '\\':
+            case '/':
+                out += escape;
+                break;
+            case 'b':
+                out += '\b';
+                break;
+            case 'f':
+                out += '\f';
+                break;
+            case 'n':
+                out += '\n';
+                break;
+            case 'r':
+                out += '\r';
+                break;
+            case 't':
+                out += '\t';
+                break;
+            case 'u':
+            {
+                unsigned codePoint;
+                if (!readHex4(text, i, codePoint))
+                    return false;
+                // Surrogate pair for characters outside the BMP.
+                if (codePoint >= 0xD800 && codePoint <= 0xDBFF && i + 6 <= text.size() &&
+                    text[i] == '\\' && text[i + 1] == 'u')
+                {
+                    std::size_t next = i + 2;
+                    unsigned low;
+                    if (readHex4(text, next, low) && low >= 0xDC00 && low <= 0xDFFF)
+                    {
+                        codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                        i = next;
+                    }
+                }
+                appendUtf8(out, codePoint);
+                break;
+            }
+            default:
+                return false;
+            }
+        }
+        return false;
+    }
+
+    // Parses one flat object. Numbers, true/false are kept as their text;
+    // null leaves the column absent. Nested objects and arrays are rejected.
+    bool parseJsonObject(std::string_view text, RowValues &row, std::string &key, std::string &error)
+    {
+        std::size_t i = 0;
+        skipSpace(text, i);
+        if (i >= text.size() || text[i] != '{')
+        {
+            error = "expected a JSON object";
+            return false;
+        }
+        i++;
+        skipSpace(text, i);
+        if (i < text.size() && text[i] == '}')
+            return true;
+
+        while (true)
+        {
+            skipSpace(text, i);
+            if (!readJsonString(text, i, key))
+            {
+                error = "malformed key";
+                return false;
+            }
+            skipSpace(text, i);
+            if (i >= text.size() || text[i] != ':')
+            {
+                error = "expected ':' after \"" + key + "\"";
+                return false;
+            }
+            i++;
+            skipSpace(text, i);
+
+            int column = columnFromName(key);
+            std::string scratch;
+            std::string &value = column >= 0 ? row.values[column] : scratch;
+
+            if (i < text.size() && text[i] == '"')
+            {
+                if (!readJsonString(text, i, value))
+                {
+                    error = "malformed string for \"" + key + "\"";
+                    return false;
+                }
+                if (column >= 0)
+                    row.present[column] = true;
+            }
+            else if (i < text.size() && (text[i] == '{' || text[i] == '['))
+            {
+                error = "nested value for \"" + key + "\"";
+                return false;
+            }
+            else
+            {
+                std::size_t start = i;
+                while (i < text.size() && text[i] != ',' && text[i] != '}' &&
+                       !std::isspace(static_cast<unsigned char>(text[i])))
+                    i++;
+                std::string_view literal = text.substr(start, i - start);
+                if (literal.empty())
+                {
+                    error = "missing value for \"" + key + "\"";
+                    return false;
+                }
+                if (column >= 0 && literal != "null")
+                {
+                    value.assign(literal.data(), literal.size());
+                    row.present[column] = true;
+                }
+            }
+
+            skipSpace(text, i);
+            if (i < text.size() && text[i] == ',')
+            {
+                i++;
+                continue;
+            }
+            if (i < text.size() && text[i] == '}')
+                return true;
+
+            error = "expected ',' or '}'";
+            return false;
+        }
+    }
+
+    /* *************************************************************************
+                      ---------- ROW -> RESOURCE ----------
+       *************************************************************************  */
+
+    bool parseInt(const std::string &text, int &out)
+    {
+        const char *begin = text.data();
+        const char *end = text.data() + text.size();
+        while (begin < end && std::isspace(static_cast<unsigned char>(*begin)))
+            begin++;
+        while (end > begin && std::isspace(static_cast<unsigned char>(end[-1])))
+            end--;
+        auto [ptr, ec] = std::from_chars(begin, end, out);
+        return ec == std::errc() && ptr == end && begin != end;
+    }
+
+    bool parseFlag(std::string text, bool &out)
+    {
+        std::transform(text.begin(), text.end(), text.begin(),
+                       [](unsigned char c)
+                       { return static_cast<char>(std::tolower(c)); });
+        if (text == "1" || text == "true" || text == "yes")
+            out = true;
+        else if (text == "0" || text == "false" || text == "no")
+            out = false;
+        else
+            return false;
+        return true;
+    }
+
+    // Fills resource from the row; returns an error message for values that do
+    // not parse. Business rules are left to Validator::validate.
+    std::string buildResource(RowValues &row, const std::string &defaultAddedDate, Resource &resource)
+    {
+        int year = 0, categoryId = 0, totalCopies = 0, availableCopies = 0;
+
+        if (row.present[PublicationYear] && !parseInt(row.values[PublicationYear], year))
+            return "publication_year is not a whole number";
+        if (row.present[CategoryId] && !parseInt(row.values[CategoryId], categoryId))
+            return "category_id is not a whole number";
+        if (row.present[TotalCopies] && !parseInt(row.values[TotalCopies], totalCopies))
+            return "total_copies is not a whole number";
+
+        availableCopies = totalCopies;
+        if (row.present[AvailableCopies] && !row.values[AvailableCopies].empty() &&
+            !parseInt(row.values[AvailableCopies], availableCopies))
+            return "available_copies is not a whole number";
+
+        bool isActive = true;
+        if (row.present[IsActive] && !row.values[IsActive].empty() && !parseFlag(row.values[IsActive], isActive))
+            return "is_active must be 1/0, true/false or yes/no";
+
+        std::string addedDate = defaultAddedDate;
+        if (row.present[AddedDate] && !row.values[AddedDate].empty())
+        {
+            CivilDate date;
+            if (!CivilDate::parse(row.values[AddedDate], date))
+                return "added_date is not a YYYY-MM-DD date";
+            addedDate = date.toString();
+        }
+
+        resource = Resource(0, row.values[Title], row.values[Author], row.values[Publisher], year,
+                            row.values[Isbn], categoryId, totalCopies, availableCopies,
+                            row.values[Description], addedDate, isActive);
+        return "";
+    }
+
+    std::string joinErrors(const std::vector<std::string> &errors)
+    {
+        std::string joined;
+        for (const std::string &error : errors)
+        {
+            if (!joined.empty())
+                joined += "; ";
+            // Validator messages start with "Error: ".
+            joined += error.compare(0, 7, "Error: ") == 0 ? error.substr(7) : error;
+        }
+        return joined;
+    }
+
+    bool isJsonLines(const std::string &path)
+    {
+        std::size_t dot = path.find_last_of('.');
+        if (dot == std::string::npos)
+            return false;
+        std::string extension = path.substr(dot + 1);
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+                       [](unsigned char c)
+                       { return static_cast<char>(std::tolower(c)); });
+        return extension == "jsonl" || extension == "ndjson" || extension == "json";
+    }
+
+    /* *************************************************************************
+                         ---------- STAGES ----------
+       *************************************************************************  */
+
+    // Cuts the file into chunks that end on a record boundary. For CSV a
+    // newline inside a quoted field does not end the record.
+    void readChunks(std::ifstream &file, bool csv, std::size_t chunkBytes,
+                    BoundedQueue<RecordChunk> &chunks, std::string &error)
+    {
+        std::string carry;
+        long long carryLine = 1;
+        std::vector<char> buffer(chunkBytes);
+
+        while (true)
+        {
+            file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            std::size_t got = static_cast<std::size_t>(file.gcount());
+            bool atEnd = got == 0;
+            if (file.bad())
+            {
+                error = "read error";
+                break;
+            }
+
+            RecordChunk chunk;
+            chunk.text = std::move(carry);
+            chunk.text.append(buffer.data(), got);
+
+            std::size_t start = 0;
+            long long line = carryLine;
+            long long recordLine = carryLine;
+            bool inQuotes = false;
+
+            for (std::size_t i = 0; i < chunk.text.size(); i++)
+            {
+                char c = chunk.text[i];
+                if (csv && c == '"')
+                    inQuotes = !inQuotes;
+                else if (c == '\n')
+                {
+                    line++;
+                    if (!inQuotes)
+                    {
+                        chunk.records.push_back({start, i - start, recordLine});
+                        start = i + 1;
+                        recordLine = line;
+                    }
+                }
+            }
+
+            // The unfinished record is carried into the next chunk, unless the file is done.
+            if (atEnd && start < chunk.text.size())
+            {
+                chunk.records.push_back({start, chunk.text.size() - start, recordLine});
+                start = chunk.text.size();
+            }
+            carry.assign(chunk.text, start, std::string::npos);
+            carryLine = recordLine;
+            chunk.text.resize(start);
+
+            if (!chunk.records.empty() && !chunks.push(std::move(chunk)))
+                break; // downstream gave up
+            if (atEnd)
+                break;
+        }
+
+        chunks.close();
+    }
+
+    void parseChunks(bool csv, const ImportOptions &options, BoundedQueue<RecordChunk> &chunks,
+                     BoundedQueue<ParsedBatch> &batches, std::string &error)
+    {
+        RowValues row;
+        std::vector<std::string> fields;
+        std::string key;
+        std::string parseError;
+        std::vector<int> columnOf;
+        std::size_t headerWidth = 0;
+        bool haveHeader = !csv;
+
+        ParsedBatch batch;
+        auto reject = [&batch](long long line, std::string reason)
+        {
+            batch.rejections.push_back({line, std::move(reason)});
+        };
+
+        while (std::optional<RecordChunk> chunk = chunks.pop())
+        {
+            for (const RecordSpan &span : chunk->records)
+            {
+                std::string_view record(chunk->text.data() + span.offset, span.length);
+                if (!record.empty() && record.back() == '\r')
+                    record.remove_suffix(1);
+                if (record.find_first_not_of(" \t") == std::string_view::npos)
+                    continue;
+
+                if (!haveHeader)
+                {
+                    // The header maps each CSV position to a column (or -1 to ignore it).
+                    splitCsv(record, fields);
+                    headerWidth = fields.size();
+                    columnOf.assign(headerWidth, -1);
+                    bool seen[ColumnCount] = {};
+                    for (std::size_t f = 0; f < headerWidth; f++)
+                    {
+                        std::string name = fields[f];
+                        name.erase(0, name.find_first_not_of(" \t\xEF\xBB\xBF")); // also drops a UTF-8 BOM
+                        name.erase(name.find_last_not_of(" \t") + 1);
+                        std::transform(name.begin(), name.end(), name.begin(),
+                                       [](unsigned char c)
+                                       { return static_cast<char>(std::tolower(c)); });
+                        columnOf[f] = columnFromName(name);
+                        if (columnOf[f] >= 0)
+                            seen[columnOf[f]] = true;
+                    }
+                    for (Column required : requiredColumns)
+                    {
+                        if (!seen[required])
+                        {
+                            error = std::string("CSV header has no \"") + columnNames[required] + "\" column";
+                            chunks.close();
+                            batches.close();
+                            return;
+                        }
+                    }
+                    haveHeader = true;
+                    continue;
+                }
+
+                batch.rowsRead++;
+                row.clear();
+
+                if (csv)
+                {
+                    splitCsv(record, fields);
+                    if (fields.size() != headerWidth)
+                    {
+                        reject(span.line, "expected " + std::to_string(headerWidth) + " fields, found " +
+                                              std::to_string(fields.size()));
+                        continue;
+                    }
+                    for (std::size_t f = 0; f < headerWidth; f++)
+                    {
+                        if (columnOf[f] >= 0)
+                        {
+                            row.values[columnOf[f]].swap(fields[f]);
+                            row.present[columnOf[f]] = true;
+                        }
+                    }
+                }
+                else if (!parseJsonObject(record, row, key, parseError))
+                {
+                    reject(span.line, parseError);
+                    continue;
+                }
+
+                Resource resource;
+                std::string buildError = buildResource(row, options.defaultAddedDate, resource);
+                if (!buildError.empty())
+                {
+                    reject(span.line, buildError);
+                    continue;
+                }
+
+                Validator::ValidationResult validation = Validator::validate(resource);
+                if (!validation.isValid)
+                {
+                    reject(span.line, joinErrors(validation.errors));
+                    continue;
+                }
+
+                batch.resources.push_back(std::move(resource));
+                batch.lines.push_back(span.line);
+
+                if (static_cast<int>(batch.resources.size()) >= options.batchSize)
+                {
+                    if (!batches.push(std::move(batch)))
+                        return; // the writer stopped
+                    batch = ParsedBatch();
+                }
+            }
+        }
+
+        if (!haveHeader)
+            error = "the file is empty";
+        else if (batch.rowsRead > 0 || !batch.rejections.empty())
+            batches.push(std::move(batch));
+        batches.close();
+    }
+}
+
+/* *************************************************************************
+                     ---------- CONSTRUCTOR ----------
+   *************************************************************************  */
+
+CatalogueImporter::CatalogueImporter(ResourceRepository &resourceRepo)
+    : resourceRepository(resourceRepo) {}
+
+/* *************************************************************************
+                        ---------- IMPORT ----------
+   *************************************************************************  */
+
+ImportSummary CatalogueImporter::importFile(const std::string &path, const ImportOptions &options,
+                                            const ImportProgress &progress)
+{
+    ImportSummary summary;
+    auto started = std::chrono::steady_clock::now();
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        summary.error = "cannot open " + path;
+        return summary;
+    }
+
+    std::ofstream rejectsFile;
+    if (!options.rejectsFile.empty())
+    {
+        rejectsFile.open(options.rejectsFile);
+        if (!rejectsFile)
+        {
+            summary.error = "cannot write " + options.rejectsFile;
+            return summary;
+        }
+        rejectsFile << "line,reason\n";
+    }
+
+    ImportOptions settings = options;
+    settings.batchSize = std::max(1, settings.batchSize);
+    settings.chunkBytes = std::max<std::size_t>(4096, settings.chunkBytes);
+
+    bool csv = !isJsonLines(path);
+    BoundedQueue<RecordChunk> chunks(settings.queueDepth);
+    BoundedQueue<ParsedBatch> batches(settings.queueDepth);
+    std::string readError;
+    std::string parseError;
+
+    std::thread reader(readChunks, std::ref(file), csv, settings.chunkBytes, std::ref(chunks), std::ref(readError));
+    std::thread parser(parseChunks, csv, std::cref(settings), std::ref(chunks), std::ref(batches), std::ref(parseError));
+
+    auto recordRejection = [&](long long line, const std::string &reason)
+    {
+        summary.rejected++;
+        if (summary.firstRejections.size() < settings.rejectionsToKeep)
+            summary.firstRejections.push_back({line, reason});
+        if (rejectsFile.is_open())
+        {
+            std::string quoted = reason;
+            for (std::size_t q = quoted.find('"'); q != std::string::npos; q = quoted.find('"', q + 2))
+                quoted.insert(q, 1, '"');
+            rejectsFile << line << ",\"" << quoted << "\"\n";
+        }
+    };
+
+    bool writeFailed = false;
+    while (std::optional<ParsedBatch> batch = batches.pop())
+    {
+        summary.rowsRead += batch->rowsRead;
+
+        // Rejections and saved rows are reported in file order within the batch.
+        std::size_t nextRejection = 0;
+        auto flushRejectionsBefore = [&](long long line)
+        {
+            while (nextRejection < batch->rejections.size() && batch->rejections[nextRejection].line < line)
+            {
+                recordRejection(batch->rejections[nextRejection].line, batch->rejections[nextRejection].reason);
+                nextRejection++;
+            }
+        };
+
+        if (!batch->resources.empty())
+        {
+            BatchSaveResult result;
+            if (!resourceRepository.saveAll(batch->resources, result))
+            {
+                // The whole batch was rolled back; later batches would fail the same way.
+                summary.error = "could not write to the database";
+                writeFailed = true;
+                break;
+            }
+
+            for (std::size_t r = 0; r < batch->resources.size(); r++)
+            {
+                flushRejectionsBefore(batch->lines[r]);
+                if (r < result.rowErrors.size() && !result.rowErrors[r].empty())
+                    recordRejection(batch->lines[r], "database: " + result.rowErrors[r]);
+            }
+            summary.imported += result.saved;
+        }
+        flushRejectionsBefore(std::numeric_limits<long long>::max());
+
+        if (progress)
+            progress(summary);
+    }
+
+    if (writeFailed)
+    {
+        batches.close();
+        chunks.close();
+    }
+    reader.join();
+    parser.join();
+
+    if (summary.error.empty())
+        summary.error = !parseError.empty() ? parseError : readError;
+    summary.success = summary.error.empty();
+    summary.elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+    return summary;
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+class ResourceRepository;
+
+// One input record that did not make it into the catalogue.
+struct ImportRejection
+{
+    long long line; // physical line the record starts on (1-based)
+    std::string reason;
+};
+
+struct ImportOptions
+{
+    std::string defaultAddedDate;      // used for rows without an added_date
+    std::string rejectsFile;           // when set, every rejection is written here as "line,reason"
+    int batchSize = 2000;              // resources per saveAll() / commit
+    std::size_t chunkBytes = 1 << 20;  // how much the reader pulls from disk at a time
+    std::size_t queueDepth = 4;        // chunks and batches allowed in flight between stages
+    std::size_t rejectionsToKeep = 20; // how many rejections the summary holds for display
+};
+
+struct ImportSummary
+{
+    bool success = false; // whole file read and every batch committed
+    long long rowsRead = 0;
+    long long imported = 0;
+    long long rejected = 0;
+    std::vector<ImportRejection> firstRejections;
+    std::string error; // why the import stopped early, if it did
+    double elapsedMs = 0.0;
+};
+
+// Called on the importing thread after every committed batch.
+using ImportProgress = std::function<void(const ImportSummary &)>;
+
+// Streams a CSV or JSON Lines catalogue file into the resources table.
+//
+//   reader thread   file -> chunks of complete records
+//   parser thread   chunk -> Resource -> Validator::validate -> batch
+//   calling thread  batch -> ResourceRepository::saveAll
+//
+// The stages are joined by bounded queues, so memory stays at roughly
+// queueDepth chunks plus queueDepth batches whatever the file size, and the
+// SQLite connection is only ever used from the calling thread.
+//
+// Columns / keys: title, author, publisher, publication_year, isbn,
+// category_id, total_copies, and optionally available_copies (defaults to
+// total_copies), description, added_date and is_active. A CSV file must start
+// with a header row; other columns are ignored. Files ending in .jsonl,
+// .ndjson or .json are read as JSON Lines (one flat object per line),
+// everything else as CSV.
+class CatalogueImporter
+{
+private:
+    ResourceRepository &resourceRepository;
+
+public:
+    explicit CatalogueImporter(ResourceRepository &resourceRepo);
+
+    ImportSummary importFile(const std::string &path, const ImportOptions &options,
+                             const ImportProgress &progress = nullptr);
+};
@@ -0,0 +1,154 @@
+#include "ConnectionPool.h"
+#include <iostream>
+
+/* *************************************************************************
+                 ---------- CONSTRUCTORS & DESTRUCTORS ----------
+   *************************************************************************  */
+
+ConnectionPool::ConnectionPool(const std::string &filename, const ConnectionProfile &connectionProfile,
+                               std::size_t readerCount)
+    : dbFile(filename), profile(connectionProfile), readerTarget(readerCount > 0 ? readerCount : 1) {}
+
+ConnectionPool::~ConnectionPool()
+{
+    close();
+}
+
+/* *************************************************************************
+                  ---------- OPENING & CLOSING ----------
+   *************************************************************************  */
+
+bool ConnectionPool::openConnection(PooledConnection &connection, bool readOnly)
+{
+    // Each connection is only ever used by the thread holding its lease, so
+    // SQLite's per-connection mutex is not needed.
+    int flags = (readOnly ? SQLITE_OPEN_READONLY : SQLITE_OPEN_READWRITE) | SQLITE_OPEN_NOMUTEX;
+
+    if (sqlite3_open_v2(dbFile.c_str(), &connection.db, flags, nullptr) != SQLITE_OK)
+    {
+        std::cerr << "Cannot open pooled connection: " << sqlite3_errmsg(connection.db) << std::endl;
+        sqlite3_close(connection.db);
+        connection.db = nullptr;
+        return false;
+    }
+
+    sqlite3_exec(connection.db, "PRAGMA foreign_keys = ON;", nullptr, nullptr, nullptr);
+    if (!applyConnectionProfile(connection.db, profile, readOnly))
+    {
+        closeConnection(connection);
+        return false;
+    }
+
+    connection.statements = std::make_unique<StatementCache>(connection.db);
+    return true;
+}
+
+void ConnectionPool::closeConnection(PooledConnection &connection)
+{
+    // Cached statements must be finalized before the connection can close.
+    connection.statements.reset();
+    if (connection.db)
+    {
+        sqlite3_close(connection.db);
+        connection.db = nullptr;
+    }
+}
+
+bool ConnectionPool::open()
+{
+    close();
+
+    if (!openConnection(writer, false))
+        return false;
+
+    std::lock_guard<std::mutex> lock(readersMutex);
+    for (std::size_t i = 0; i < readerTarget; i++)
+    {
+        auto reader = std::make_unique<PooledConnection>();
+        if (!openConnection(*reader, true))
+            break;
+        idleReaders.push_back(reader.get());
+        readers.push_back(std::move(reader));
+    }
+
+    return !readers.empty();
+}
+
+// Every lease must have been returned first.
+void ConnectionPool::close()
+{
+    std::lock_guard<std::mutex> lock(readersMutex);
+    for (auto &reader : readers)
+        closeConnection(*reader);
+    readers.clear();
+    idleReaders.clear();
+    closeConnection(writer);
+}
+
+/* *************************************************************************
+                          ---------- LEASES ----------
+   *************************************************************************  */
+
+ConnectionPool::ReadLease ConnectionPool::acquireReader()
+{
+    std::unique_lock<std::mutex> lock(readersMutex);
+    if (readers.empty())
+        return ReadLease(this, nullptr);
+
+    readerLeases++;
+    if (idleReaders.empty())
+    {
+        readerWaits++;
+        readerReturned.wait(lock, [this]
+                            { return !idleReaders.empty(); });
+    }
+
+    PooledConnection *connection = idleReaders.back();
+    idleReaders.pop_back();
+    return ReadLease(this, connection);
+}
+
+ConnectionPool::ReadLease ConnectionPool::tryAcquireReader(std::size_t leaveIdle)
+{
+    std::lock_guard<std::mutex> lock(readersMutex);
+    if (idleReaders.size() <= leaveIdle)
+        return ReadLease(this, nullptr);
+
+    readerLeases++;
+    PooledConnection *connection = idleReaders.back();
+    idleReaders.pop_back();
+    return ReadLease(this, connection);
+}
+
+void ConnectionPool::returnReader(PooledConnection *connection)
+{
+    {
+        std::lock_guard<std::mutex> lock(readersMutex);
+        idleReaders.push_back(connection);
+    }
+    readerReturned.notify_one();
+}
+
+ConnectionPool::ReadLease::~ReadLease()
+{
+    if (lent)
+        pool->returnReader(lent);
+}
+
+ConnectionPool::WriteLease ConnectionPool::acquireWriter()
+{
+    std::unique_lock<std::mutex> lock(writerMutex);
+    return WriteLease(std::move(lock), writer.db ? &writer : nullptr);
+}
+
+std::size_t ConnectionPool::getReaderLeases()
+{
+    std::lock_guard<std::mutex> lock(readersMutex);
+    return readerLeases;
+}
+
+std::size_t ConnectionPool::getReaderWaits()
+{
+    std::lock_guard<std::mutex> lock(readersMutex);
+    return readerWaits;
+}
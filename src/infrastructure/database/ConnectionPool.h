@@ -0,0 +1,128 @@
+#pragma once
+extern "C"
+{
+#include "sqlite3.h"
+}
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "StatementCache.h"
+#include "ConnectionProfile.h"
+
+// Extra connections to the library database for work that runs off the main
+// thread: one writer and a fixed set of read-only readers, each with its own
+// StatementCache. A thread borrows a connection through a lease, builds the
+// repositories it needs on lease.connection() / lease.statements(), and hands
+// the connection back when the lease goes out of scope.
+//
+// Readers are opened read-only and under WAL see a consistent snapshot per
+// statement, so reports and exports never block circulation. Threads that
+// write, such as the desk server's workers, do so only while holding
+// acquireWriter(), so they queue on the writer's mutex instead of racing into
+// SQLITE_BUSY. The interactive console holds the writer lease for its whole
+// run and builds its repositories on it, so each process has one writing
+// connection; SQLite's own write lock (with the profile's busy timeout) only
+// orders commits between processes, such as a console and a desk server.
+class ConnectionPool
+{
+private:
+    struct PooledConnection
+    {
+        sqlite3 *db = nullptr;
+        std::unique_ptr<StatementCache> statements;
+    };
+
+    std::string dbFile;
+    ConnectionProfile profile;
+    std::size_t readerTarget;
+
+    PooledConnection writer;
+    std::mutex writerMutex;
+
+    std::vector<std::unique_ptr<PooledConnection>> readers;
+    std::vector<PooledConnection *> idleReaders;
+    std::mutex readersMutex;
+    std::condition_variable readerReturned;
+
+    std::size_t readerLeases = 0;
+    std::size_t readerWaits = 0; // leases that found every reader busy
+
+    bool openConnection(PooledConnection &connection, bool readOnly);
+    void closeConnection(PooledConnection &connection);
+    void returnReader(PooledConnection *connection);
+
+public:
+    static constexpr std::size_t defaultReaders = 4;
+    // Readers an opportunistic caller should leave idle (see tryAcquireReader)
+    // so an export or a second report is never starved.
+    static constexpr std::size_t reservedReaders = 2;
+
+    // Exclusive use of one reader until destroyed. Movable, not copyable.
+    class ReadLease
+    {
+    private:
+        ConnectionPool *pool;
+        PooledConnection *lent;
+
+        friend class ConnectionPool;
+        ReadLease(ConnectionPool *owner, PooledConnection *connection) : pool(owner), lent(connection) {}
+
+    public:
+        ReadLease(ReadLease &&other) noexcept : pool(other.pool), lent(other.lent) { other.lent = nullptr; }
+        ReadLease &operator=(ReadLease &&) = delete;
+        ReadLease(const ReadLease &) = delete;
+        ~ReadLease();
+
+        explicit operator bool() const { return lent != nullptr; }
+        sqlite3 *connection() const { return lent->db; }
+        StatementCache &statements() const { return *lent->statements; }
+    };
+
+    // Exclusive use of the writer until destroyed.
+    class WriteLease
+    {
+    private:
+        std::unique_lock<std::mutex> lock;
+        PooledConnection *lent;
+
+        friend class ConnectionPool;
+        WriteLease(std::unique_lock<std::mutex> &&held, PooledConnection *connection)
+            : lock(std::move(held)), lent(connection) {}
+
+    public:
+        WriteLease(WriteLease &&) = default;
+        WriteLease &operator=(WriteLease &&) = delete;
+        WriteLease(const WriteLease &) = delete;
+
+        explicit operator bool() const { return lent != nullptr; }
+        sqlite3 *connection() const { return lent->db; }
+        StatementCache &statements() const { return *lent->statements; }
+    };
+
+    explicit ConnectionPool(const std::string &filename, const ConnectionProfile &connectionProfile = ConnectionProfile(),
+                            std::size_t readerCount = defaultReaders);
+    ~ConnectionPool();
+
+    ConnectionPool(const ConnectionPool &) = delete;
+    ConnectionPool &operator=(const ConnectionPool &) = delete;
+
+    // Opens the writer and every reader. Run after the schema is migrated.
+    bool open();
+    void close();
+
+    // Block until a connection is free. The lease is empty (false) when the
+    // pool is not open.
+    ReadLease acquireReader();
+    WriteLease acquireWriter();
+    // Never waits: the lease is empty unless more than leaveIdle readers are
+    // idle. Use it for extra readers after one has been acquired, so two
+    // callers each holding some readers cannot wait on each other.
+    ReadLease tryAcquireReader(std::size_t leaveIdle = 0);
+
+    std::size_t getReaderCount() const { return readers.size(); }
+    std::size_t getReaderLeases();
+    std::size_t getReaderWaits();
+};
@@ -0,0 +1,29 @@
+#include "ConnectionProfile.h"
+extern "C"
+{
+#include "sqlite3.h"
+}
+#include <iostream>
+
+bool applyConnectionProfile(sqlite3 *db, const ConnectionProfile &profile, bool readOnly)
+{
+    std::string pragmas;
+    if (!readOnly)
+        pragmas += "PRAGMA journal_mode = " + profile.journalMode + ";";
+    pragmas +=
+        "PRAGMA synchronous = " + profile.synchronous + ";"
+        "PRAGMA temp_store = " + profile.tempStore + ";"
+        "PRAGMA cache_size = -" + std::to_string(profile.cacheSizeKb) + ";"
+        "PRAGMA mmap_size = " + std::to_string(profile.mmapSizeBytes) + ";";
+
+    char *errMsg = nullptr;
+    if (sqlite3_exec(db, pragmas.c_str(), nullptr, nullptr, &errMsg) != SQLITE_OK)
+    {
+        std::cerr << "Error applying connection profile: " << (errMsg ? errMsg : "Unknown error") << std::endl;
+        sqlite3_free(errMsg);
+        return false;
+    }
+
+    sqlite3_busy_timeout(db, profile.busyTimeoutMs);
+    return true;
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include <string>
+
+struct sqlite3;
+
+// Tuning applied to every SQLite connection the application opens.
+// The defaults favour interactive circulation: WAL so report reads never
+// block writes, and synchronous=NORMAL so a commit does not wait on an fsync
+// (WAL stays consistent after a crash; only the last commits can be lost).
+struct ConnectionProfile
+{
+    std::string journalMode = "WAL";     // DELETE | TRUNCATE | PERSIST | MEMORY | WAL | OFF
+    std::string synchronous = "NORMAL";  // OFF | NORMAL | FULL | EXTRA
+    std::string tempStore = "MEMORY";    // DEFAULT | FILE | MEMORY
+    int cacheSizeKb = 16384;             // page cache per connection (PRAGMA cache_size = -KiB)
+    long long mmapSizeBytes = 268435456; // memory-mapped I/O window, 0 disables it
+    int busyTimeoutMs = 5000;            // how long a locked write waits before SQLITE_BUSY
+
+    // Maintenance: wal_checkpoint + PRAGMA optimize at most once per interval.
+    int maintenanceIntervalSeconds = 600;
+};
+
+// Runs the profile's pragmas and busy timeout on an open handle. Read-only
+// handles skip journal_mode, which belongs to the file and is set by a writer.
+bool applyConnectionProfile(sqlite3 *db, const ConnectionProfile &profile, bool readOnly = false);
@@ -0,0 +1,642 @@
+#include "DataSeeder.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+
+namespace
+{
+    // Membership tiers in the order they are created; extra tiers reuse the last row.
+    struct TierTemplate
+    {
+        const char *name;
+        int durationDays;
+        double price;
+        int maxBorrowingLimit;
+        int borrowingDurationDays;
+        double share; // fraction of members on this tier
+    };
+
+    const TierTemplate tierTemplates[] =
+        {
+            {"Basic", 365, 10.0, 2, 14, 0.60},
+            {"Standard", 365, 25.0, 4, 21, 0.30},
+            {"Premium", 365, 50.0, 8, 28, 0.10},
+    };
+
+    const char *categoryNames[] =
+        {"Books", "Journals & Magazines", "Digital Media", "Reference", "Children", "Fiction",
+         "Science", "History", "Biography", "Computing", "Art", "Travel"};
+
+    const double finePerDay = 5.0; // same flat rate the daily fine engine charges
+
+    // Text is copied by SQLite (TRANSIENT) so the caller's stack buffer can be reused.
+    bool bindText(sqlite3_stmt *stmt, int index, const char *text, int length)
+    {
+        return sqlite3_bind_text(stmt, index, text, length, SQLITE_TRANSIENT) == SQLITE_OK;
+    }
+
+    bool bindDate(sqlite3_stmt *stmt, int index, const CivilDate &date)
+    {
+        char iso[10];
+        date.formatIso(iso);
+        return bindText(stmt, index, iso, sizeof(iso));
+    }
+
+    // Steps an INSERT/UPDATE once and rearms it for the next row.
+    bool stepAndReset(sqlite3 *db, sqlite3_stmt *stmt, const char *table)
+    {
+        int rc = sqlite3_step(stmt);
+        sqlite3_reset(stmt);
+        if (rc != SQLITE_DONE)
+        {
+            std::cerr << "Seeding " << table << " failed: " << sqlite3_errmsg(db) << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    bool prepared(sqlite3 *db, sqlite3_stmt *stmt)
+    {
+        if (!stmt)
+            std::cerr << "Failed to prepare seed statement: " << sqlite3_errmsg(db) << std::endl;
+        return stmt != nullptr;
+    }
+}
+
+long long SeedSummary::totalRows() const
+{
+    return categories + membershipTypes + administrators + users + resources +
+           transactions + fines + borrowingHistory + reservations;
+}
+
+/* *************************************************************************
+                     ---------- CONSTRUCTOR ----------
+   *************************************************************************  */
+
+DataSeeder::DataSeeder(sqlite3 *connection, StatementCache &statementCache, unsigned seed, const CivilDate &seedToday)
+    : db(connection), statements(statementCache), random(seed), today(seedToday), rowsInBatch(0) {}
+
+int DataSeeder::pick(int low, int high)
+{
+    return std::uniform_int_distribution<int>(low, high)(random);
+}
+
+bool DataSeeder::chance(double probability)
+{
+    return std::uniform_real_distribution<double>(0.0, 1.0)(random) < probability;
+}
+
+bool DataSeeder::rowWritten()
+{
+    if (++rowsInBatch < volumes.batchSize)
+        return true;
+
+    rowsInBatch = 0;
+    char *errMsg = nullptr;
+    if (sqlite3_exec(db, "COMMIT;BEGIN;", nullptr, nullptr, &errMsg) != SQLITE_OK)
+    {
+        std::cerr << "Seed batch commit failed: " << (errMsg ? errMsg : "Unknown error") << std::endl;
+        sqlite3_free(errMsg);
+        return false;
+    }
+    return true;
+}
+
+/* *************************************************************************
+                         ---------- SEED ----------
+   *************************************************************************  */
+
+bool DataSeeder::seed(const SeedVolumes &seedVolumes)
+{
+    auto started = std::chrono::steady_clock::now();
+    volumes = seedVolumes;
+    summary = SeedSummary();
+    rowsInBatch = 0;
+
+    if (volumes.categories <= 0 || volumes.membershipTypes <= 0 || volumes.users <= 0 ||
+        volumes.resources <= 0 || volumes.batchSize <= 0)
+    {
+        std::cerr << "Seeding needs at least one category, membership type, user and resource." << std::endl;
+        return false;
+    }
+
+    {
+        CachedStatement stmt(statements, "SELECT (SELECT COUNT(*) FROM users) + (SELECT COUNT(*) FROM resources);");
+        if (!prepared(db, stmt) || sqlite3_step(stmt) != SQLITE_ROW)
+            return false;
+        if (sqlite3_column_int64(stmt, 0) != 0)
+        {
+            std::cerr << "Refusing to seed: the database already contains users or resources." << std::endl;
+            return false;
+        }
+    }
+
+    if (sqlite3_exec(db, "BEGIN;", nullptr, nullptr, nullptr) != SQLITE_OK)
+    {
+        std::cerr << "Cannot begin seed transaction: " << sqlite3_errmsg(db) << std::endl;
+        return false;
+    }
+
+    bool ok = seedMembershipTypes() && seedCategories() && seedAdministrators() && seedUsers() &&
+              seedResources() && seedCirculation() && seedReservations() && updateAvailableCopies();
+
+    // Batches already committed stay; only the open one is undone.
+    if (!ok || sqlite3_exec(db, "COMMIT;", nullptr, nullptr, nullptr) != SQLITE_OK)
+    {
+        sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+        return false;
+    }
+
+    // Fresh statistics so the first real queries get good plans.
+    sqlite3_exec(db, "ANALYZE;", nullptr, nullptr, nullptr);
+
+    summary.elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+    return true;
+}
+
+/* *************************************************************************
+                  ---------- REFERENCE TABLES ----------
+   *************************************************************************  */
+
+bool DataSeeder::seedMembershipTypes()
+{
+    CachedStatement stmt(statements,
+                         "INSERT INTO membership_types "
+                         "(membership_name, duration_days, price, max_borrowing_limit, "
+                         "borrowing_duration_days, fine_per_day, description) "
+                         "VALUES (?, ?, ?, ?, ?, ?, ?);");
+    if (!prepared(db, stmt))
+        return false;
+
+    const int templateCount = sizeof(tierTemplates) / sizeof(tierTemplates[0]);
+    membershipIds.clear();
+
+    for (int i = 0; i < volumes.membershipTypes; i++)
+    {
+        const TierTemplate &tier = tierTemplates[std::min(i, templateCount - 1)];
+        char name[32];
+        int nameLength = i < templateCount ? std::snprintf(name, sizeof(name), "%s", tier.name)
+                                           : std::snprintf(name, sizeof(name), "%s %d", tier.name, i - templateCount + 2);
+
+        if (!bindText(stmt, 1, name, nameLength) ||
+            sqlite3_bind_int(stmt, 2, tier.durationDays) != SQLITE_OK ||
+            sqlite3_bind_double(stmt, 3, tier.price) != SQLITE_OK ||
+            sqlite3_bind_int(stmt, 4, tier.maxBorrowingLimit) != SQLITE_OK ||
+            sqlite3_bind_int(stmt, 5, tier.borrowingDurationDays) != SQLITE_OK ||
+            sqlite3_bind_double(stmt, 6, finePerDay) != SQLITE_OK ||
+            !bindText(stmt, 7, "Generated membership tier", -1) ||
+            !stepAndReset(db, stmt, "membership_types"))
+            return false;
+
+        membershipIds.push_back(static_cast<int>(sqlite3_last_insert_rowid(db)));
+        summary.membershipTypes++;
+        if (!rowWritten())
+            return false;
+    }
+    return true;
+}
+
+bool DataSeeder::seedCategories()
+{
+    CachedStatement stmt(statements, "INSERT INTO categories (name, description) VALUES (?, ?);");
+    if (!prepared(db, stmt))
+        return false;
+
+    const int nameCount = sizeof(categoryNames) / sizeof(categoryNames[0]);
+    categoryIds.clear();
+
+    for (int i = 0; i < volumes.categories; i++)
+    {
+        char name[48];
+        int nameLength = i < nameCount ? std::snprintf(name, sizeof(name), "%s", categoryNames[i])
+                                       : std::snprintf(name, sizeof(name), "Collection %d", i + 1);
+
+        if (!bindText(stmt, 1, name, nameLength) ||
+            !bindText(stmt, 2, "Generated category", -1) ||
+            !stepAndReset(db, stmt, "categories"))
+            return false;
+
+        categoryIds.push_back(static_cast<int>(sqlite3_last_insert_rowid(db)));
+        summary.categories++;
+        if (!rowWritten())
+            return false;
+    }
+    return true;
+}
+
+// The first account is admin/admin so a seeded database can be logged into.
+bool DataSeeder::seedAdministrators()
+{
+    CachedStatement stmt(statements,
+                         "INSERT INTO administrators "
+                         "(username, password, first_name, last_name, email, created_date, is_active) "
+                         "VALUES (?, ?, ?, ?, ?, ?, 1);");
+    if (!prepared(db, stmt))
+        return false;
+
+    for (int i = 0; i < volumes.administrators; i++)
+    {
+        char username[24];
+        char email[48];
+        int usernameLength = i == 0 ? std::snprintf(username, sizeof(username), "admin")
+                                    : std::snprintf(username, sizeof(username), "admin%d", i + 1);
+        int emailLength = std::snprintf(email, sizeof(email), "%s@library.example", username);
+
+        if (!bindText(stmt, 1, username, usernameLength) ||
+            !bindText(stmt, 2, "admin", 5) ||
+            !bindText(stmt, 3, "Library", -1) ||
+            !bindText(stmt, 4, "Administrator", -1) ||
+            !bindText(stmt, 5, email, emailLength) ||
+            !bindDate(stmt, 6, today.addDays(-volumes.historyDays)) ||
+            !stepAndReset(db, stmt, "administrators"))
+            return false;
+
+        summary.administrators++;
+        if (!rowWritten())
+            return false;
+    }
+    return true;
+}
+
+/* *************************************************************************
+                    ---------- USERS & RESOURCES ----------
+   *************************************************************************  */
+
+bool DataSeeder::seedUsers()
+{
+    CachedStatement stmt(statements,
+                         "INSERT INTO users "
+                         "(username, password, first_name, last_name, email, address, phone, "
+                         "balance, membership_type_id, registration_date, is_active) "
+                         "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?);");
+    if (!prepared(db, stmt))
+        return false;
+
+    const int templateCount = sizeof(tierTemplates) / sizeof(tierTemplates[0]);
+    std::vector<double> tierShares;
+    for (int i = 0; i < static_cast<int>(membershipIds.size()); i++)
+        tierShares.push_back(i < templateCount ? tierTemplates[i].share : 0.02);
+    std::discrete_distribution<int> tierOf(tierShares.begin(), tierShares.end());
+
+    userIds.clear();
+    userIds.reserve(volumes.users);
+
+    for (int i = 0; i < volumes.users; i++)
+    {
+        char username[24], firstName[24], lastName[24], email[48], address[40], phone[16];
+        int usernameLength = std::snprintf(username, sizeof(username), "user%d", i + 1);
+        int firstNameLength = std::snprintf(firstName, sizeof(firstName), "First%d", i + 1);
+        int lastNameLength = std::snprintf(lastName, sizeof(lastName), "Last%d", i % 997);
+        int emailLength = std::snprintf(email, sizeof(email), "user%d@example.com", i + 1);
+        int addressLength = std::snprintf(address, sizeof(address), "%d Library Street", pick(1, 9999));
+        int phoneLength = std::snprintf(phone, sizeof(phone), "555-%04d", pick(0, 9999));
+
+        // Most members are active; a few have lapsed.
+        if (!bindText(stmt, 1, username, usernameLength) ||
+            !bindText(stmt, 2, "password", 8) ||
+            !bindText(stmt, 3, firstName, firstNameLength) ||
+            !bindText(stmt, 4, lastName, lastNameLength) ||
+            !bindText(stmt, 5, email, emailLength) ||
+            !bindText(stmt, 6, address, addressLength) ||
+            !bindText(stmt, 7, phone, phoneLength) ||
+            sqlite3_bind_double(stmt, 8, pick(0, 500)) != SQLITE_OK ||
+            sqlite3_bind_int(stmt, 9, membershipIds[tierOf(random)]) != SQLITE_OK ||
+            !bindDate(stmt, 10, today.addDays(-pick(0, volumes.historyDays + 365))) ||
+            sqlite3_bind_int(stmt, 11, chance(0.97) ? 1 : 0) != SQLITE_OK ||
+            !stepAndReset(db, stmt, "users"))
+            return false;
+
+        userIds.push_back(static_cast<int>(sqlite3_last_insert_rowid(db)));
+        summary.users++;
+        if (!rowWritten())
+            return false;
+    }
+    return true;
+}
+
+// The per-row full-text trigger is by far the most expensive part of a
+// resource insert, so it is lifted for the load and the index is rebuilt in
+// one pass afterwards. The trigger's own SQL is read back from the schema so
+// the migration stays its only definition.
+bool DataSeeder::seedResources()
+{
+    std::string triggerSql;
+    {
+        CachedStatement stmt(statements, "SELECT sql FROM sqlite_master WHERE type='trigger' AND name='resources_fts_ai';");
+        if (!prepared(db, stmt))
+            return false;
+        if (sqlite3_step(stmt) == SQLITE_ROW)
+            triggerSql = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 0));
+    }
+
+    if (triggerSql.empty())
+        return insertResources();
+
+    if (sqlite3_exec(db, "DROP TRIGGER resources_fts_ai;", nullptr, nullptr, nullptr) != SQLITE_OK)
+    {
+        std::cerr << "Cannot suspend catalogue index trigger: " << sqlite3_errmsg(db) << std::endl;
+        return false;
+    }
+
+    bool inserted = insertResources();
+
+    // A batch commit may already have made the drop permanent, so the restore
+    // cannot ride in the open batch, where seed()'s ROLLBACK would undo it.
+    // End the batch (keeping it only if the load succeeded), then restore and
+    // rebuild in a transaction of their own, success or not.
+    if (!inserted || sqlite3_exec(db, "COMMIT;", nullptr, nullptr, nullptr) != SQLITE_OK)
+    {
+        inserted = false;
+        sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+    }
+
+    // The rollback may have undone the drop too, hence IF EXISTS.
+    std::string restore = "BEGIN;DROP TRIGGER IF EXISTS resources_fts_ai;" + triggerSql +
+                          ";INSERT INTO resources_fts(resources_fts) VALUES ('rebuild');COMMIT;";
+    bool restored = sqlite3_exec(db, restore.c_str(), nullptr, nullptr, nullptr) == SQLITE_OK;
+    if (!restored)
+    {
+        std::cerr << "Cannot restore catalogue index trigger: " << sqlite3_errmsg(db) << std::endl;
+        sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+    }
+
+    // seed() still expects an open transaction to commit or roll back.
+    if (sqlite3_exec(db, "BEGIN;", nullptr, nullptr, nullptr) != SQLITE_OK)
+    {
+        std::cerr << "Cannot reopen seed transaction: " << sqlite3_errmsg(db) << std::endl;
+        return false;
+    }
+    rowsInBatch = 0;
+    return inserted && restored;
+}
+
+bool DataSeeder::insertResources()
+{
+    CachedStatement stmt(statements,
+                         "INSERT INTO resources "
+                         "(title, author, publisher, publication_year, isbn, category_id, "
+                         "total_copies, available_copies, description, added_date, is_active) "
+                         "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?);");
+    if (!prepared(db, stmt))
+        return false;
+
+    resourceIds.clear();
+    resourceIds.reserve(volumes.resources);
+    totalCopies.assign(volumes.resources, 0);
+    copiesOut.assign(volumes.resources, 0);
+
+    // Authors and publishers repeat, as in a real catalogue.
+    int authorCount = std::max(1, volumes.resources / 7);
+    int publisherCount = std::max(1, volumes.resources / 125);
+
+    for (int i = 0; i < volumes.resources; i++)
+    {
+        char title[32], author[32], publisher[32], isbn[16], description[48];
+        int titleLength = std::snprintf(title, sizeof(title), "Title %d", i + 1);
+        int authorLength = std::snprintf(author, sizeof(author), "Author %d", pick(1, authorCount));
+        int publisherLength = std::snprintf(publisher, sizeof(publisher), "Publisher %d", pick(1, publisherCount));
+        int isbnLength = std::snprintf(isbn, sizeof(isbn), "978%010d", i + 1);
+        int descriptionLength = std::snprintf(description, sizeof(description), "Generated catalogue entry %d", i + 1);
+
+        // One copy is the norm; a handful of titles are stocked in bulk.
+        int copies = chance(0.7) ? 1 : pick(2, chance(0.9) ? 4 : 12);
+        totalCopies[i] = copies;
+
+        if (!bindText(stmt, 1, title, titleLength) ||
+            !bindText(stmt, 2, author, authorLength) ||
+            !bindText(stmt, 3, publisher, publisherLength) ||
+            sqlite3_bind_int(stmt, 4, pick(1950, today.toCivil().year)) != SQLITE_OK ||
+            !bindText(stmt, 5, isbn, isbnLength) ||
+            sqlite3_bind_int(stmt, 6, categoryIds[pick(0, static_cast<int>(categoryIds.size()) - 1)]) != SQLITE_OK ||
+            sqlite3_bind_int(stmt, 7, copies) != SQLITE_OK ||
+            sqlite3_bind_int(stmt, 8, copies) != SQLITE_OK ||
+            !bindText(stmt, 9, description, descriptionLength) ||
+            !bindDate(stmt, 10, today.addDays(-pick(0, volumes.historyDays * 2))) ||
+            sqlite3_bind_int(stmt, 11, chance(0.98) ? 1 : 0) != SQLITE_OK ||
+            !stepAndReset(db, stmt, "resources"))
+            return false;
+
+        resourceIds.push_back(static_cast<int>(sqlite3_last_insert_rowid(db)));
+        summary.resources++;
+        if (!rowWritten())
+            return false;
+    }
+    return true;
+}
+
+/* *************************************************************************
+                      ---------- CIRCULATION ----------
+   *************************************************************************  */
+
+bool DataSeeder::seedCirculation()
+{
+    CachedStatement transactionStmt(statements,
+                                    "INSERT INTO transactions "
+                                    "(user_id, resource_id, issue_date, due_date, return_date, fine_amount, "
+                                    "is_returned, is_overdue, renewal_count, transaction_status) "
+                                    "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?);");
+    CachedStatement fineStmt(statements,
+                             "INSERT INTO fines "
+                             "(transaction_id, user_id, days_overdue, fine_amount, fine_date, is_paid, payment_date) "
+                             "VALUES (?, ?, ?, ?, ?, ?, ?);");
+    CachedStatement historyStmt(statements,
+                                "INSERT INTO borrowing_history "
+                                "(user_id, resource_id, issue_date, due_date, return_date, fine_amount) "
+                                "VALUES (?, ?, ?, ?, ?, ?);");
+    if (!prepared(db, transactionStmt) || !prepared(db, fineStmt) || !prepared(db, historyStmt))
+        return false;
+
+    // Borrowing follows a Zipf curve over a shuffled ranking, so the popular
+    // titles are spread across the id range rather than clustered at the start.
+    std::vector<int> rankOf(resourceIds.size());
+    for (size_t i = 0; i < rankOf.size(); i++)
+        rankOf[i] = static_cast<int>(i) + 1;
+    std::shuffle(rankOf.begin(), rankOf.end(), random);
+
+    std::vector<double> weights(resourceIds.size());
+    for (size_t i = 0; i < weights.size(); i++)
+        weights[i] = 1.0 / std::pow(rankOf[i], volumes.popularitySkew);
+    std::discrete_distribution<int> popularResource(weights.begin(), weights.end());
+
+    // processBorrowRequest issues every loan for 14 days regardless of tier.
+    const int borrowDays = 14;
+    const int lastUser = static_cast<int>(userIds.size()) - 1;
+    const int lastResource = static_cast<int>(resourceIds.size()) - 1;
+
+    for (int i = 0; i < volumes.transactions; i++)
+    {
+        int userId = userIds[pick(0, lastUser)];
+        int resourceIndex = popularResource(random);
+        double roll = std::uniform_real_distribution<double>(0.0, 1.0)(random);
+
+        // A loan on a title with every copy out goes to another title instead,
+        // otherwise the top of the curve would turn most loans into requests.
+        bool isLoan = roll >= volumes.returnedShare && roll < volumes.returnedShare + volumes.issuedShare;
+        for (int attempt = 0; isLoan && copiesOut[resourceIndex] >= totalCopies[resourceIndex] && attempt < 8; attempt++)
+            resourceIndex = pick(0, lastResource);
+        int resourceId = resourceIds[resourceIndex];
+
+        const char *status;
+        CivilDate issued, due, returned;
+        bool hasDates = true, isReturned = false, isOverdue = false, isPaid = false;
+        int daysLate = 0;
+
+        if (roll < volumes.returnedShare)
+        {
+            status = "RETURNED";
+            isReturned = true;
+            issued = today.addDays(-pick(borrowDays + 1, std::max(borrowDays + 1, volumes.historyDays)));
+            due = issued.addDays(borrowDays);
+            returned = chance(volumes.lateReturnShare) ? due.addDays(pick(1, 30)) : issued.addDays(pick(1, borrowDays));
+            if (returned > today)
+                returned = today;
+            daysLate = std::max(0, returned - due);
+            isOverdue = daysLate > 0;
+            isPaid = chance(0.85);
+        }
+        else if (isLoan && copiesOut[resourceIndex] < totalCopies[resourceIndex])
+        {
+            status = "ISSUED";
+            copiesOut[resourceIndex]++;
+            issued = chance(volumes.overdueShare) ? today.addDays(-pick(borrowDays + 1, borrowDays + 90))
+                                                  : today.addDays(-pick(0, borrowDays - 1));
+            due = issued.addDays(borrowDays);
+            daysLate = std::max(0, today - due);
+            isOverdue = daysLate > 0;
+        }
+        else
+        {
+            // Requests have no dates until an admin approves them.
+            status = chance(2.0 / 3.0) ? "PENDING" : "REJECTED";
+            hasDates = false;
+        }
+
+        double fineAmount = daysLate * finePerDay;
+
+        if (sqlite3_bind_int(transactionStmt, 1, userId) != SQLITE_OK ||
+            sqlite3_bind_int(transactionStmt, 2, resourceId) != SQLITE_OK ||
+            !(hasDates ? bindDate(transactionStmt, 3, issued) : bindText(transactionStmt, 3, "", 0)) ||
+            !(hasDates ? bindDate(transactionStmt, 4, due) : bindText(transactionStmt, 4, "", 0)) ||
+            !(isReturned ? bindDate(transactionStmt, 5, returned) : bindText(transactionStmt, 5, "", 0)) ||
+            sqlite3_bind_double(transactionStmt, 6, fineAmount) != SQLITE_OK ||
+            sqlite3_bind_int(transactionStmt, 7, isReturned ? 1 : 0) != SQLITE_OK ||
+            sqlite3_bind_int(transactionStmt, 8, isOverdue ? 1 : 0) != SQLITE_OK ||
+            sqlite3_bind_int(transactionStmt, 9, hasDates && chance(0.1) ? 1 : 0) != SQLITE_OK ||
+            !bindText(transactionStmt, 10, status, -1) ||
+            !stepAndReset(db, transactionStmt, "transactions"))
+            return false;
+
+        int transactionId = static_cast<int>(sqlite3_last_insert_rowid(db));
+        summary.transactions++;
+        if (!rowWritten())
+            return false;
+
+        if (isReturned)
+        {
+            if (sqlite3_bind_int(historyStmt, 1, userId) != SQLITE_OK ||
+                sqlite3_bind_int(historyStmt, 2, resourceId) != SQLITE_OK ||
+                !bindDate(historyStmt, 3, issued) ||
+                !bindDate(historyStmt, 4, due) ||
+                !bindDate(historyStmt, 5, returned) ||
+                sqlite3_bind_double(historyStmt, 6, fineAmount) != SQLITE_OK ||
+                !stepAndReset(db, historyStmt, "borrowing_history"))
+                return false;
+
+            summary.borrowingHistory++;
+            if (!rowWritten())
+                return false;
+        }
+
+        // Late returns carry a settled (mostly) fine; overdue loans an open one.
+        if (daysLate > 0)
+        {
+            CivilDate fineDate = isReturned ? returned : today;
+            CivilDate paidOn = std::min(today, returned.addDays(pick(0, 14)));
+
+            if (sqlite3_bind_int(fineStmt, 1, transactionId) != SQLITE_OK ||
+                sqlite3_bind_int(fineStmt, 2, userId) != SQLITE_OK ||
+                sqlite3_bind_int(fineStmt, 3, daysLate) != SQLITE_OK ||
+                sqlite3_bind_double(fineStmt, 4, fineAmount) != SQLITE_OK ||
+                !bindDate(fineStmt, 5, fineDate) ||
+                sqlite3_bind_int(fineStmt, 6, isPaid ? 1 : 0) != SQLITE_OK ||
+                !(isPaid ? bindDate(fineStmt, 7, paidOn) : bindText(fineStmt, 7, "", 0)) ||
+                !stepAndReset(db, fineStmt, "fines"))
+                return false;
+
+            summary.fines++;
+            if (!rowWritten())
+                return false;
+        }
+    }
+    return true;
+}
+
+// Reservations queue up behind the titles that are currently out.
+bool DataSeeder::seedReservations()
+{
+    CachedStatement stmt(statements,
+                         "INSERT INTO reservations "
+                         "(user_id, resource_id, reservation_date, expiry_date, is_fulfilled, is_cancelled, status) "
+                         "VALUES (?, ?, ?, ?, ?, ?, ?);");
+    if (!prepared(db, stmt))
+        return false;
+
+    std::vector<int> onLoan;
+    for (size_t i = 0; i < copiesOut.size(); i++)
+        if (copiesOut[i] > 0)
+            onLoan.push_back(static_cast<int>(i));
+
+    const int lastUser = static_cast<int>(userIds.size()) - 1;
+    const int lastResource = static_cast<int>(resourceIds.size()) - 1;
+
+    for (int i = 0; i < volumes.reservations; i++)
+    {
+        int resourceIndex = !onLoan.empty() && chance(0.8) ? onLoan[pick(0, static_cast<int>(onLoan.size()) - 1)]
+                                                           : pick(0, lastResource);
+        CivilDate reserved = today.addDays(-pick(0, 60));
+
+        int outcome = pick(0, 99);
+        const char *status = outcome < 60 ? "PENDING" : outcome < 85 ? "FULFILLED"
+                                                                      : "CANCELLED";
+
+        if (sqlite3_bind_int(stmt, 1, userIds[pick(0, lastUser)]) != SQLITE_OK ||
+            sqlite3_bind_int(stmt, 2, resourceIds[resourceIndex]) != SQLITE_OK ||
+            !bindDate(stmt, 3, reserved) ||
+            !bindDate(stmt, 4, reserved.addDays(7)) ||
+            sqlite3_bind_int(stmt, 5, outcome >= 60 && outcome < 85 ? 1 : 0) != SQLITE_OK ||
+            sqlite3_bind_int(stmt, 6, outcome >= 85 ? 1 : 0) != SQLITE_OK ||
+            !bindText(stmt, 7, status, -1) ||
+            !stepAndReset(db, stmt, "reservations"))
+            return false;
+
+        summary.reservations++;
+        if (!rowWritten())
+            return false;
+    }
+    return true;
+}
+
+// Copy counts are written once at the end; the column is outside the FTS triggers.
+bool DataSeeder::updateAvailableCopies()
+{
+    CachedStatement stmt(statements, "UPDATE resources SET available_copies = ? WHERE resource_id = ?;");
+    if (!prepared(db, stmt))
+        return false;
+
+    for (size_t i = 0; i < copiesOut.size(); i++)
+    {
+        if (copiesOut[i] == 0)
+            continue;
+
+        if (sqlite3_bind_int(stmt, 1, totalCopies[i] - copiesOut[i]) != SQLITE_OK ||
+            sqlite3_bind_int(stmt, 2, resourceIds[i]) != SQLITE_OK ||
+            !stepAndReset(db, stmt, "resources"))
+            return false;
+
+        if (!rowWritten())
+            return false;
+    }
+    return true;
+}
@@ -0,0 +1,97 @@
+#pragma once
+extern "C"
+{
+#include "sqlite3.h"
+}
+#include <random>
+#include <string>
+#include <vector>
+#include "StatementCache.h"
+#include "../../Utility/CivilDate.h"
+
+// How much data to generate and how it is shaped.
+struct SeedVolumes
+{
+    int categories = 12;
+    int membershipTypes = 3;
+    int administrators = 1;
+    int users = 10000;
+    int resources = 10000;
+    int transactions = 10000; // every loan, request and return ever made
+    int reservations = 1000;
+
+    double returnedShare = 0.60;   // closed loans (each also gets a borrowing_history row)
+    double issuedShare = 0.25;     // loans still out; the rest are PENDING / REJECTED requests
+    double overdueShare = 0.20;    // of the loans still out, how many are past their due date
+    double lateReturnShare = 0.15; // of the closed loans, how many came back late with a fine
+    double popularitySkew = 1.0;   // Zipf exponent: how strongly borrowing favours the top titles
+
+    int historyDays = 730; // how far back closed loans reach
+    int batchSize = 50000; // rows per COMMIT
+};
+
+// Row counts written per table, plus wall time.
+struct SeedSummary
+{
+    long long categories = 0;
+    long long membershipTypes = 0;
+    long long administrators = 0;
+    long long users = 0;
+    long long resources = 0;
+    long long transactions = 0;
+    long long fines = 0;
+    long long borrowingHistory = 0;
+    long long reservations = 0;
+    double elapsedMs = 0.0;
+
+    long long totalRows() const;
+};
+
+// Bulk loader for empty databases (benchmarks, load tests, demo data).
+// Writes go straight through prepared INSERTs, each bound and re-stepped for
+// every row and committed every batchSize rows, instead of going through the
+// repositories' one-object-at-a-time save(). The same seed always produces
+// the same database.
+class DataSeeder
+{
+private:
+    sqlite3 *db;
+    StatementCache &statements;
+    std::mt19937 random;
+    CivilDate today;
+
+    SeedVolumes volumes;
+    SeedSummary summary;
+    int rowsInBatch;
+
+    std::vector<int> membershipIds;
+    std::vector<int> categoryIds;
+    std::vector<int> userIds;
+    std::vector<int> resourceIds;
+    std::vector<int> copiesOut; // per resource index: loans currently ISSUED
+    std::vector<int> totalCopies;
+
+    int pick(int low, int high);
+    bool chance(double probability);
+
+    // Counts a written row and commits/reopens the transaction at batchSize.
+    bool rowWritten();
+
+    bool seedMembershipTypes();
+    bool seedCategories();
+    bool seedAdministrators();
+    bool seedUsers();
+    bool seedResources();
+    bool insertResources();
+    bool seedCirculation(); // transactions, fines and borrowing history together
+    bool seedReservations();
+    bool updateAvailableCopies();
+
+public:
+    DataSeeder(sqlite3 *connection, StatementCache &statementCache, unsigned seed, const CivilDate &seedToday);
+
+    // Refuses to run if the users or resources table already has rows.
+    bool seed(const SeedVolumes &seedVolumes);
+
+    const SeedSummary &getSummary() const { return summary; }
+};
@@ -5,8 +5,8 @@
                      ---------- CONSTRUCTOR ----------
    *************************************************************************  */
 
-DatabaseInitializer::DatabaseInitializer(const std::string &filename)
-    : db(nullptr), dbFile(filename)
+DatabaseInitializer::DatabaseInitializer(const std::string &filename, const ConnectionProfile &connectionProfile)
+    : db(nullptr), dbFile(filename), profile(connectionProfile), lastMaintenance(std::chrono::steady_clock::now())
 {
 
     int result = sqlite3_open(filename.c_str(), &db);
@@ -17,6 +17,7 @@ DatabaseInitializer::DatabaseInitializer(const std::string &filename)
         throw std::runtime_error("Failed to open database: " + errorMsg);
     }
     sqlite3_exec(db, "PRAGMA foreign_keys = ON;", nullptr, nullptr, nullptr);
+    applyProfile();
 }
 
 /* *************************************************************************
@@ -25,8 +26,12 @@ DatabaseInitializer::DatabaseInitializer(const std::string &filename)
 
 DatabaseInitializer::~DatabaseInitializer()
 {
+    // Cached statements must be finalized before the connection can close.
+    statementCache.reset();
     if (db)
     {
+        // Lets SQLite persist any statistics it gathered during the session.
+        sqlite3_exec(db, "PRAGMA optimize;", nullptr, nullptr, nullptr);
         sqlite3_close(db);
         db = nullptr;
     }
@@ -38,15 +43,88 @@ DatabaseInitializer::~DatabaseInitializer()
 
 bool DatabaseInitializer::open()
 {
+    // The constructor already opened a handle; release it instead of leaking it.
+    statementCache.reset();
+    if (db)
+    {
+        sqlite3_close(db);
+        db = nullptr;
+    }
+
     if (sqlite3_open(dbFile.c_str(), &db) != SQLITE_OK)
     {
         std::cerr << "Cannot open database: " << sqlite3_errmsg(db) << std::endl;
         return false;
     }
     sqlite3_exec(db, "PRAGMA foreign_keys = ON;", nullptr, nullptr, nullptr);
+    return applyProfile();
+}
+
+/* *************************************************************************
+                 ---------- CONNECTION PROFILE ----------
+   *************************************************************************  */
+
+bool DatabaseInitializer::applyProfile()
+{
+    return applyConnectionProfile(db, profile);
+}
+
+std::string DatabaseInitializer::describeActiveSettings()
+{
+    // Each pragma is queried rather than echoed from the profile, because
+    // SQLite may refuse a setting (e.g. WAL on a read-only or network volume).
+    const char *names[] = {"journal_mode", "synchronous", "cache_size", "mmap_size",
+                           "temp_store", "busy_timeout", "foreign_keys", "user_version"};
+
+    std::string settings;
+    for (const char *name : names)
+    {
+        std::string sql = std::string("PRAGMA ") + name + ";";
+        sqlite3_stmt *stmt = nullptr;
+        std::string value = "?";
+
+        if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) == SQLITE_OK &&
+            sqlite3_step(stmt) == SQLITE_ROW)
+        {
+            const unsigned char *text = sqlite3_column_text(stmt, 0);
+            value = text ? reinterpret_cast<const char *>(text) : "";
+        }
+        sqlite3_finalize(stmt);
+
+        if (!settings.empty())
+            settings += ", ";
+        settings += std::string(name) + "=" + value;
+    }
+    return settings;
+}
+
+/* *************************************************************************
+                       ---------- MAINTENANCE ----------
+   *************************************************************************  */
+
+bool DatabaseInitializer::runMaintenance()
+{
+    lastMaintenance = std::chrono::steady_clock::now();
+
+    // PASSIVE never blocks readers or writers; it copies what it can now.
+    char *errMsg = nullptr;
+    if (sqlite3_exec(db, "PRAGMA wal_checkpoint(PASSIVE); PRAGMA optimize;", nullptr, nullptr, &errMsg) != SQLITE_OK)
+    {
+        std::cerr << "Database maintenance failed: " << (errMsg ? errMsg : "Unknown error") << std::endl;
+        sqlite3_free(errMsg);
+        return false;
+    }
     return true;
 }
 
+bool DatabaseInitializer::runMaintenanceIfDue()
+{
+    auto elapsed = std::chrono::steady_clock::now() - lastMaintenance;
+    if (elapsed < std::chrono::seconds(profile.maintenanceIntervalSeconds))
+        return true;
+    return runMaintenance();
+}
+
 /* *************************************************************************
                   ---------- CONNECTING THE DATABASE ----------
    *************************************************************************  */
@@ -57,6 +135,14 @@ sqlite3 *DatabaseInitializer::getConnection()
     return db;
 }
 
+// Created on first use so it always belongs to the handle open() produced.
+StatementCache &DatabaseInitializer::getStatementCache()
+{
+    if (!statementCache)
+        statementCache = std::make_unique<StatementCache>(db);
+    return *statementCache;
+}
+
 /* *************************************************************************
                          ---------- TABLES ----------
    *************************************************************************  */
@@ -247,4 +333,229 @@ bool DatabaseInitializer::createTables()
     }
 
     return true;
-}
\ No newline at end of file
+}
+
+/* *************************************************************************
+                       ---------- MIGRATIONS ----------
+   *************************************************************************  */
+
+// Every schema change after the base tables is appended here with the next
+// version number. A database file records the last version it received in
+// PRAGMA user_version, so each step runs exactly once per file.
+namespace
+{
+    struct Migration
+    {
+        int version;
+        const char *description;
+        const char *sql;
+    };
+
+// Day number (days since 1970-01-01, the same count CivilDate uses) of a
+// stored date column. Accepts the padded and the older unpadded "YYYY-M-D"
+// text; anything that is not a date gives NULL.
+#define DAY_NUMBER(column)                                                   \
+    "CAST(julianday(printf('%04d-%02d-%02d', "                               \
+    "CAST(substr(" column ", 1, 4) AS INTEGER), "                            \
+    "CAST(substr(" column ", 6, instr(substr(" column ", 6), '-') - 1) AS INTEGER), " \
+    "CAST(substr(" column ", instr(substr(" column ", 6), '-') + 6) AS INTEGER)"      \
+    ")) - 2440587.5 AS INTEGER)"
+
+    const Migration migrations[] =
+        {
+            {1, "secondary indexes for lookup and status queries",
+             // getByUserId / pending and issued lists per user
+             "CREATE INDEX IF NOT EXISTS idx_transactions_user_status "
+             "ON transactions(user_id, transaction_status);"
+             // getActiveIssues, getbyStatus and the overdue scan
+             "CREATE INDEX IF NOT EXISTS idx_transactions_status_returned_due "
+             "ON transactions(transaction_status, is_returned, due_date);"
+             // getByUserId and the fine upsert lookup
+             "CREATE INDEX IF NOT EXISTS idx_fines_user_transaction "
+             "ON fines(user_id, transaction_id);"
+             // history per user and the open-record lookup on return
+             "CREATE INDEX IF NOT EXISTS idx_borrowing_history_user_resource_return "
+             "ON borrowing_history(user_id, resource_id, return_date);"
+             // queue of reservations per resource
+             "CREATE INDEX IF NOT EXISTS idx_reservations_resource_status "
+             "ON reservations(resource_id, status);"},
+            {2, "full-text catalogue index",
+             // External-content FTS5 index over the searchable resource columns.
+             // prefix='2 3' keeps short prefix queries ("har*") on the index.
+             "CREATE VIRTUAL TABLE IF NOT EXISTS resources_fts USING fts5("
+             "title, author, publisher, isbn, description,"
+             "content='resources', content_rowid='resource_id',"
+             "tokenize='unicode61 remove_diacritics 2', prefix='2 3');"
+             // Triggers keep the index in step with every write to resources,
+             // including ResourceRepository::save. Copy-count updates skip it.
+             "CREATE TRIGGER IF NOT EXISTS resources_fts_ai AFTER INSERT ON resources BEGIN "
+             "INSERT INTO resources_fts(rowid, title, author, publisher, isbn, description) "
+             "VALUES (new.resource_id, new.title, new.author, new.publisher, new.isbn, new.description); "
+             "END;"
+             "CREATE TRIGGER IF NOT EXISTS resources_fts_ad AFTER DELETE ON resources BEGIN "
+             "INSERT INTO resources_fts(resources_fts, rowid, title, author, publisher, isbn, description) "
+             "VALUES ('delete', old.resource_id, old.title, old.author, old.publisher, old.isbn, old.description); "
+             "END;"
+             "CREATE TRIGGER IF NOT EXISTS resources_fts_au "
+             "AFTER UPDATE OF title, author, publisher, isbn, description ON resources BEGIN "
+             "INSERT INTO resources_fts(resources_fts, rowid, title, author, publisher, isbn, description) "
+             "VALUES ('delete', old.resource_id, old.title, old.author, old.publisher, old.isbn, old.description); "
+             "INSERT INTO resources_fts(rowid, title, author, publisher, isbn, description) "
+             "VALUES (new.resource_id, new.title, new.author, new.publisher, new.isbn, new.description); "
+             "END;"
+             // Index the rows that existed before this migration.
+             "INSERT INTO resources_fts(resources_fts) VALUES ('rebuild');"},
+            {3, "per-user circulation summary",
+             // One row per user with open loans, open requests or unpaid
+             // fines, so borrow and deletion eligibility is a primary-key read.
+             "CREATE TABLE IF NOT EXISTS user_circulation ("
+             "user_id INTEGER PRIMARY KEY,"
+             "active_borrows INTEGER NOT NULL DEFAULT 0,"
+             "pending_requests INTEGER NOT NULL DEFAULT 0,"
+             "unpaid_fine_count INTEGER NOT NULL DEFAULT 0,"
+             "unpaid_fine_total REAL NOT NULL DEFAULT 0.0,"
+             "FOREIGN KEY(user_id) REFERENCES users(user_id) ON DELETE CASCADE);"
+             // Each trigger takes the old row's share off and adds the new
+             // row's share in the same statement as the write, whichever
+             // service or tool makes it. A loan counts while it is not
+             // returned and ISSUED (active) or PENDING (request).
+             "CREATE TRIGGER IF NOT EXISTS user_circulation_txn_ai "
+             "AFTER INSERT ON transactions WHEN new.user_id IS NOT NULL BEGIN "
+             "INSERT OR IGNORE INTO user_circulation(user_id) VALUES (new.user_id); "
+             "UPDATE user_circulation SET "
+             "active_borrows = active_borrows + (new.is_returned = 0 AND new.transaction_status = 'ISSUED'), "
+             "pending_requests = pending_requests + (new.is_returned = 0 AND new.transaction_status = 'PENDING') "
+             "WHERE user_id = new.user_id; "
+             "END;"
+             "CREATE TRIGGER IF NOT EXISTS user_circulation_txn_ad "
+             "AFTER DELETE ON transactions WHEN old.user_id IS NOT NULL BEGIN "
+             "UPDATE user_circulation SET "
+             "active_borrows = active_borrows - (old.is_returned = 0 AND old.transaction_status = 'ISSUED'), "
+             "pending_requests = pending_requests - (old.is_returned = 0 AND old.transaction_status = 'PENDING') "
+             "WHERE user_id = old.user_id; "
+             "END;"
+             "CREATE TRIGGER IF NOT EXISTS user_circulation_txn_au "
+             "AFTER UPDATE OF user_id, is_returned, transaction_status ON transactions BEGIN "
+             "UPDATE user_circulation SET "
+             "active_borrows = active_borrows - (old.is_returned = 0 AND old.transaction_status = 'ISSUED'), "
+             "pending_requests = pending_requests - (old.is_returned = 0 AND old.transaction_status = 'PENDING') "
+             "WHERE user_id = old.user_id; "
+             "INSERT OR IGNORE INTO user_circulation(user_id) SELECT new.user_id WHERE new.user_id IS NOT NULL; "
+             "UPDATE user_circulation SET "
+             "active_borrows = active_borrows + (new.is_returned = 0 AND new.transaction_status = 'ISSUED'), "
+             "pending_requests = pending_requests + (new.is_returned = 0 AND new.transaction_status = 'PENDING') "
+             "WHERE user_id = new.user_id; "
+             "END;"
+             "CREATE TRIGGER IF NOT EXISTS user_circulation_fine_ai "
+             "AFTER INSERT ON fines WHEN new.is_paid = 0 BEGIN "
+             "INSERT OR IGNORE INTO user_circulation(user_id) VALUES (new.user_id); "
+             "UPDATE user_circulation SET "
+             "unpaid_fine_count = unpaid_fine_count + 1, "
+             "unpaid_fine_total = unpaid_fine_total + new.fine_amount "
+             "WHERE user_id = new.user_id; "
+             "END;"
+             "CREATE TRIGGER IF NOT EXISTS user_circulation_fine_ad "
+             "AFTER DELETE ON fines WHEN old.is_paid = 0 BEGIN "
+             "UPDATE user_circulation SET "
+             "unpaid_fine_count = unpaid_fine_count - 1, "
+             "unpaid_fine_total = unpaid_fine_total - old.fine_amount "
+             "WHERE user_id = old.user_id; "
+             "END;"
+             "CREATE TRIGGER IF NOT EXISTS user_circulation_fine_au "
+             "AFTER UPDATE OF user_id, fine_amount, is_paid ON fines BEGIN "
+             "UPDATE user_circulation SET "
+             "unpaid_fine_count = unpaid_fine_count - (old.is_paid = 0), "
+             "unpaid_fine_total = unpaid_fine_total - (CASE WHEN old.is_paid = 0 THEN old.fine_amount ELSE 0 END) "
+             "WHERE user_id = old.user_id; "
+             "INSERT OR IGNORE INTO user_circulation(user_id) SELECT new.user_id WHERE new.is_paid = 0; "
+             "UPDATE user_circulation SET "
+             "unpaid_fine_count = unpaid_fine_count + (new.is_paid = 0), "
+             "unpaid_fine_total = unpaid_fine_total + (CASE WHEN new.is_paid = 0 THEN new.fine_amount ELSE 0 END) "
+             "WHERE user_id = new.user_id; "
+             "END;"
+             // Summarise the rows that existed before this migration.
+             "INSERT OR REPLACE INTO user_circulation"
+             "(user_id, active_borrows, pending_requests, unpaid_fine_count, unpaid_fine_total) "
+             "SELECT user_id, SUM(active), SUM(pending), SUM(unpaid), SUM(owed) FROM ("
+             "SELECT user_id, (is_returned = 0 AND transaction_status = 'ISSUED') AS active, "
+             "(is_returned = 0 AND transaction_status = 'PENDING') AS pending, 0 AS unpaid, 0.0 AS owed "
+             "FROM transactions WHERE user_id IN (SELECT user_id FROM users) "
+             "UNION ALL "
+             "SELECT user_id, 0, 0, 1, fine_amount FROM fines "
+             "WHERE is_paid = 0 AND user_id IN (SELECT user_id FROM users)"
+             ") GROUP BY user_id;"},
+            {4, "integer day numbers for date range queries",
+             // Virtual generated columns: computed from the text date on every
+             // read and write, so no code path can let them drift, and the
+             // indexes below store them for the rows that already exist.
+             "ALTER TABLE transactions ADD COLUMN issue_day INTEGER "
+             "GENERATED ALWAYS AS (" DAY_NUMBER("issue_date") ") VIRTUAL;"
+             "ALTER TABLE transactions ADD COLUMN due_day INTEGER "
+             "GENERATED ALWAYS AS (" DAY_NUMBER("due_date") ") VIRTUAL;"
+             "ALTER TABLE transactions ADD COLUMN return_day INTEGER "
+             "GENERATED ALWAYS AS (" DAY_NUMBER("return_date") ") VIRTUAL;"
+             "ALTER TABLE reservations ADD COLUMN reservation_day INTEGER "
+             "GENERATED ALWAYS AS (" DAY_NUMBER("reservation_date") ") VIRTUAL;"
+             "ALTER TABLE reservations ADD COLUMN expiry_day INTEGER "
+             "GENERATED ALWAYS AS (" DAY_NUMBER("expiry_date") ") VIRTUAL;"
+             // The text due_date in the version 1 index sorts "2024-10-1"
+             // before "2024-9-30", so it could only serve equality.
+             "DROP INDEX IF EXISTS idx_transactions_status_returned_due;"
+             // getActiveIssues, getOverdueIssues and getIssuesDueBetween
+             "CREATE INDEX IF NOT EXISTS idx_transactions_status_returned_due_day "
+             "ON transactions(transaction_status, is_returned, due_day);"
+             // getIssuedBetween
+             "CREATE INDEX IF NOT EXISTS idx_transactions_issue_day "
+             "ON transactions(issue_day);"
+             // getExpiredBefore and getExpiringBetween
+             "CREATE INDEX IF NOT EXISTS idx_reservations_status_expiry_day "
+             "ON reservations(status, expiry_day);"},
+            // users.username and administrators.username are already UNIQUE,
+            // so getByUsername is served by SQLite's automatic index.
+    };
+}
+
+#undef DAY_NUMBER
+
+int DatabaseInitializer::getSchemaVersion()
+{
+    int version = 0;
+    sqlite3_stmt *stmt = nullptr;
+
+    if (sqlite3_prepare_v2(db, "PRAGMA user_version;", -1, &stmt, nullptr) == SQLITE_OK &&
+        sqlite3_step(stmt) == SQLITE_ROW)
+    {
+        version = sqlite3_column_int(stmt, 0);
+    }
+    sqlite3_finalize(stmt);
+    return version;
+}
+
+bool DatabaseInitializer::runMigrations()
+{
+    int current = getSchemaVersion();
+    char *errMsg = nullptr;
+
+    for (const Migration &migration : migrations)
+    {
+        if (migration.version <= current)
+            continue;
+
+        // The schema change and the version bump commit together, so an
+        // interrupted run is retried from the same step next boot.
+        std::string script = std::string("BEGIN;") + migration.sql +
+                             "PRAGMA user_version = " + std::to_string(migration.version) + ";COMMIT;";
+
+        if (sqlite3_exec(db, script.c_str(), nullptr, nullptr, &errMsg) != SQLITE_OK)
+        {
+            std::cerr << "Migration " << migration.version << " (" << migration.description
+                      << ") failed: " << (errMsg ? errMsg : "Unknown error") << std::endl;
+            sqlite3_free(errMsg);
+            sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+            return false;
+        }
+        current = migration.version;
+    }
+
+    return true;
+}
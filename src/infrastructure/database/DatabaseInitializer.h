@@ -4,6 +4,10 @@ extern "C"
 #include "sqlite3.h"
 }
 #include <string>
+#include <memory>
+#include <chrono>
+#include "StatementCache.h"
+#include "ConnectionProfile.h"
 
 class DatabaseInitializer
 {
@@ -11,9 +15,17 @@ private:
     sqlite3 *db;        // -> points to the database connection.
     std::string dbFile; // -> stores file name.
 
+    std::unique_ptr<StatementCache> statementCache; // -> prepared statements shared by all repositories.
+
+    ConnectionProfile profile;                               // -> pragmas applied on open.
+    std::chrono::steady_clock::time_point lastMaintenance; // -> when checkpoint/optimize last ran.
+
+    // Applies the connection profile to the current handle.
+    bool applyProfile();
+
 public:
     // Constructor.
-    explicit DatabaseInitializer(const std::string &filename);
+    explicit DatabaseInitializer(const std::string &filename, const ConnectionProfile &connectionProfile = ConnectionProfile());
 
     // Destructor.
     ~DatabaseInitializer();
@@ -24,6 +36,23 @@ public:
     // Creates tables if they don’t exist.
     bool createTables();
 
+    // Applies schema migrations newer than PRAGMA user_version, in order.
+    bool runMigrations();
+
+    // Returns the schema version currently recorded in the database file.
+    int getSchemaVersion();
+
     // Returns database pointer so repositories can use it.
     sqlite3 *getConnection();
+
+    // Checkpoints the WAL and refreshes planner statistics. The "IfDue" form
+    // only runs once the profile's maintenance interval has elapsed.
+    bool runMaintenance();
+    bool runMaintenanceIfDue();
+
+    // Reads the pragmas back from SQLite so operators can verify what is active.
+    std::string describeActiveSettings();
+
+    // Returns the prepared-statement cache tied to the current connection.
+    StatementCache &getStatementCache();
 };
\ No newline at end of file
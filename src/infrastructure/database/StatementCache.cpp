@@ -0,0 +1,73 @@
+#include "StatementCache.h"
+
+/* *************************************************************************
+                 ---------- CONSTRUCTORS & DESTRUCTORS ----------
+   *************************************************************************  */
+
+StatementCache::StatementCache(sqlite3 *connection)
+    : db(connection), hits(0), misses(0) {}
+
+StatementCache::~StatementCache()
+{
+    clear();
+}
+
+/* *************************************************************************
+                    ---------- ACQUIRE STATEMENTS ----------
+   *************************************************************************  */
+
+sqlite3_stmt *StatementCache::acquire(const char *sql)
+{
+    auto found = entries.find(std::string_view(sql));
+    if (found != entries.end() && !found->second.inUse)
+    {
+        found->second.inUse = true;
+        hits++;
+        return found->second.stmt;
+    }
+
+    misses++;
+
+    sqlite3_stmt *stmt = nullptr;
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    {
+        // The caller reports the failure through sqlite3_errmsg.
+        sqlite3_finalize(stmt);
+        return nullptr;
+    }
+
+    // Only the first copy of a query is kept; nested copies are one-off.
+    if (found == entries.end())
+        entries.emplace(std::string_view(sqlite3_sql(stmt)), Entry{stmt, true});
+
+    return stmt;
+}
+
+/* *************************************************************************
+                    ---------- RELEASE STATEMENTS ----------
+   *************************************************************************  */
+
+void StatementCache::release(sqlite3_stmt *stmt)
+{
+    auto found = entries.find(std::string_view(sqlite3_sql(stmt)));
+    if (found != entries.end() && found->second.stmt == stmt)
+    {
+        sqlite3_reset(stmt);
+        sqlite3_clear_bindings(stmt);
+        found->second.inUse = false;
+        return;
+    }
+
+    sqlite3_finalize(stmt);
+}
+
+/* *************************************************************************
+                     ---------- CLEAR THE CACHE ----------
+   *************************************************************************  */
+
+void StatementCache::clear()
+{
+    for (auto &entry : entries)
+        sqlite3_finalize(entry.second.stmt);
+    entries.clear();
+}
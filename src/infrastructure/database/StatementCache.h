@@ -0,0 +1,80 @@
+#pragma once
+extern "C"
+{
+#include "sqlite3.h"
+}
+#include <string_view>
+#include <unordered_map>
+#include <cstddef>
+
+// Connection-scoped cache of prepared statements, keyed by SQL text.
+// Repositories ask for a statement instead of calling sqlite3_prepare_v2 and
+// sqlite3_finalize themselves, so each query is parsed once per connection.
+class StatementCache
+{
+private:
+    struct Entry
+    {
+        sqlite3_stmt *stmt;
+        bool inUse;
+    };
+
+    sqlite3 *db; // -> connection every cached statement belongs to.
+
+    // Keys view the SQL text stored inside each statement (sqlite3_sql),
+    // so lookups never allocate.
+    std::unordered_map<std::string_view, Entry> entries;
+
+    std::size_t hits;
+    std::size_t misses;
+
+public:
+    explicit StatementCache(sqlite3 *connection);
+    ~StatementCache();
+
+    StatementCache(const StatementCache &) = delete;
+    StatementCache &operator=(const StatementCache &) = delete;
+
+    // Returns a ready-to-bind statement, or nullptr if the SQL does not compile.
+    // If the cached copy is already handed out (nested use of the same query)
+    // a private statement is prepared instead and finalized on release.
+    sqlite3_stmt *acquire(const char *sql);
+
+    // Resets the statement and clears its bindings so the next caller starts clean.
+    void release(sqlite3_stmt *stmt);
+
+    // Finalizes every cached statement. Must run before the connection closes.
+    void clear();
+
+    sqlite3 *getConnection() const { return db; }
+    std::size_t getHits() const { return hits; }
+    std::size_t getMisses() const { return misses; }
+    std::size_t getSize() const { return entries.size(); }
+};
+
+// RAII handle used inside repository methods:
+//     CachedStatement stmt(statements, sql);
+//     if (!stmt) { ...prepare failed... }
+// It converts to sqlite3_stmt* so the usual sqlite3_bind_* / sqlite3_column_*
+// calls work unchanged, and it hands the statement back on scope exit.
+class CachedStatement
+{
+private:
+    StatementCache &cache;
+    sqlite3_stmt *stmt;
+
+public:
+    CachedStatement(StatementCache &statementCache, const char *sql)
+        : cache(statementCache), stmt(statementCache.acquire(sql)) {}
+
+    ~CachedStatement()
+    {
+        if (stmt)
+            cache.release(stmt);
+    }
+
+    CachedStatement(const CachedStatement &) = delete;
+    CachedStatement &operator=(const CachedStatement &) = delete;
+
+    operator sqlite3_stmt *() const { return stmt; }
+};
@@ -3,18 +3,21 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <functional>
+#include "../database/StatementCache.h"
 #include "../../domain/Administrator.h"
 
 class AdministratorRepository
 {
 private:
     sqlite3 *db;
+    StatementCache &statements;
 
     bool insertAdministrator(Administrator &admin);
     bool updateAdministrator(const Administrator &admin);
 
 public:
-    explicit AdministratorRepository(sqlite3 *connection);
+    explicit AdministratorRepository(sqlite3 *connection, StatementCache &statementCache);
     ~AdministratorRepository();
 
     bool save(Administrator &admin);
@@ -23,4 +26,5 @@ public:
     std::unique_ptr<Administrator> getById(int adminId);
     std::unique_ptr<Administrator> getByUsername(const std::string &username);
     std::vector<Administrator> getAllAdministrators();
+    bool forEachAdministrator(const std::function<void(const Administrator &)> &visit);
 };
\ No newline at end of file
@@ -7,7 +7,8 @@ using namespace std;
                  ---------- CONSTRUCTORS & DESTRUCTORS ----------
    *************************************************************************  */
 
-AdministratorRepository::AdministratorRepository(sqlite3 *connection) : db(connection) {}
+AdministratorRepository::AdministratorRepository(sqlite3 *connection, StatementCache &statementCache)
+    : db(connection), statements(statementCache) {}
 AdministratorRepository::~AdministratorRepository() {}
 
 /* *************************************************************************
@@ -22,9 +23,9 @@ bool AdministratorRepository::insertAdministrator(Administrator &admin)
         "(username, password, first_name, last_name, email, created_date, is_active) "
         "VALUES (?, ?, ?, ?, ?, ?, ?);";
 
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, sql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
     {
         cerr << "Failed to prepare INSERT statement: "
              << sqlite3_errmsg(db) << endl;
@@ -42,7 +43,6 @@ bool AdministratorRepository::insertAdministrator(Administrator &admin)
 
         cerr << "Failed to bind parameters for INSERT: "
              << sqlite3_errmsg(db) << endl;
-        sqlite3_finalize(stmt);
         return false;
     }
 
@@ -60,7 +60,6 @@ bool AdministratorRepository::insertAdministrator(Administrator &admin)
         admin.setAdminId(static_cast<int>(lastId));
     }
 
-    sqlite3_finalize(stmt);
     return success;
 }
 
@@ -77,9 +76,9 @@ bool AdministratorRepository::updateAdministrator(const Administrator &admin)
         "email=?, created_date=?, is_active=? "
         "WHERE admin_id=?;";
 
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, sql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
     {
         cerr << "Failed to prepare UPDATE statement: "
              << sqlite3_errmsg(db) << endl;
@@ -98,7 +97,6 @@ bool AdministratorRepository::updateAdministrator(const Administrator &admin)
 
         cerr << "Failed to bind parameters for UPDATE: "
              << sqlite3_errmsg(db) << endl;
-        sqlite3_finalize(stmt);
         return false;
     }
 
@@ -110,7 +108,6 @@ bool AdministratorRepository::updateAdministrator(const Administrator &admin)
              << sqlite3_errmsg(db) << endl;
     }
 
-    sqlite3_finalize(stmt);
     return success;
 }
 
@@ -124,9 +121,9 @@ bool AdministratorRepository::deleteAdministrator(int adminId)
     const char *sql =
         "DELETE FROM administrators WHERE admin_id=?;";
 
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, sql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
     {
         cerr << "Failed to prepare DELETE statement: "
              << sqlite3_errmsg(db) << endl;
@@ -137,7 +134,6 @@ bool AdministratorRepository::deleteAdministrator(int adminId)
     {
         cerr << "Failed to bind adminId for DELETE: "
              << sqlite3_errmsg(db) << endl;
-        sqlite3_finalize(stmt);
         return false;
     }
 
@@ -149,7 +145,6 @@ bool AdministratorRepository::deleteAdministrator(int adminId)
              << sqlite3_errmsg(db) << endl;
     }
 
-    sqlite3_finalize(stmt);
     return success;
 }
 
@@ -165,9 +160,9 @@ std::unique_ptr<Administrator> AdministratorRepository::getById(int adminId)
         "email, created_date, is_active "
         "FROM administrators WHERE admin_id=?;";
 
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, sql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
     {
         cerr << "Failed to prepare SELECT statement: "
              << sqlite3_errmsg(db) << endl;
@@ -178,7 +173,6 @@ std::unique_ptr<Administrator> AdministratorRepository::getById(int adminId)
     {
         cerr << "Failed to bind adminId in SELECT: "
              << sqlite3_errmsg(db) << endl;
-        sqlite3_finalize(stmt);
         return nullptr;
     }
 
@@ -203,7 +197,6 @@ std::unique_ptr<Administrator> AdministratorRepository::getById(int adminId)
             sqlite3_column_int(stmt, 7) == 1);
     }
 
-    sqlite3_finalize(stmt);
     return admin;
 }
 
@@ -219,9 +212,9 @@ std::unique_ptr<Administrator> AdministratorRepository::getByUsername(const std:
         "email, created_date, is_active "
         "FROM administrators WHERE username=?;";
 
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, sql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
     {
         cerr << "Failed to prepare SELECT BY USERNAME: " << sqlite3_errmsg(db) << endl;
         return nullptr;
@@ -230,7 +223,6 @@ std::unique_ptr<Administrator> AdministratorRepository::getByUsername(const std:
     if (sqlite3_bind_text(stmt, 1, username.c_str(), -1, SQLITE_TRANSIENT) != SQLITE_OK)
     {
         cerr << "Failed to bind username: " << sqlite3_errmsg(db) << endl;
-        sqlite3_finalize(stmt);
         return nullptr;
     }
 
@@ -255,7 +247,6 @@ std::unique_ptr<Administrator> AdministratorRepository::getByUsername(const std:
             sqlite3_column_int(stmt, 7) == 1);
     }
 
-    sqlite3_finalize(stmt);
     return admin;
 }
 
@@ -264,22 +255,19 @@ std::unique_ptr<Administrator> AdministratorRepository::getByUsername(const std:
                  ---------- GET ALL ADMINISTRATORS ----------
    *************************************************************************  */
 
-std::vector<Administrator> AdministratorRepository::getAllAdministrators()
+bool AdministratorRepository::forEachAdministrator(const std::function<void(const Administrator &)> &visit)
 {
-
-    std::vector<Administrator> admins;
-
     const char *sql =
         "SELECT admin_id, username, password, first_name, last_name, "
         "email, created_date, is_active FROM administrators;";
 
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, sql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
     {
         cerr << "Failed to prepare SELECT ALL statement: "
              << sqlite3_errmsg(db) << endl;
-        return admins;
+        return false;
     }
 
     auto safeText = [](sqlite3_stmt *stmt, int col) -> string
@@ -288,9 +276,10 @@ std::vector<Administrator> AdministratorRepository::getAllAdministrators()
         return text ? reinterpret_cast<const char *>(text) : "";
     };
 
-    while (sqlite3_step(stmt) == SQLITE_ROW)
+    int rc;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
     {
-        admins.emplace_back(
+        Administrator row(
             sqlite3_column_int(stmt, 0),
             safeText(stmt, 1),
             safeText(stmt, 2),
@@ -299,10 +288,20 @@ std::vector<Administrator> AdministratorRepository::getAllAdministrators()
             safeText(stmt, 5),
             safeText(stmt, 6),
             sqlite3_column_int(stmt, 7) == 1);
+        visit(row);
     }
 
-    sqlite3_finalize(stmt);
-    return admins;
+    return rc == SQLITE_DONE;
+}
+
+std::vector<Administrator> AdministratorRepository::getAllAdministrators()
+{
+    std::vector<Administrator> results;
+    forEachAdministrator([&results](const Administrator &item)
+    {
+        results.push_back(item);
+    });
+    return results;
 }
 
 /* *************************************************************************
@@ -0,0 +1,30 @@
+#pragma once
+extern "C"
+{
+#include "sqlite3.h"
+}
+#include <string_view>
+#include "../../Utility/StringArena.h"
+
+// Text column of the current row as a view into arena, so it outlives the
+// statement step. NULL reads as "".
+inline std::string_view columnText(sqlite3_stmt *stmt, int col)
+{
+    const unsigned char *text = sqlite3_column_text(stmt, col);
+    if (!text)
+        return std::string_view();
+    return std::string_view(reinterpret_cast<const char *>(text), static_cast<std::size_t>(sqlite3_column_bytes(stmt, col)));
+}
+
+// For columns with few distinct values (statuses, authors, names): stored once.
+inline std::string_view internColumn(StringArena &arena, sqlite3_stmt *stmt, int col)
+{
+    return arena.view(arena.intern(columnText(stmt, col)));
+}
+
+// For mostly unique columns (titles, emails, dates): copied as-is. Dates
+// span thousands of days, so the hash lookup costs more than the copy it saves.
+inline std::string_view copyColumn(StringArena &arena, sqlite3_stmt *stmt, int col)
+{
+    return arena.copy(columnText(stmt, col));
+}
@@ -0,0 +1,69 @@
+#include "BatchSave.h"
+#include <iostream>
+
+using namespace std;
+
+bool runBatchSave(sqlite3 *db, size_t rowCount, BatchSaveResult &result,
+                  const function<bool(size_t)> &writeRow)
+{
+    result = BatchSaveResult();
+    result.rowErrors.assign(rowCount, string());
+
+    // A savepoint behaves like BEGIN when no transaction is open and like a
+    // nested transaction when one is.
+    char *errMsg = nullptr;
+    if (sqlite3_exec(db, "SAVEPOINT batch_save;", nullptr, nullptr, &errMsg) != SQLITE_OK)
+    {
+        cerr << "Failed to open batch: " << (errMsg ? errMsg : "Unknown error") << endl;
+        sqlite3_free(errMsg);
+        result.failed = static_cast<int>(rowCount);
+        result.rowErrors.assign(rowCount, "batch not started");
+        return false;
+    }
+
+    for (size_t i = 0; i < rowCount; i++)
+    {
+        if (writeRow(i))
+        {
+            result.saved++;
+            continue;
+        }
+
+        result.rowErrors[i] = sqlite3_errmsg(db);
+        result.failed++;
+
+        // Constraint failures only undo their own statement. Anything that
+        // made SQLite roll the transaction back ends the batch here.
+        if (sqlite3_get_autocommit(db))
+        {
+            cerr << "Batch aborted at row " << i << ": " << result.rowErrors[i] << endl;
+            for (size_t j = 0; j < i; j++)
+            {
+                if (result.rowErrors[j].empty())
+                    result.rowErrors[j] = "rolled back";
+            }
+            for (size_t j = i + 1; j < rowCount; j++)
+                result.rowErrors[j] = "not attempted";
+            result.failed = static_cast<int>(rowCount);
+            result.saved = 0;
+            return false;
+        }
+    }
+
+    if (sqlite3_exec(db, "RELEASE batch_save;", nullptr, nullptr, &errMsg) != SQLITE_OK)
+    {
+        cerr << "Failed to commit batch: " << (errMsg ? errMsg : "Unknown error") << endl;
+        sqlite3_free(errMsg);
+        sqlite3_exec(db, "ROLLBACK TO batch_save; RELEASE batch_save;", nullptr, nullptr, nullptr);
+        for (string &error : result.rowErrors)
+        {
+            if (error.empty())
+                error = "rolled back";
+        }
+        result.failed = static_cast<int>(rowCount);
+        result.saved = 0;
+        return false;
+    }
+
+    return true;
+}
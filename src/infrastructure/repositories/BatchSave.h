@@ -0,0 +1,25 @@
+#pragma once
+#include <sqlite3.h>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Outcome of a repository saveAll() call. rowErrors lines up with the input
+// vector: an empty entry means that row was written (and, for new rows, its
+// generated id was stored back on the object).
+struct BatchSaveResult
+{
+    int saved = 0;
+    int failed = 0;
+    std::vector<std::string> rowErrors;
+};
+
+// Runs writeRow(i) for every row inside one savepoint, so the batch commits
+// once (or joins the caller's transaction if one is already open). A row that
+// fails records SQLite's message and the batch moves on; the batch only stops
+// early if SQLite abandons the whole transaction (disk full, I/O error...).
+// Returns false when nothing could be committed; ids already stored on the
+// objects are then meaningless.
+bool runBatchSave(sqlite3 *db, std::size_t rowCount, BatchSaveResult &result,
+                  const std::function<bool(std::size_t)> &writeRow);
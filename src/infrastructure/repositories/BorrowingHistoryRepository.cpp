@@ -7,34 +7,49 @@ using namespace std;
                  ---------- CONSTRUCTORS & DESTRUCTORS ----------
    *************************************************************************  */
 
-BorrowingHistoryRepository::BorrowingHistoryRepository(sqlite3 *connection) : db(connection) {}
+BorrowingHistoryRepository::BorrowingHistoryRepository(sqlite3 *connection, StatementCache &statementCache)
+    : db(connection), statements(statementCache) {}
 BorrowingHistoryRepository::~BorrowingHistoryRepository() {}
 
+/* *************************************************************************
+              ---------- BIND BORROWING HISTORY COLUMNS ----------
+   *************************************************************************  */
+
+static const char *insertHistorySql =
+    "INSERT INTO borrowing_history (user_id, resource_id, issue_date, due_date, return_date, fine_amount) "
+    "VALUES (?, ?, ?, ?, ?, ?);";
+
+static const char *updateHistorySql =
+    "UPDATE borrowing_history SET user_id=?, resource_id=?, issue_date=?, due_date=?, "
+    "return_date=?, fine_amount=? WHERE history_id=?;";
+
+// Parameters 1-6 are shared by the INSERT and the UPDATE; the UPDATE adds the id as 7.
+// Foreign keys (user_id, resource_id) must exist in their respective tables.
+bool BorrowingHistoryRepository::bindHistory(sqlite3_stmt *stmt, const BorrowingHistory &history)
+{
+    return sqlite3_bind_int(stmt, 1, history.getUserId()) == SQLITE_OK &&
+           sqlite3_bind_int(stmt, 2, history.getResourceId()) == SQLITE_OK &&
+           sqlite3_bind_text(stmt, 3, history.getIssueDate().c_str(), -1, SQLITE_TRANSIENT) == SQLITE_OK &&
+           sqlite3_bind_text(stmt, 4, history.getDueDate().c_str(), -1, SQLITE_TRANSIENT) == SQLITE_OK &&
+           sqlite3_bind_text(stmt, 5, history.getReturnDate().c_str(), -1, SQLITE_TRANSIENT) == SQLITE_OK &&
+           sqlite3_bind_double(stmt, 6, history.getFineAmount()) == SQLITE_OK;
+}
+
 /* *************************************************************************
                 ---------- INSERT BORROWING HISTORY ----------
    *************************************************************************  */
 
 bool BorrowingHistoryRepository::insertHistory(BorrowingHistory &history)
 {
-    const char *sql = "INSERT INTO borrowing_history (user_id, resource_id, issue_date, due_date, return_date, fine_amount) "
-                      "VALUES (?, ?, ?, ?, ?, ?);";
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, insertHistorySql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
     {
         cerr << "Prepare Insert Failed: " << sqlite3_errmsg(db) << endl;
         return false;
     }
 
-    // Binding parameters - Foreign keys (user_id, resource_id) must exist in their respective tables
-    sqlite3_bind_int(stmt, 1, history.getUserId());
-    sqlite3_bind_int(stmt, 2, history.getResourceId());
-    sqlite3_bind_text(stmt, 3, history.getIssueDate().c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(stmt, 4, history.getDueDate().c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(stmt, 5, history.getReturnDate().c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_double(stmt, 6, history.getFineAmount());
-
-    bool success = (sqlite3_step(stmt) == SQLITE_DONE);
+    bool success = bindHistory(stmt, history) && sqlite3_step(stmt) == SQLITE_DONE;
     if (success)
     {
         history.setId(static_cast<int>(sqlite3_last_insert_rowid(db)));
@@ -44,7 +59,6 @@ bool BorrowingHistoryRepository::insertHistory(BorrowingHistory &history)
         cerr << "Execution Failed! Check Foreign Key!" << sqlite3_errmsg(db) << endl;
     }
 
-    sqlite3_finalize(stmt);
     return success;
 }
 
@@ -54,23 +68,14 @@ bool BorrowingHistoryRepository::insertHistory(BorrowingHistory &history)
 
 bool BorrowingHistoryRepository::updateHistory(const BorrowingHistory &history)
 {
-    const char *sql = "UPDATE borrowing_history SET user_id=?, resource_id=?, issue_date=?, due_date=?, "
-                      "return_date=?, fine_amount=? WHERE history_id=?;";
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, updateHistorySql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
         return false;
 
-    sqlite3_bind_int(stmt, 1, history.getUserId());
-    sqlite3_bind_int(stmt, 2, history.getResourceId());
-    sqlite3_bind_text(stmt, 3, history.getIssueDate().c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(stmt, 4, history.getDueDate().c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(stmt, 5, history.getReturnDate().c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_double(stmt, 6, history.getFineAmount());
-    sqlite3_bind_int(stmt, 7, history.getId());
-
-    bool success = (sqlite3_step(stmt) == SQLITE_DONE);
-    sqlite3_finalize(stmt);
+    bool success = bindHistory(stmt, history) &&
+                   sqlite3_bind_int(stmt, 7, history.getId()) == SQLITE_OK &&
+                   sqlite3_step(stmt) == SQLITE_DONE;
     return success;
 }
 
@@ -87,6 +92,33 @@ bool BorrowingHistoryRepository::save(BorrowingHistory &history)
     return updateHistory(history);
 }
 
+bool BorrowingHistoryRepository::saveAll(vector<BorrowingHistory> &histories, BatchSaveResult &result)
+{
+    CachedStatement insertStmt(statements, insertHistorySql);
+    CachedStatement updateStmt(statements, updateHistorySql);
+
+    if (!insertStmt || !updateStmt)
+    {
+        cerr << "Failed to prepare batch save: " << sqlite3_errmsg(db) << endl;
+        return false;
+    }
+
+    return runBatchSave(db, histories.size(), result, [&](size_t i)
+                        {
+                            BorrowingHistory &history = histories[i];
+                            bool isNew = history.getId() == 0;
+                            sqlite3_stmt *stmt = isNew ? insertStmt : updateStmt;
+
+                            bool success = bindHistory(stmt, history) &&
+                                           (isNew || sqlite3_bind_int(stmt, 7, history.getId()) == SQLITE_OK) &&
+                                           sqlite3_step(stmt) == SQLITE_DONE;
+                            sqlite3_reset(stmt);
+
+                            if (success && isNew)
+                                history.setId(static_cast<int>(sqlite3_last_insert_rowid(db)));
+                            return success; });
+}
+
 /* *************************************************************************
                 ---------- DELETE BORROWING HISTORY ----------
    *************************************************************************  */
@@ -94,14 +126,13 @@ bool BorrowingHistoryRepository::save(BorrowingHistory &history)
 bool BorrowingHistoryRepository::deleteHistory(int historyId)
 {
     const char *sql = "DELETE FROM borrowing_history WHERE history_id=?;";
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, sql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
         return false;
     sqlite3_bind_int(stmt, 1, historyId);
 
     bool success = (sqlite3_step(stmt) == SQLITE_DONE);
-    sqlite3_finalize(stmt);
     return success;
 }
 
@@ -113,9 +144,9 @@ unique_ptr<BorrowingHistory> BorrowingHistoryRepository::getById(int historyId)
 {
     const char *sql = "SELECT history_id, user_id, resource_id, issue_date, due_date, return_date, fine_amount "
                       "FROM borrowing_history WHERE history_id=?;";
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, sql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
         return nullptr;
     sqlite3_bind_int(stmt, 1, historyId);
 
@@ -137,7 +168,6 @@ unique_ptr<BorrowingHistory> BorrowingHistoryRepository::getById(int historyId)
         history->setId(sqlite3_column_int(stmt, 0));
     }
 
-    sqlite3_finalize(stmt);
     return history;
 }
 
@@ -145,16 +175,16 @@ unique_ptr<BorrowingHistory> BorrowingHistoryRepository::getById(int historyId)
                 ---------- GET ALL BORROWING HISTORY ----------
    *************************************************************************  */
 
-vector<BorrowingHistory> BorrowingHistoryRepository::getAll()
+bool BorrowingHistoryRepository::forEachHistory(const function<void(const BorrowingHistory &)> &visit)
 {
-    vector<BorrowingHistory> results;
     const char *sql = "SELECT history_id, user_id, resource_id, issue_date, due_date, return_date, fine_amount FROM borrowing_history;";
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, sql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
-        return results;
+    if (!stmt)
+        return false;
 
-    while (sqlite3_step(stmt) == SQLITE_ROW)
+    int rc;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
     {
         const unsigned char *issueText = sqlite3_column_text(stmt, 3);
         const unsigned char *dueText = sqlite3_column_text(stmt, 4);
@@ -168,10 +198,19 @@ vector<BorrowingHistory> BorrowingHistoryRepository::getAll()
             returnText ? reinterpret_cast<const char *>(returnText) : "",
             sqlite3_column_double(stmt, 6));
         bh.setId(sqlite3_column_int(stmt, 0));
-        results.push_back(bh);
+        visit(bh);
     }
 
-    sqlite3_finalize(stmt);
+    return rc == SQLITE_DONE;
+}
+
+vector<BorrowingHistory> BorrowingHistoryRepository::getAll()
+{
+    vector<BorrowingHistory> results;
+    forEachHistory([&results](const BorrowingHistory &item)
+    {
+        results.push_back(item);
+    });
     return results;
 }
 
@@ -187,9 +226,9 @@ vector<BorrowingHistory> BorrowingHistoryRepository::getByUserId(int userId)
         "SELECT history_id, user_id, resource_id, issue_date, due_date, return_date, fine_amount "
         "FROM borrowing_history WHERE user_id=?;";
 
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, sql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
         return results;
 
     sqlite3_bind_int(stmt, 1, userId);
@@ -213,7 +252,61 @@ vector<BorrowingHistory> BorrowingHistoryRepository::getByUserId(int userId)
         results.push_back(bh);
     }
 
-    sqlite3_finalize(stmt);
 
     return results;
-}
\ No newline at end of file
+}
+
+/* *************************************************************************
+             ---------- STREAM HISTORY FOR EVERY USER ----------
+   *************************************************************************  */
+
+bool BorrowingHistoryRepository::forEachUserHistory(const function<void(const UserHistoryRow &)> &visit)
+{
+    const char *sql =
+        "SELECT u.user_id, u.first_name, u.last_name, u.email, "
+        "h.history_id, h.resource_id, r.resource_id, r.title, "
+        "h.issue_date, h.due_date, h.return_date, h.fine_amount "
+        "FROM users u "
+        "LEFT JOIN borrowing_history h ON h.user_id = u.user_id "
+        "LEFT JOIN resources r ON r.resource_id = h.resource_id "
+        "ORDER BY u.user_id, h.history_id;";
+
+    CachedStatement stmt(statements, sql);
+
+    if (!stmt)
+    {
+        cerr << "Prepare History Report Failed: " << sqlite3_errmsg(db) << endl;
+        return false;
+    }
+
+    // Views straight into the current row; no string is built per column.
+    auto textView = [](sqlite3_stmt *s, int col) -> string_view
+    {
+        const unsigned char *text = sqlite3_column_text(s, col);
+        if (!text)
+            return string_view();
+        return string_view(reinterpret_cast<const char *>(text), sqlite3_column_bytes(s, col));
+    };
+
+    UserHistoryRow row;
+    int rc;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
+    {
+        row.userId = sqlite3_column_int(stmt, 0);
+        row.firstName = textView(stmt, 1);
+        row.lastName = textView(stmt, 2);
+        row.email = textView(stmt, 3);
+        row.hasHistory = sqlite3_column_type(stmt, 4) != SQLITE_NULL;
+        row.resourceId = sqlite3_column_int(stmt, 5);
+        row.hasResource = sqlite3_column_type(stmt, 6) != SQLITE_NULL;
+        row.resourceTitle = textView(stmt, 7);
+        row.issueDate = textView(stmt, 8);
+        row.dueDate = textView(stmt, 9);
+        row.returnDate = textView(stmt, 10);
+        row.fineAmount = sqlite3_column_double(stmt, 11);
+
+        visit(row);
+    }
+
+    return rc == SQLITE_DONE;
+}
@@ -3,27 +3,40 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <functional>
+#include "../database/StatementCache.h"
 #include "../../domain/BorrowingHistory.h"
+#include "../../domain/UserHistoryRow.h"
+#include "BatchSave.h"
 
 class BorrowingHistoryRepository
 {
 private:
     sqlite3 *db;
+    StatementCache &statements;
 
     // Internal helper methods
     bool insertHistory(BorrowingHistory &history);
     bool updateHistory(const BorrowingHistory &history);
+    bool bindHistory(sqlite3_stmt *stmt, const BorrowingHistory &history);
 
 public:
-    explicit BorrowingHistoryRepository(sqlite3 *connection);
+    explicit BorrowingHistoryRepository(sqlite3 *connection, StatementCache &statementCache);
     ~BorrowingHistoryRepository();
 
     // CRUD Operations
     bool save(BorrowingHistory &history);
+    // Inserts new rows (id 0) and updates the rest in one transaction.
+    bool saveAll(std::vector<BorrowingHistory> &histories, BatchSaveResult &result);
     bool deleteHistory(int historyId);
 
     // Retrieval Operations
     std::unique_ptr<BorrowingHistory> getById(int historyId);
     std::vector<BorrowingHistory> getAll();
+    bool forEachHistory(const std::function<void(const BorrowingHistory &)> &visit);
     std::vector<BorrowingHistory> getByUserId(int userId);
+
+    // Streams every user with their history (users without history appear
+    // once with hasHistory == false), ordered by user, in a single query.
+    bool forEachUserHistory(const std::function<void(const UserHistoryRow &)> &visit);
 };
\ No newline at end of file
@@ -0,0 +1,95 @@
+#include "CatalogueSnapshot.h"
+
+void CatalogueSnapshot::clear()
+{
+    ids.clear();
+    categoryIds.clear();
+    totalCopies.clear();
+    availableCopies.clear();
+    active.clear();
+    titles.clear();
+    authors.clear();
+    publishers.clear();
+    text.clear();
+    rowOfId.clear();
+    holes = 0;
+}
+
+void CatalogueSnapshot::reserve(std::size_t rows)
+{
+    ids.reserve(rows);
+    categoryIds.reserve(rows);
+    totalCopies.reserve(rows);
+    availableCopies.reserve(rows);
+    active.reserve(rows);
+    titles.reserve(rows);
+    authors.reserve(rows);
+    publishers.reserve(rows);
+    rowOfId.reserve(rows);
+}
+
+void CatalogueSnapshot::upsert(int resourceId, std::string_view title, std::string_view author,
+                               std::string_view publisher, int categoryId, int total, int available, bool isActive)
+{
+    auto found = rowOfId.find(resourceId);
+    if (found == rowOfId.end())
+    {
+        rowOfId.emplace(resourceId, static_cast<std::uint32_t>(ids.size()));
+        ids.push_back(resourceId);
+        categoryIds.push_back(categoryId);
+        totalCopies.push_back(total);
+        availableCopies.push_back(available);
+        active.push_back(isActive ? 1 : 0);
+        titles.push_back(text.intern(title));
+        authors.push_back(text.intern(author));
+        publishers.push_back(text.intern(publisher));
+        return;
+    }
+
+    std::uint32_t row = found->second;
+    categoryIds[row] = categoryId;
+    totalCopies[row] = total;
+    availableCopies[row] = available;
+    active[row] = isActive ? 1 : 0;
+    titles[row] = text.intern(title);
+    authors[row] = text.intern(author);
+    publishers[row] = text.intern(publisher);
+}
+
+void CatalogueSnapshot::remove(int resourceId)
+{
+    auto found = rowOfId.find(resourceId);
+    if (found == rowOfId.end())
+        return;
+
+    // The hole fails every filter: inactive, nothing on the shelf.
+    std::uint32_t row = found->second;
+    ids[row] = 0;
+    active[row] = 0;
+    availableCopies[row] = 0;
+    totalCopies[row] = 0;
+    rowOfId.erase(found);
+    holes++;
+}
+
+std::size_t CatalogueSnapshot::collectAvailable(std::vector<std::uint32_t> &rows) const
+{
+    std::size_t count = ids.size();
+    rows.resize(count);
+
+    const std::uint8_t *isActive = active.data();
+    const int *onShelf = availableCopies.data();
+    std::uint32_t *out = rows.data();
+
+    // Branch-free compaction: every position is written, and the cursor
+    // only advances past the ones that pass.
+    std::size_t kept = 0;
+    for (std::size_t row = 0; row < count; row++)
+    {
+        out[kept] = static_cast<std::uint32_t>(row);
+        kept += static_cast<std::size_t>(isActive[row] & (onShelf[row] > 0));
+    }
+
+    rows.resize(kept);
+    return kept;
+}
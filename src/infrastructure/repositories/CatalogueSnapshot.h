@@ -0,0 +1,59 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "../../Utility/StringArena.h"
+
+// Read-only view of the catalogue for browsing, laid out as parallel arrays
+// (one per column) instead of a vector of Resource objects. The flag and copy
+// columns are scanned as plain int/byte arrays, and title/author/publisher
+// are ids into a StringArena, so repeated names are stored once.
+//
+// Rows are addressed by position. A deleted resource leaves a hole (id 0)
+// until the next full rebuild, so positions stay stable between refreshes.
+// Maintained by ResourceRepository::getCatalogueSnapshot().
+class CatalogueSnapshot
+{
+private:
+    std::vector<int> ids;
+    std::vector<int> categoryIds;
+    std::vector<int> totalCopies;
+    std::vector<int> availableCopies;
+    std::vector<std::uint8_t> active;
+    std::vector<std::uint32_t> titles;
+    std::vector<std::uint32_t> authors;
+    std::vector<std::uint32_t> publishers;
+
+    StringArena text;
+    std::unordered_map<int, std::uint32_t> rowOfId;
+    std::size_t holes = 0;
+
+public:
+    void clear();
+    void reserve(std::size_t rows);
+
+    // Adds the resource or overwrites its existing row.
+    void upsert(int resourceId, std::string_view title, std::string_view author, std::string_view publisher,
+                int categoryId, int total, int available, bool isActive);
+    void remove(int resourceId);
+
+    // Positions of rows that are active with at least one copy on the shelf,
+    // in catalogue order. Returns how many were written to rows.
+    std::size_t collectAvailable(std::vector<std::uint32_t> &rows) const;
+
+    std::size_t rowCount() const { return ids.size(); }        // including holes
+    std::size_t resourceCount() const { return ids.size() - holes; }
+    std::size_t holeCount() const { return holes; }
+    std::size_t textBytes() const { return text.bytes(); }
+
+    int resourceId(std::size_t row) const { return ids[row]; } // 0 for a hole
+    int categoryId(std::size_t row) const { return categoryIds[row]; }
+    int totalCopiesAt(std::size_t row) const { return totalCopies[row]; }
+    int availableCopiesAt(std::size_t row) const { return availableCopies[row]; }
+    bool isActive(std::size_t row) const { return active[row] != 0; }
+    std::string_view title(std::size_t row) const { return text.view(titles[row]); }
+    std::string_view author(std::size_t row) const { return text.view(authors[row]); }
+    std::string_view publisher(std::size_t row) const { return text.view(publishers[row]); }
+};
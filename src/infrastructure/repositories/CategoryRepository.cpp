@@ -7,7 +7,8 @@ using namespace std;
                  ---------- CONSTRUCTORS & DESTRUCTORS ----------
    *************************************************************************  */
 
-CategoryRepository::CategoryRepository(sqlite3 *connection) : db(connection) {}
+CategoryRepository::CategoryRepository(sqlite3 *connection, StatementCache &statementCache)
+    : db(connection), statements(statementCache) {}
 CategoryRepository::~CategoryRepository() {}
 
 /* *************************************************************************
@@ -17,9 +18,9 @@ CategoryRepository::~CategoryRepository() {}
 bool CategoryRepository::insertCategory(Category &category)
 {
     const char *sql = "INSERT INTO categories (name, description) VALUES (?, ?);";
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, sql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
         return false;
 
     sqlite3_bind_text(stmt, 1, category.getName().c_str(), -1, SQLITE_TRANSIENT);
@@ -30,7 +31,6 @@ bool CategoryRepository::insertCategory(Category &category)
     {
         category.setCategoryId(static_cast<int>(sqlite3_last_insert_rowid(db)));
     }
-    sqlite3_finalize(stmt);
     return success;
 }
 
@@ -41,9 +41,9 @@ bool CategoryRepository::insertCategory(Category &category)
 bool CategoryRepository::updateCategory(const Category &category)
 {
     const char *sql = "UPDATE categories SET name=?, description=? WHERE category_id=?;";
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, sql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
         return false;
 
     sqlite3_bind_text(stmt, 1, category.getName().c_str(), -1, SQLITE_TRANSIENT);
@@ -51,7 +51,6 @@ bool CategoryRepository::updateCategory(const Category &category)
     sqlite3_bind_int(stmt, 3, category.getCategoryId());
 
     bool success = (sqlite3_step(stmt) == SQLITE_DONE);
-    sqlite3_finalize(stmt);
     return success;
 }
 
@@ -73,12 +72,11 @@ bool CategoryRepository::save(Category &category)
 bool CategoryRepository::deleteCategory(int categoryId)
 {
     const char *sql = "DELETE FROM categories WHERE category_id=?;";
-    sqlite3_stmt *stmt = nullptr;
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    CachedStatement stmt(statements, sql);
+    if (!stmt)
         return false;
     sqlite3_bind_int(stmt, 1, categoryId);
     bool success = (sqlite3_step(stmt) == SQLITE_DONE);
-    sqlite3_finalize(stmt);
     return success;
 }
 
@@ -89,8 +87,8 @@ bool CategoryRepository::deleteCategory(int categoryId)
 unique_ptr<Category> CategoryRepository::getById(int categoryId)
 {
     const char *sql = "SELECT category_id, name, description FROM categories WHERE category_id=?;";
-    sqlite3_stmt *stmt = nullptr;
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    CachedStatement stmt(statements, sql);
+    if (!stmt)
         return nullptr;
     sqlite3_bind_int(stmt, 1, categoryId);
 
@@ -104,7 +102,6 @@ unique_ptr<Category> CategoryRepository::getById(int categoryId)
             name ? reinterpret_cast<const char *>(name) : "",
             desc ? reinterpret_cast<const char *>(desc) : "");
     }
-    sqlite3_finalize(stmt);
     return category;
 }
 
@@ -112,23 +109,33 @@ unique_ptr<Category> CategoryRepository::getById(int categoryId)
                   ---------- GET ALL CATEGORIES ----------
    *************************************************************************  */
 
-vector<Category> CategoryRepository::getAll()
+bool CategoryRepository::forEachCategory(const function<void(const Category &)> &visit)
 {
-    vector<Category> results;
     const char *sql = "SELECT category_id, name, description FROM categories;";
-    sqlite3_stmt *stmt = nullptr;
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
-        return results;
+    CachedStatement stmt(statements, sql);
+    if (!stmt)
+        return false;
 
-    while (sqlite3_step(stmt) == SQLITE_ROW)
+    int rc;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
     {
         const unsigned char *name = sqlite3_column_text(stmt, 1);
         const unsigned char *desc = sqlite3_column_text(stmt, 2);
-        results.emplace_back(
+        Category row(
             sqlite3_column_int(stmt, 0),
             name ? reinterpret_cast<const char *>(name) : "",
             desc ? reinterpret_cast<const char *>(desc) : "");
+        visit(row);
     }
-    sqlite3_finalize(stmt);
+    return rc == SQLITE_DONE;
+}
+
+vector<Category> CategoryRepository::getAll()
+{
+    vector<Category> results;
+    forEachCategory([&results](const Category &item)
+    {
+        results.push_back(item);
+    });
     return results;
-}
\ No newline at end of file
+}
@@ -3,21 +3,25 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <functional>
+#include "../database/StatementCache.h"
 #include "../../domain/Category.h"
 
 class CategoryRepository
 {
 private:
     sqlite3 *db;
+    StatementCache &statements;
     bool insertCategory(Category &category);
     bool updateCategory(const Category &category);
 
 public:
-    explicit CategoryRepository(sqlite3 *connection);
+    explicit CategoryRepository(sqlite3 *connection, StatementCache &statementCache);
     ~CategoryRepository();
 
     bool save(Category &category);
     bool deleteCategory(int categoryId);
     std::unique_ptr<Category> getById(int categoryId);
     std::vector<Category> getAll();
+    bool forEachCategory(const std::function<void(const Category &)> &visit);
 };
\ No newline at end of file
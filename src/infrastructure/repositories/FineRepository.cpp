@@ -1,5 +1,6 @@
 #include "FineRepository.h"
 #include <iostream>
+#include <algorithm>
 
 using namespace std;
 
@@ -7,43 +8,58 @@ using namespace std;
                  ---------- CONSTRUCTORS & DESTRUCTORS ----------
    *************************************************************************  */
 
-FineRepository::FineRepository(sqlite3 *connection) : db(connection) {}
+FineRepository::FineRepository(sqlite3 *connection, StatementCache &statementCache)
+    : db(connection), statements(statementCache) {}
 FineRepository::~FineRepository() {}
 
 /* *************************************************************************
-                       ---------- INSERT FINES ----------
+                    ---------- BIND FINE COLUMNS ----------
    *************************************************************************  */
 
-bool FineRepository::insertFine(Fine &fine)
+static const char *insertFineSql =
+    "INSERT INTO fines "
+    "(transaction_id, user_id, days_overdue, fine_amount, "
+    "fine_date, is_paid, payment_date) "
+    "VALUES (?, ?, ?, ?, ?, ?, ?);";
+
+static const char *updateFineSql =
+    "UPDATE fines SET "
+    "transaction_id=?, user_id=?, days_overdue=?, "
+    "fine_amount=?, fine_date=?, is_paid=?, payment_date=? "
+    "WHERE fine_id=?;";
+
+// Parameters 1-7 are shared by the INSERT and the UPDATE; the UPDATE adds the id as 8.
+bool FineRepository::bindFine(sqlite3_stmt *stmt, const Fine &fine)
 {
+    return sqlite3_bind_int(stmt, 1, fine.getTransactionId()) == SQLITE_OK &&
+           sqlite3_bind_int(stmt, 2, fine.getUserId()) == SQLITE_OK &&
+           sqlite3_bind_int(stmt, 3, fine.getDaysOverdue()) == SQLITE_OK &&
+           sqlite3_bind_double(stmt, 4, fine.getFineAmount()) == SQLITE_OK &&
+           sqlite3_bind_text(stmt, 5, fine.getFineDate().c_str(), -1, SQLITE_TRANSIENT) == SQLITE_OK &&
+           sqlite3_bind_int(stmt, 6, fine.getIsPaid() ? 1 : 0) == SQLITE_OK &&
+           sqlite3_bind_text(stmt, 7, fine.getPaymentDate().c_str(), -1, SQLITE_TRANSIENT) == SQLITE_OK;
+}
 
-    const char *sql =
-        "INSERT INTO fines "
-        "(transaction_id, user_id, days_overdue, fine_amount, "
-        "fine_date, is_paid, payment_date) "
-        "VALUES (?, ?, ?, ?, ?, ?, ?);";
+/* *************************************************************************
+                       ---------- INSERT FINES ----------
+   *************************************************************************  */
 
-    sqlite3_stmt *stmt = nullptr;
+bool FineRepository::insertFine(Fine &fine)
+{
+    CachedStatement stmt(statements, insertFineSql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
     {
         cerr << "Failed to prepare INSERT: "
              << sqlite3_errmsg(db) << endl;
         return false;
     }
 
-    if (sqlite3_bind_int(stmt, 1, fine.getTransactionId()) != SQLITE_OK ||
-        sqlite3_bind_int(stmt, 2, fine.getUserId()) != SQLITE_OK ||
-        sqlite3_bind_int(stmt, 3, fine.getDaysOverdue()) != SQLITE_OK ||
-        sqlite3_bind_double(stmt, 4, fine.getFineAmount()) != SQLITE_OK ||
-        sqlite3_bind_text(stmt, 5, fine.getFineDate().c_str(), -1, SQLITE_TRANSIENT) != SQLITE_OK ||
-        sqlite3_bind_int(stmt, 6, fine.getIsPaid() ? 1 : 0) != SQLITE_OK ||
-        sqlite3_bind_text(stmt, 7, fine.getPaymentDate().c_str(), -1, SQLITE_TRANSIENT) != SQLITE_OK)
+    if (!bindFine(stmt, fine))
     {
 
         cerr << "Failed to bind parameters for INSERT: "
              << sqlite3_errmsg(db) << endl;
-        sqlite3_finalize(stmt);
         return false;
     }
 
@@ -60,7 +76,6 @@ bool FineRepository::insertFine(Fine &fine)
         sqlite3_int64 lastId = sqlite3_last_insert_rowid(db);
         fine.setFineId(static_cast<int>(lastId));
     }
-    sqlite3_finalize(stmt);
     return success;
 }
 
@@ -70,35 +85,21 @@ bool FineRepository::insertFine(Fine &fine)
 
 bool FineRepository::updateFine(const Fine &fine)
 {
+    CachedStatement stmt(statements, updateFineSql);
 
-    const char *sql =
-        "UPDATE fines SET "
-        "transaction_id=?, user_id=?, days_overdue=?, "
-        "fine_amount=?, fine_date=?, is_paid=?, payment_date=? "
-        "WHERE fine_id=?;";
-
-    sqlite3_stmt *stmt = nullptr;
-
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
     {
         cerr << "Failed to prepare UPDATE: "
              << sqlite3_errmsg(db) << endl;
         return false;
     }
 
-    if (sqlite3_bind_int(stmt, 1, fine.getTransactionId()) != SQLITE_OK ||
-        sqlite3_bind_int(stmt, 2, fine.getUserId()) != SQLITE_OK ||
-        sqlite3_bind_int(stmt, 3, fine.getDaysOverdue()) != SQLITE_OK ||
-        sqlite3_bind_double(stmt, 4, fine.getFineAmount()) != SQLITE_OK ||
-        sqlite3_bind_text(stmt, 5, fine.getFineDate().c_str(), -1, SQLITE_TRANSIENT) != SQLITE_OK ||
-        sqlite3_bind_int(stmt, 6, fine.getIsPaid() ? 1 : 0) != SQLITE_OK ||
-        sqlite3_bind_text(stmt, 7, fine.getPaymentDate().c_str(), -1, SQLITE_TRANSIENT) != SQLITE_OK ||
+    if (!bindFine(stmt, fine) ||
         sqlite3_bind_int(stmt, 8, fine.getFineId()) != SQLITE_OK)
     {
 
         cerr << "Failed to bind parameters for UPDATE: "
              << sqlite3_errmsg(db) << endl;
-        sqlite3_finalize(stmt);
         return false;
     }
 
@@ -110,7 +111,6 @@ bool FineRepository::updateFine(const Fine &fine)
              << sqlite3_errmsg(db) << endl;
     }
 
-    sqlite3_finalize(stmt);
     return success;
 }
 
@@ -124,9 +124,9 @@ bool FineRepository::deleteFine(int fineId)
     const char *sql =
         "DELETE FROM fines WHERE fine_id=?;";
 
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, sql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
     {
         cerr << "Failed to prepare DELETE: "
              << sqlite3_errmsg(db) << endl;
@@ -137,7 +137,6 @@ bool FineRepository::deleteFine(int fineId)
     {
         cerr << "Failed to bind fineId: "
              << sqlite3_errmsg(db) << endl;
-        sqlite3_finalize(stmt);
         return false;
     }
 
@@ -149,7 +148,6 @@ bool FineRepository::deleteFine(int fineId)
              << sqlite3_errmsg(db) << endl;
     }
 
-    sqlite3_finalize(stmt);
     return success;
 }
 
@@ -165,9 +163,9 @@ std::unique_ptr<Fine> FineRepository::getById(int fineId)
         "fine_amount, fine_date, is_paid, payment_date "
         "FROM fines WHERE fine_id=?;";
 
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, sql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
     {
         cerr << "Failed to prepare SELECT: "
              << sqlite3_errmsg(db) << endl;
@@ -178,7 +176,6 @@ std::unique_ptr<Fine> FineRepository::getById(int fineId)
     {
         cerr << "Failed to bind fineId: "
              << sqlite3_errmsg(db) << endl;
-        sqlite3_finalize(stmt);
         return nullptr;
     }
 
@@ -203,7 +200,6 @@ std::unique_ptr<Fine> FineRepository::getById(int fineId)
             safeText(stmt, 7));
     }
 
-    sqlite3_finalize(stmt);
     return fine;
 }
 
@@ -221,9 +217,9 @@ std::vector<Fine> FineRepository::getByUserId(int userId)
         "fine_amount, fine_date, is_paid, payment_date "
         "FROM fines WHERE user_id=?;";
 
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, sql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
     {
         cerr << "Failed to prepare SELECT BY USER: "
              << sqlite3_errmsg(db) << endl;
@@ -234,7 +230,6 @@ std::vector<Fine> FineRepository::getByUserId(int userId)
     {
         cerr << "Failed to bind userId: "
              << sqlite3_errmsg(db) << endl;
-        sqlite3_finalize(stmt);
         return fines;
     }
 
@@ -257,7 +252,6 @@ std::vector<Fine> FineRepository::getByUserId(int userId)
             safeText(stmt, 7));
     }
 
-    sqlite3_finalize(stmt);
     return fines;
 }
 
@@ -265,33 +259,36 @@ std::vector<Fine> FineRepository::getByUserId(int userId)
                        ---------- GET ALL FINES ----------
    *************************************************************************  */
 
-std::vector<Fine> FineRepository::getAllFines()
+bool FineRepository::forEachFine(const std::function<void(const Fine &)> &visit)
 {
-
-    std::vector<Fine> fines;
-
     const char *sql =
         "SELECT fine_id, transaction_id, user_id, days_overdue, "
         "fine_amount, fine_date, is_paid, payment_date FROM fines;";
 
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, sql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
     {
         cerr << "Failed to prepare SELECT ALL: "
              << sqlite3_errmsg(db) << endl;
-        return fines;
+        return false;
     }
 
+    return visitRows(stmt, visit);
+}
+
+bool FineRepository::visitRows(sqlite3_stmt *stmt, const std::function<void(const Fine &)> &visit)
+{
     auto safeText = [](sqlite3_stmt *stmt, int col) -> string
     {
         const unsigned char *text = sqlite3_column_text(stmt, col);
         return text ? reinterpret_cast<const char *>(text) : "";
     };
 
-    while (sqlite3_step(stmt) == SQLITE_ROW)
+    int rc;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
     {
-        fines.emplace_back(
+        Fine row(
             sqlite3_column_int(stmt, 0),
             sqlite3_column_int(stmt, 1),
             sqlite3_column_int(stmt, 2),
@@ -300,10 +297,80 @@ std::vector<Fine> FineRepository::getAllFines()
             safeText(stmt, 5),
             sqlite3_column_int(stmt, 6) == 1,
             safeText(stmt, 7));
+        visit(row);
     }
 
-    sqlite3_finalize(stmt);
-    return fines;
+    return rc == SQLITE_DONE;
+}
+
+std::vector<Fine> FineRepository::getAllFines()
+{
+    std::vector<Fine> results;
+    forEachFine([&results](const Fine &item)
+    {
+        results.push_back(item);
+    });
+    return results;
+}
+
+/* *************************************************************************
+                  ---------- KEYSET PAGES OF FINES ----------
+   *************************************************************************  */
+
+std::vector<Fine> FineRepository::getPageAfter(int afterId, int limit)
+{
+    std::vector<Fine> page;
+
+    const char *sql =
+        "SELECT fine_id, transaction_id, user_id, days_overdue, "
+        "fine_amount, fine_date, is_paid, payment_date "
+        "FROM fines WHERE fine_id > ? ORDER BY fine_id LIMIT ?;";
+
+    CachedStatement stmt(statements, sql);
+
+    if (!stmt)
+    {
+        std::cerr << "Failed to prepare page query: " << sqlite3_errmsg(db) << std::endl;
+        return page;
+    }
+
+    sqlite3_bind_int(stmt, 1, afterId);
+    sqlite3_bind_int(stmt, 2, limit);
+
+    visitRows(stmt, [&page](const Fine &item)
+    {
+        page.push_back(item);
+    });
+    return page;
+}
+
+std::vector<Fine> FineRepository::getPageBefore(int beforeId, int limit)
+{
+    std::vector<Fine> page;
+
+    const char *sql =
+        "SELECT fine_id, transaction_id, user_id, days_overdue, "
+        "fine_amount, fine_date, is_paid, payment_date "
+        "FROM fines WHERE fine_id < ? ORDER BY fine_id DESC LIMIT ?;";
+
+    CachedStatement stmt(statements, sql);
+
+    if (!stmt)
+    {
+        std::cerr << "Failed to prepare page query: " << sqlite3_errmsg(db) << std::endl;
+        return page;
+    }
+
+    sqlite3_bind_int(stmt, 1, beforeId);
+    sqlite3_bind_int(stmt, 2, limit);
+
+    visitRows(stmt, [&page](const Fine &item)
+    {
+        page.push_back(item);
+    });
+
+    std::reverse(page.begin(), page.end());
+    return page;
 }
 
 /* *************************************************************************
@@ -317,4 +384,110 @@ bool FineRepository::save(Fine &fine)
         return insertFine(fine);
     }
     return updateFine(fine);
-}
\ No newline at end of file
+}
+
+bool FineRepository::saveAll(vector<Fine> &fines, BatchSaveResult &result)
+{
+    CachedStatement insertStmt(statements, insertFineSql);
+    CachedStatement updateStmt(statements, updateFineSql);
+
+    if (!insertStmt || !updateStmt)
+    {
+        cerr << "Failed to prepare batch save: " << sqlite3_errmsg(db) << endl;
+        return false;
+    }
+
+    return runBatchSave(db, fines.size(), result, [&](size_t i)
+                        {
+                            Fine &fine = fines[i];
+                            bool isNew = fine.getFineId() == 0;
+                            sqlite3_stmt *stmt = isNew ? insertStmt : updateStmt;
+
+                            bool success = bindFine(stmt, fine) &&
+                                           (isNew || sqlite3_bind_int(stmt, 8, fine.getFineId()) == SQLITE_OK) &&
+                                           sqlite3_step(stmt) == SQLITE_DONE;
+                            sqlite3_reset(stmt);
+
+                            if (success && isNew)
+                                fine.setFineId(static_cast<int>(sqlite3_last_insert_rowid(db)));
+                            return success; });
+}
+
+/* *************************************************************************
+                   ---------- UPSERT OVERDUE FINES ----------
+   *************************************************************************  */
+
+bool FineRepository::upsertOverdueFines(const std::vector<OverdueCharge> &charges, const std::string &fineDate,
+                                        int &updatedCount, int &createdCount)
+{
+    updatedCount = 0;
+    createdCount = 0;
+
+    // The oldest fine raised for the transaction is the one that gets refreshed,
+    // matching the order getByUserId returns rows in.
+    const char *updateSql =
+        "UPDATE fines SET days_overdue=?, fine_amount=?, fine_date=? "
+        "WHERE fine_id = (SELECT MIN(fine_id) FROM fines WHERE transaction_id=? AND user_id=?);";
+
+    const char *insertSql =
+        "INSERT INTO fines "
+        "(transaction_id, user_id, days_overdue, fine_amount, "
+        "fine_date, is_paid, payment_date) "
+        "VALUES (?, ?, ?, ?, ?, 0, '');";
+
+    for (const OverdueCharge &charge : charges)
+    {
+        {
+            CachedStatement stmt(statements, updateSql);
+            if (!stmt)
+            {
+                cerr << "Failed to prepare UPSERT (update): "
+                     << sqlite3_errmsg(db) << endl;
+                return false;
+            }
+
+            sqlite3_bind_int(stmt, 1, charge.daysOverdue);
+            sqlite3_bind_double(stmt, 2, charge.fineAmount);
+            sqlite3_bind_text(stmt, 3, fineDate.c_str(), -1, SQLITE_STATIC);
+            sqlite3_bind_int(stmt, 4, charge.transactionId);
+            sqlite3_bind_int(stmt, 5, charge.userId);
+
+            if (sqlite3_step(stmt) != SQLITE_DONE)
+            {
+                cerr << "Failed to execute UPSERT (update): "
+                     << sqlite3_errmsg(db) << endl;
+                return false;
+            }
+
+            if (sqlite3_changes(db) > 0)
+            {
+                updatedCount++;
+                continue;
+            }
+        }
+
+        CachedStatement stmt(statements, insertSql);
+        if (!stmt)
+        {
+            cerr << "Failed to prepare UPSERT (insert): "
+                 << sqlite3_errmsg(db) << endl;
+            return false;
+        }
+
+        sqlite3_bind_int(stmt, 1, charge.transactionId);
+        sqlite3_bind_int(stmt, 2, charge.userId);
+        sqlite3_bind_int(stmt, 3, charge.daysOverdue);
+        sqlite3_bind_double(stmt, 4, charge.fineAmount);
+        sqlite3_bind_text(stmt, 5, fineDate.c_str(), -1, SQLITE_STATIC);
+
+        if (sqlite3_step(stmt) != SQLITE_DONE)
+        {
+            cerr << "Failed to execute UPSERT (insert): "
+                 << sqlite3_errmsg(db) << endl;
+            return false;
+        }
+        createdCount++;
+    }
+
+    return true;
+}
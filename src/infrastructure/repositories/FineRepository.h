@@ -3,24 +3,41 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <functional>
+#include "../database/StatementCache.h"
 #include "../../domain/Fine.h"
+#include "../../domain/OverdueCharge.h"
+#include "BatchSave.h"
 
 class FineRepository
 {
 private:
     sqlite3 *db;
+    StatementCache &statements;
 
     bool insertFine(Fine &fine);
     bool updateFine(const Fine &fine);
+    bool bindFine(sqlite3_stmt *stmt, const Fine &fine);
+    bool visitRows(sqlite3_stmt *stmt, const std::function<void(const Fine &)> &visit);
 
 public:
-    explicit FineRepository(sqlite3 *connection);
+    explicit FineRepository(sqlite3 *connection, StatementCache &statementCache);
     ~FineRepository();
 
     bool save(Fine &fine);
+    // Inserts new rows (id 0) and updates the rest in one transaction.
+    bool saveAll(std::vector<Fine> &fines, BatchSaveResult &result);
     bool deleteFine(int fineId);
 
     std::unique_ptr<Fine> getById(int fineId);
     std::vector<Fine> getByUserId(int userId);
     std::vector<Fine> getAllFines();
+    bool forEachFine(const std::function<void(const Fine &)> &visit);
+    std::vector<Fine> getPageAfter(int afterId, int limit);
+    std::vector<Fine> getPageBefore(int beforeId, int limit);
+
+    // Batch fine engine: updates the fine already raised for each charge or
+    // creates it. Expects to run inside the caller's SQLite transaction.
+    bool upsertOverdueFines(const std::vector<OverdueCharge> &charges, const std::string &fineDate,
+                            int &updatedCount, int &createdCount);
 };
\ No newline at end of file
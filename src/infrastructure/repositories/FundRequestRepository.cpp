@@ -7,7 +7,8 @@ using namespace std;
                  ---------- CONSTRUCTORS & DESTRUCTORS ----------
    *************************************************************************  */
 
-FundRequestRepository::FundRequestRepository(sqlite3 *connection) : db(connection) {}
+FundRequestRepository::FundRequestRepository(sqlite3 *connection, StatementCache &statementCache)
+    : db(connection), statements(statementCache) {}
 FundRequestRepository::~FundRequestRepository() {}
 
 /* *************************************************************************
@@ -21,9 +22,9 @@ bool FundRequestRepository::insertFundRequest(FundRequest &request)
         "(user_id, requested_amount, request_date, status) "
         "VALUES (?, ?, ?, ?);";
 
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, sql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
     {
         cerr << "Failed to prepare INSERT: " << sqlite3_errmsg(db) << endl;
         return false;
@@ -34,7 +35,6 @@ bool FundRequestRepository::insertFundRequest(FundRequest &request)
         sqlite3_bind_text(stmt, 4, request.getStatus().c_str(), -1, SQLITE_TRANSIENT) != SQLITE_OK)
     {
         cerr << "Failed to bind parameters for INSERT: " << sqlite3_errmsg(db) << endl;
-        sqlite3_finalize(stmt);
         return false;
     }
     bool success = (sqlite3_step(stmt) == SQLITE_DONE);
@@ -47,7 +47,6 @@ bool FundRequestRepository::insertFundRequest(FundRequest &request)
         sqlite3_int64 lastId = sqlite3_last_insert_rowid(db);
         request.setRequestId(static_cast<int>(lastId));
     }
-    sqlite3_finalize(stmt);
     return success;
 }
 
@@ -64,9 +63,9 @@ bool FundRequestRepository::updateFundRequest(const FundRequest &request)
         "admin_id=?, approval_date=?, admin_notes=? "
         "WHERE request_id=?;";
 
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, sql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
     {
         cerr << "Failed to prepare UPDATE: "
              << sqlite3_errmsg(db) << endl;
@@ -82,7 +81,6 @@ bool FundRequestRepository::updateFundRequest(const FundRequest &request)
         sqlite3_bind_int(stmt, 8, request.getRequestId()) != SQLITE_OK)
     {
         cerr << "Failed to bind parameters for UPDATE: " << sqlite3_errmsg(db) << endl;
-        sqlite3_finalize(stmt);
         return false;
     }
     if (request.getAdminId() == 0)
@@ -98,7 +96,6 @@ bool FundRequestRepository::updateFundRequest(const FundRequest &request)
     {
         cerr << "Failed to execute UPDATE: " << sqlite3_errmsg(db) << endl;
     }
-    sqlite3_finalize(stmt);
     return success;
 }
 
@@ -112,9 +109,9 @@ bool FundRequestRepository::deleteFundRequest(int requestId)
     const char *sql =
         "DELETE FROM fund_requests WHERE request_id=?;";
 
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, sql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
     {
         cerr << "Failed to prepare DELETE: "
              << sqlite3_errmsg(db) << endl;
@@ -124,7 +121,6 @@ bool FundRequestRepository::deleteFundRequest(int requestId)
     if (sqlite3_bind_int(stmt, 1, requestId) != SQLITE_OK)
     {
         cerr << "Failed to bind requestId: " << sqlite3_errmsg(db) << endl;
-        sqlite3_finalize(stmt);
         return false;
     }
 
@@ -136,7 +132,6 @@ bool FundRequestRepository::deleteFundRequest(int requestId)
              << sqlite3_errmsg(db) << endl;
     }
 
-    sqlite3_finalize(stmt);
     return success;
 }
 
@@ -152,9 +147,9 @@ std::unique_ptr<FundRequest> FundRequestRepository::getById(int requestId)
         "status, admin_id, approval_date, admin_notes "
         "FROM fund_requests WHERE request_id=?;";
 
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, sql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
     {
         cerr << "Failed to prepare SELECT: "
              << sqlite3_errmsg(db) << endl;
@@ -164,7 +159,6 @@ std::unique_ptr<FundRequest> FundRequestRepository::getById(int requestId)
     if (sqlite3_bind_int(stmt, 1, requestId) != SQLITE_OK)
     {
         cerr << "Failed to bind requestId: " << sqlite3_errmsg(db) << endl;
-        sqlite3_finalize(stmt);
         return nullptr;
     }
 
@@ -189,7 +183,6 @@ std::unique_ptr<FundRequest> FundRequestRepository::getById(int requestId)
             safeText(stmt, 7));
     }
 
-    sqlite3_finalize(stmt);
     return request;
 }
 
@@ -207,9 +200,9 @@ std::vector<FundRequest> FundRequestRepository::getByUserId(int userId)
         "status, admin_id, approval_date, admin_notes "
         "FROM fund_requests WHERE user_id=?;";
 
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, sql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
     {
         cerr << "Failed to prepare SELECT BY USER: "
              << sqlite3_errmsg(db) << endl;
@@ -219,7 +212,6 @@ std::vector<FundRequest> FundRequestRepository::getByUserId(int userId)
     if (sqlite3_bind_int(stmt, 1, userId) != SQLITE_OK)
     {
         cerr << "Failed to bind userId: " << sqlite3_errmsg(db) << endl;
-        sqlite3_finalize(stmt);
         return requests;
     }
 
@@ -242,7 +234,6 @@ std::vector<FundRequest> FundRequestRepository::getByUserId(int userId)
             safeText(stmt, 7));
     }
 
-    sqlite3_finalize(stmt);
     return requests;
 }
 
@@ -250,22 +241,19 @@ std::vector<FundRequest> FundRequestRepository::getByUserId(int userId)
                     ---------- GET ALL FUND REQUESTS ----------
    *************************************************************************  */
 
-std::vector<FundRequest> FundRequestRepository::getAllFundRequests()
+bool FundRequestRepository::forEachFundRequest(const std::function<void(const FundRequest &)> &visit)
 {
-
-    std::vector<FundRequest> requests;
-
     const char *sql =
         "SELECT request_id, user_id, requested_amount, request_date, "
         "status, admin_id, approval_date, admin_notes FROM fund_requests;";
 
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, sql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
     {
         cerr << "Failed to prepare SELECT ALL: "
              << sqlite3_errmsg(db) << endl;
-        return requests;
+        return false;
     }
 
     auto safeText = [](sqlite3_stmt *stmt, int col) -> string
@@ -274,9 +262,10 @@ std::vector<FundRequest> FundRequestRepository::getAllFundRequests()
         return text ? reinterpret_cast<const char *>(text) : "";
     };
 
-    while (sqlite3_step(stmt) == SQLITE_ROW)
+    int rc;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
     {
-        requests.emplace_back(
+        FundRequest row(
             sqlite3_column_int(stmt, 0),
             sqlite3_column_int(stmt, 1),
             sqlite3_column_double(stmt, 2),
@@ -285,10 +274,20 @@ std::vector<FundRequest> FundRequestRepository::getAllFundRequests()
             sqlite3_column_int(stmt, 5),
             safeText(stmt, 6),
             safeText(stmt, 7));
+        visit(row);
     }
 
-    sqlite3_finalize(stmt);
-    return requests;
+    return rc == SQLITE_DONE;
+}
+
+std::vector<FundRequest> FundRequestRepository::getAllFundRequests()
+{
+    std::vector<FundRequest> results;
+    forEachFundRequest([&results](const FundRequest &item)
+    {
+        results.push_back(item);
+    });
+    return results;
 }
 
 /* *************************************************************************
@@ -3,18 +3,21 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <functional>
+#include "../database/StatementCache.h"
 #include "../../domain/FundRequest.h"
 
 class FundRequestRepository
 {
 private:
     sqlite3 *db;
+    StatementCache &statements;
 
     bool insertFundRequest(FundRequest &request);
     bool updateFundRequest(const FundRequest &request);
 
 public:
-    explicit FundRequestRepository(sqlite3 *connection);
+    explicit FundRequestRepository(sqlite3 *connection, StatementCache &statementCache);
     ~FundRequestRepository();
 
     bool save(FundRequest &request);
@@ -23,4 +26,5 @@ public:
     std::unique_ptr<FundRequest> getById(int requestId);
     std::vector<FundRequest> getByUserId(int userId);
     std::vector<FundRequest> getAllFundRequests();
+    bool forEachFundRequest(const std::function<void(const FundRequest &)> &visit);
 };
\ No newline at end of file
@@ -7,7 +7,8 @@ using namespace std;
                  ---------- CONSTRUCTORS & DESTRUCTORS ----------
    *************************************************************************  */
 
-MembershipTypeRepository::MembershipTypeRepository(sqlite3 *connection) : db(connection) {}
+MembershipTypeRepository::MembershipTypeRepository(sqlite3 *connection, StatementCache &statementCache)
+    : db(connection), statements(statementCache) {}
 MembershipTypeRepository::~MembershipTypeRepository() {}
 
 /* *************************************************************************
@@ -24,9 +25,9 @@ bool MembershipTypeRepository::insertMembershipType(MembershipType &type)
         "fine_per_day, description) "
         "VALUES (?, ?, ?, ?, ?, ?, ?);";
 
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, sql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
     {
         cerr << "Failed to prepare INSERT: " << sqlite3_errmsg(db) << endl;
         return false;
@@ -43,7 +44,6 @@ bool MembershipTypeRepository::insertMembershipType(MembershipType &type)
 
         cerr << "Failed to bind parameters for INSERT: "
              << sqlite3_errmsg(db) << endl;
-        sqlite3_finalize(stmt);
         return false;
     }
 
@@ -58,7 +58,6 @@ bool MembershipTypeRepository::insertMembershipType(MembershipType &type)
         sqlite3_int64 lastId = sqlite3_last_insert_rowid(db);
         type.setMembershipTypeId(static_cast<int>(lastId));
     }
-    sqlite3_finalize(stmt);
     return success;
 }
 
@@ -76,9 +75,9 @@ bool MembershipTypeRepository::updateMembershipType(const MembershipType &type)
         "fine_per_day=?, description=? "
         "WHERE membership_type_id=?;";
 
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, sql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
     {
         cerr << "Failed to prepare UPDATE: " << sqlite3_errmsg(db) << endl;
         return false;
@@ -96,7 +95,6 @@ bool MembershipTypeRepository::updateMembershipType(const MembershipType &type)
 
         cerr << "Failed to bind parameters for UPDATE: "
              << sqlite3_errmsg(db) << endl;
-        sqlite3_finalize(stmt);
         return false;
     }
 
@@ -105,7 +103,6 @@ bool MembershipTypeRepository::updateMembershipType(const MembershipType &type)
         cerr << "Failed to execute UPDATE: "
              << sqlite3_errmsg(db) << endl;
 
-    sqlite3_finalize(stmt);
     return success;
 }
 
@@ -119,9 +116,9 @@ bool MembershipTypeRepository::deleteMembershipType(int typeId)
     const char *sql =
         "DELETE FROM membership_types WHERE membership_type_id=?;";
 
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, sql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
     {
         cerr << "Failed to prepare DELETE: " << sqlite3_errmsg(db) << endl;
         return false;
@@ -130,7 +127,6 @@ bool MembershipTypeRepository::deleteMembershipType(int typeId)
     if (sqlite3_bind_int(stmt, 1, typeId) != SQLITE_OK)
     {
         cerr << "Failed to bind typeId for DELETE: " << sqlite3_errmsg(db) << endl;
-        sqlite3_finalize(stmt);
         return false;
     }
 
@@ -139,7 +135,6 @@ bool MembershipTypeRepository::deleteMembershipType(int typeId)
         cerr << "Failed to execute DELETE: "
              << sqlite3_errmsg(db) << endl;
 
-    sqlite3_finalize(stmt);
     return success;
 }
 
@@ -156,9 +151,9 @@ std::unique_ptr<MembershipType> MembershipTypeRepository::getById(int typeId)
         "fine_per_day, description "
         "FROM membership_types WHERE membership_type_id=?;";
 
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, sql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
     {
         cerr << "Failed to prepare SELECT: " << sqlite3_errmsg(db) << endl;
         return nullptr;
@@ -167,7 +162,6 @@ std::unique_ptr<MembershipType> MembershipTypeRepository::getById(int typeId)
     if (sqlite3_bind_int(stmt, 1, typeId) != SQLITE_OK)
     {
         cerr << "Failed to bind typeId in SELECT: " << sqlite3_errmsg(db) << endl;
-        sqlite3_finalize(stmt);
         return nullptr;
     }
 
@@ -192,7 +186,6 @@ std::unique_ptr<MembershipType> MembershipTypeRepository::getById(int typeId)
             safeText(stmt, 7));
     }
 
-    sqlite3_finalize(stmt);
     return type;
 }
 
@@ -200,23 +193,20 @@ std::unique_ptr<MembershipType> MembershipTypeRepository::getById(int typeId)
                   ---------- GET ALL MEMBERSHIP TYPES ----------
    *************************************************************************  */
 
-std::vector<MembershipType> MembershipTypeRepository::getAllMembershipTypes()
+bool MembershipTypeRepository::forEachMembershipType(const std::function<void(const MembershipType &)> &visit)
 {
-
-    std::vector<MembershipType> types;
-
     const char *sql =
         "SELECT membership_type_id, membership_name, duration_days, price, "
         "max_borrowing_limit, borrowing_duration_days, "
         "fine_per_day, description FROM membership_types;";
 
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, sql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
     {
         cerr << "Failed to prepare SELECT ALL: "
              << sqlite3_errmsg(db) << endl;
-        return types;
+        return false;
     }
 
     auto safeText = [](sqlite3_stmt *stmt, int col) -> string
@@ -225,9 +215,10 @@ std::vector<MembershipType> MembershipTypeRepository::getAllMembershipTypes()
         return text ? reinterpret_cast<const char *>(text) : "";
     };
 
-    while (sqlite3_step(stmt) == SQLITE_ROW)
+    int rc;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
     {
-        types.emplace_back(
+        MembershipType row(
             sqlite3_column_int(stmt, 0),
             safeText(stmt, 1),
             sqlite3_column_int(stmt, 2),
@@ -236,10 +227,20 @@ std::vector<MembershipType> MembershipTypeRepository::getAllMembershipTypes()
             sqlite3_column_int(stmt, 5),
             sqlite3_column_double(stmt, 6),
             safeText(stmt, 7));
+        visit(row);
     }
 
-    sqlite3_finalize(stmt);
-    return types;
+    return rc == SQLITE_DONE;
+}
+
+std::vector<MembershipType> MembershipTypeRepository::getAllMembershipTypes()
+{
+    std::vector<MembershipType> results;
+    forEachMembershipType([&results](const MembershipType &item)
+    {
+        results.push_back(item);
+    });
+    return results;
 }
 
 /* *************************************************************************
@@ -3,18 +3,21 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <functional>
+#include "../database/StatementCache.h"
 #include "../../domain/MembershipType.h"
 
 class MembershipTypeRepository
 {
 private:
     sqlite3 *db;
+    StatementCache &statements;
 
     bool insertMembershipType(MembershipType &type);
     bool updateMembershipType(const MembershipType &type);
 
 public:
-    explicit MembershipTypeRepository(sqlite3 *connection);
+    explicit MembershipTypeRepository(sqlite3 *connection, StatementCache &statementCache);
     ~MembershipTypeRepository();
 
     bool save(MembershipType &type);
@@ -22,4 +25,5 @@ public:
 
     std::unique_ptr<MembershipType> getById(int typeId);
     std::vector<MembershipType> getAllMembershipTypes();
+    bool forEachMembershipType(const std::function<void(const MembershipType &)> &visit);
 };
\ No newline at end of file
@@ -7,7 +7,8 @@ using namespace std;
                  ---------- CONSTRUCTORS & DESTRUCTORS ----------
    *************************************************************************  */
 
-ReservationRepository::ReservationRepository(sqlite3 *connection) : db(connection) {}
+ReservationRepository::ReservationRepository(sqlite3 *connection, StatementCache &statementCache)
+    : db(connection), statements(statementCache) {}
 ReservationRepository::~ReservationRepository() {}
 
 /* *************************************************************************
@@ -23,9 +24,9 @@ bool ReservationRepository::insertReservation(Reservation &reservation)
         "is_fulfilled, is_cancelled, status) "
         "VALUES (?, ?, ?, ?, ?, ?, ?);";
 
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, sql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
     {
         cerr << "Failed to prepare INSERT: " << sqlite3_errmsg(db) << endl;
         return false;
@@ -42,7 +43,6 @@ bool ReservationRepository::insertReservation(Reservation &reservation)
 
         cerr << "Failed to bind parameters for INSERT: "
              << sqlite3_errmsg(db) << endl;
-        sqlite3_finalize(stmt);
         return false;
     }
 
@@ -57,7 +57,6 @@ bool ReservationRepository::insertReservation(Reservation &reservation)
         reservation.setReservationId(static_cast<int>(lastId));
     }
 
-    sqlite3_finalize(stmt);
     return success;
 }
 
@@ -74,9 +73,9 @@ bool ReservationRepository::updateReservation(const Reservation &reservation)
         "is_fulfilled=?, is_cancelled=?, status=? "
         "WHERE reservation_id=?;";
 
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, sql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
     {
         cerr << "Failed to prepare UPDATE: " << sqlite3_errmsg(db) << endl;
         return false;
@@ -94,7 +93,6 @@ bool ReservationRepository::updateReservation(const Reservation &reservation)
 
         cerr << "Failed to bind parameters for UPDATE: "
              << sqlite3_errmsg(db) << endl;
-        sqlite3_finalize(stmt);
         return false;
     }
 
@@ -102,7 +100,6 @@ bool ReservationRepository::updateReservation(const Reservation &reservation)
     if (!success)
         cerr << "Failed to execute UPDATE: " << sqlite3_errmsg(db) << endl;
 
-    sqlite3_finalize(stmt);
     return success;
 }
 
@@ -116,9 +113,9 @@ bool ReservationRepository::deleteReservation(int reservationId)
     const char *sql =
         "DELETE FROM reservations WHERE reservation_id=?;";
 
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, sql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
     {
         cerr << "Failed to prepare DELETE: " << sqlite3_errmsg(db) << endl;
         return false;
@@ -127,7 +124,6 @@ bool ReservationRepository::deleteReservation(int reservationId)
     if (sqlite3_bind_int(stmt, 1, reservationId) != SQLITE_OK)
     {
         cerr << "Failed to bind reservationId: " << sqlite3_errmsg(db) << endl;
-        sqlite3_finalize(stmt);
         return false;
     }
 
@@ -135,7 +131,6 @@ bool ReservationRepository::deleteReservation(int reservationId)
     if (!success)
         cerr << "Failed to execute DELETE: " << sqlite3_errmsg(db) << endl;
 
-    sqlite3_finalize(stmt);
     return success;
 }
 
@@ -151,9 +146,9 @@ std::unique_ptr<Reservation> ReservationRepository::getById(int reservationId)
         "is_fulfilled, is_cancelled, status "
         "FROM reservations WHERE reservation_id=?;";
 
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, sql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
     {
         cerr << "Failed to prepare SELECT: " << sqlite3_errmsg(db) << endl;
         return nullptr;
@@ -162,7 +157,6 @@ std::unique_ptr<Reservation> ReservationRepository::getById(int reservationId)
     if (sqlite3_bind_int(stmt, 1, reservationId) != SQLITE_OK)
     {
         cerr << "Failed to bind reservationId: " << sqlite3_errmsg(db) << endl;
-        sqlite3_finalize(stmt);
         return nullptr;
     }
 
@@ -187,7 +181,6 @@ std::unique_ptr<Reservation> ReservationRepository::getById(int reservationId)
             safeText(stmt, 7));
     }
 
-    sqlite3_finalize(stmt);
     return reservation;
 }
 
@@ -205,9 +198,9 @@ std::vector<Reservation> ReservationRepository::getByUserId(int userId)
         "is_fulfilled, is_cancelled, status "
         "FROM reservations WHERE user_id=?;";
 
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, sql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
     {
         cerr << "Failed to prepare SELECT BY USER: " << sqlite3_errmsg(db) << endl;
         return reservations;
@@ -216,7 +209,6 @@ std::vector<Reservation> ReservationRepository::getByUserId(int userId)
     if (sqlite3_bind_int(stmt, 1, userId) != SQLITE_OK)
     {
         cerr << "Failed to bind userId: " << sqlite3_errmsg(db) << endl;
-        sqlite3_finalize(stmt);
         return reservations;
     }
 
@@ -239,7 +231,6 @@ std::vector<Reservation> ReservationRepository::getByUserId(int userId)
             safeText(stmt, 7));
     }
 
-    sqlite3_finalize(stmt);
     return reservations;
 }
 
@@ -257,9 +248,9 @@ std::vector<Reservation> ReservationRepository::getByResourceId(int resourceId)
         "is_fulfilled, is_cancelled, status "
         "FROM reservations WHERE resource_id=?;";
 
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, sql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
     {
         cerr << "Failed to prepare SELECT BY RESOURCE: " << sqlite3_errmsg(db) << endl;
         return reservations;
@@ -268,7 +259,6 @@ std::vector<Reservation> ReservationRepository::getByResourceId(int resourceId)
     if (sqlite3_bind_int(stmt, 1, resourceId) != SQLITE_OK)
     {
         cerr << "Failed to bind resourceId: " << sqlite3_errmsg(db) << endl;
-        sqlite3_finalize(stmt);
         return reservations;
     }
 
@@ -291,7 +281,6 @@ std::vector<Reservation> ReservationRepository::getByResourceId(int resourceId)
             safeText(stmt, 7));
     }
 
-    sqlite3_finalize(stmt);
     return reservations;
 }
 
@@ -299,22 +288,19 @@ std::vector<Reservation> ReservationRepository::getByResourceId(int resourceId)
                     ---------- GET ALL RESERVATIONS ----------
    *************************************************************************  */
 
-std::vector<Reservation> ReservationRepository::getAllReservations()
+bool ReservationRepository::forEachReservation(const std::function<void(const Reservation &)> &visit)
 {
-
-    std::vector<Reservation> reservations;
-
     const char *sql =
         "SELECT reservation_id, user_id, resource_id, reservation_date, expiry_date, "
         "is_fulfilled, is_cancelled, status "
         "FROM reservations;";
 
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, sql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
     {
         cerr << "Failed to prepare SELECT ALL: " << sqlite3_errmsg(db) << endl;
-        return reservations;
+        return false;
     }
 
     auto safeText = [](sqlite3_stmt *stmt, int col) -> string
@@ -323,9 +309,10 @@ std::vector<Reservation> ReservationRepository::getAllReservations()
         return text ? reinterpret_cast<const char *>(text) : "";
     };
 
-    while (sqlite3_step(stmt) == SQLITE_ROW)
+    int rc;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
     {
-        reservations.emplace_back(
+        Reservation row(
             sqlite3_column_int(stmt, 0),
             sqlite3_column_int(stmt, 1),
             sqlite3_column_int(stmt, 2),
@@ -334,10 +321,20 @@ std::vector<Reservation> ReservationRepository::getAllReservations()
             sqlite3_column_int(stmt, 5) == 1,
             sqlite3_column_int(stmt, 6) == 1,
             safeText(stmt, 7));
+        visit(row);
     }
 
-    sqlite3_finalize(stmt);
-    return reservations;
+    return rc == SQLITE_DONE;
+}
+
+std::vector<Reservation> ReservationRepository::getAllReservations()
+{
+    std::vector<Reservation> results;
+    forEachReservation([&results](const Reservation &item)
+    {
+        results.push_back(item);
+    });
+    return results;
 }
 
 /* *************************************************************************
@@ -351,4 +348,73 @@ bool ReservationRepository::save(Reservation &reservation)
         return insertReservation(reservation);
     }
     return updateReservation(reservation);
-}
\ No newline at end of file
+}
+
+/* *************************************************************************
+                  ---------- RESERVATIONS BY EXPIRY ----------
+   *************************************************************************  */
+
+vector<Reservation> ReservationRepository::readRows(sqlite3_stmt *stmt)
+{
+    vector<Reservation> reservations;
+
+    auto safeText = [](sqlite3_stmt *stmt, int col) -> string
+    {
+        const unsigned char *text = sqlite3_column_text(stmt, col);
+        return text ? reinterpret_cast<const char *>(text) : "";
+    };
+
+    while (sqlite3_step(stmt) == SQLITE_ROW)
+    {
+        reservations.emplace_back(
+            sqlite3_column_int(stmt, 0),
+            sqlite3_column_int(stmt, 1),
+            sqlite3_column_int(stmt, 2),
+            safeText(stmt, 3),
+            safeText(stmt, 4),
+            sqlite3_column_int(stmt, 5) == 1,
+            sqlite3_column_int(stmt, 6) == 1,
+            safeText(stmt, 7));
+    }
+
+    return reservations;
+}
+
+vector<Reservation> ReservationRepository::getExpiredBefore(const CivilDate &today)
+{
+    const char *sql =
+        "SELECT reservation_id, user_id, resource_id, reservation_date, expiry_date, "
+        "is_fulfilled, is_cancelled, status "
+        "FROM reservations WHERE status = 'PENDING' AND expiry_day < ? ORDER BY expiry_day;";
+
+    CachedStatement stmt(statements, sql);
+
+    if (!stmt)
+    {
+        cerr << "Failed to prepare SELECT EXPIRED: " << sqlite3_errmsg(db) << endl;
+        return {};
+    }
+
+    sqlite3_bind_int(stmt, 1, today.getDaysSinceEpoch());
+    return readRows(stmt);
+}
+
+vector<Reservation> ReservationRepository::getExpiringBetween(const CivilDate &from, const CivilDate &to)
+{
+    const char *sql =
+        "SELECT reservation_id, user_id, resource_id, reservation_date, expiry_date, "
+        "is_fulfilled, is_cancelled, status "
+        "FROM reservations WHERE status = 'PENDING' AND expiry_day BETWEEN ? AND ? ORDER BY expiry_day;";
+
+    CachedStatement stmt(statements, sql);
+
+    if (!stmt)
+    {
+        cerr << "Failed to prepare SELECT EXPIRING: " << sqlite3_errmsg(db) << endl;
+        return {};
+    }
+
+    sqlite3_bind_int(stmt, 1, from.getDaysSinceEpoch());
+    sqlite3_bind_int(stmt, 2, to.getDaysSinceEpoch());
+    return readRows(stmt);
+}
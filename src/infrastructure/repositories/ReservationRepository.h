@@ -3,18 +3,23 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <functional>
+#include "../database/StatementCache.h"
 #include "../../domain/Reservation.h"
+#include "../../Utility/CivilDate.h"
 
 class ReservationRepository
 {
 private:
     sqlite3 *db;
+    StatementCache &statements;
 
     bool insertReservation(Reservation &reservation);
     bool updateReservation(const Reservation &reservation);
+    std::vector<Reservation> readRows(sqlite3_stmt *stmt);
 
 public:
-    explicit ReservationRepository(sqlite3 *connection);
+    explicit ReservationRepository(sqlite3 *connection, StatementCache &statementCache);
     ~ReservationRepository();
 
     bool save(Reservation &reservation);
@@ -24,4 +29,10 @@ public:
     std::vector<Reservation> getByUserId(int userId);
     std::vector<Reservation> getByResourceId(int resourceId);
     std::vector<Reservation> getAllReservations();
+    bool forEachReservation(const std::function<void(const Reservation &)> &visit);
+
+    // Open (PENDING) holds by expiry, as index range scans over expiry_day
+    // (schema version 4). Bounds are inclusive; results are in expiry order.
+    std::vector<Reservation> getExpiredBefore(const CivilDate &today);
+    std::vector<Reservation> getExpiringBetween(const CivilDate &from, const CivilDate &to);
 };
\ No newline at end of file
@@ -0,0 +1,75 @@
+#include "ResourceCache.h"
+#include <iterator>
+
+ResourceCache::ResourceCache(std::size_t maxEntries) : capacity(maxEntries)
+{
+    index.reserve(capacity);
+}
+
+bool ResourceCache::get(int resourceId, Resource &out)
+{
+    auto found = index.find(resourceId);
+    if (found == index.end())
+    {
+        stats.misses++;
+        return false;
+    }
+
+    entries.splice(entries.begin(), entries, found->second);
+    out = *found->second;
+    stats.hits++;
+    return true;
+}
+
+void ResourceCache::put(const Resource &resource)
+{
+    if (capacity == 0)
+        return;
+
+    auto found = index.find(resource.getResourceId());
+    if (found != index.end())
+    {
+        *found->second = resource;
+        entries.splice(entries.begin(), entries, found->second);
+        return;
+    }
+
+    if (entries.size() >= capacity)
+    {
+        // Reuse the evicted node instead of freeing it and allocating a new one.
+        auto oldest = std::prev(entries.end());
+        index.erase(oldest->getResourceId());
+        *oldest = resource;
+        entries.splice(entries.begin(), entries, oldest);
+        stats.evictions++;
+    }
+    else
+    {
+        entries.push_front(resource);
+    }
+    index[resource.getResourceId()] = entries.begin();
+}
+
+void ResourceCache::erase(int resourceId)
+{
+    auto found = index.find(resourceId);
+    if (found == index.end())
+        return;
+
+    entries.erase(found->second);
+    index.erase(found);
+}
+
+void ResourceCache::clear()
+{
+    entries.clear();
+    index.clear();
+}
+
+ResourceCacheStats ResourceCache::getStats() const
+{
+    ResourceCacheStats current = stats;
+    current.size = entries.size();
+    current.capacity = capacity;
+    return current;
+}
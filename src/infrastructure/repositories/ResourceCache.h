@@ -0,0 +1,44 @@
+#pragma once
+#include <cstddef>
+#include <list>
+#include <unordered_map>
+#include "../../domain/Resource.h"
+
+struct ResourceCacheStats
+{
+    std::size_t hits = 0;
+    std::size_t misses = 0;
+    std::size_t evictions = 0;
+    std::size_t size = 0;
+    std::size_t capacity = 0;
+
+    double hitRate() const { return hits + misses > 0 ? static_cast<double>(hits) / (hits + misses) : 0.0; }
+};
+
+// Fixed-capacity LRU map of resource id -> Resource. The list holds the
+// entries most recently used first; the map points into it, so a lookup is
+// one hash probe plus a splice. Capacity 0 turns the cache off.
+class ResourceCache
+{
+private:
+    std::list<Resource> entries;
+    std::unordered_map<int, std::list<Resource>::iterator> index;
+    std::size_t capacity;
+    ResourceCacheStats stats;
+
+public:
+    static constexpr std::size_t defaultCapacity = 4096;
+
+    explicit ResourceCache(std::size_t maxEntries = defaultCapacity);
+
+    // Copies the cached resource into out and marks it most recently used.
+    bool get(int resourceId, Resource &out);
+
+    // Inserts or refreshes an entry, evicting the least recently used one when full.
+    void put(const Resource &resource);
+
+    void erase(int resourceId);
+    void clear();
+
+    ResourceCacheStats getStats() const;
+};
@@ -1,5 +1,8 @@
 #include "ResourceRepository.h"
+#include "ArenaColumn.h"
 #include <iostream>
+#include <algorithm>
+#include <cctype>
 
 using namespace std;
 
@@ -15,11 +18,47 @@ string safeText(sqlite3_stmt *stmt, int col)
     return string(reinterpret_cast<const char *>(txt));
 }
 
+/* *************************************************************************
+              ---------- HELPER FOR FULL-TEXT QUERIES ----------
+   *************************************************************************  */
+
+// Turns free text into an FTS5 expression: each word becomes a quoted prefix
+// term ("harr"*), so punctuation typed by the user can never break the syntax.
+static string buildMatchExpression(const string &keywords)
+{
+    string expression;
+    string word;
+
+    auto flush = [&]()
+    {
+        if (word.empty())
+            return;
+        if (!expression.empty())
+            expression += ' ';
+        expression += '"' + word + "\"*";
+        word.clear();
+    };
+
+    for (char c : keywords)
+    {
+        unsigned char uc = static_cast<unsigned char>(c);
+        // Bytes >= 0x80 belong to UTF-8 letters and are kept as-is.
+        if (isalnum(uc) || uc >= 0x80)
+            word += c;
+        else
+            flush();
+    }
+    flush();
+
+    return expression;
+}
+
 /* *************************************************************************
                  ---------- CONSTRUCTORS & DESTRUCTORS ----------
    *************************************************************************  */
 
-ResourceRepository::ResourceRepository(sqlite3 *connection) : db(connection)
+ResourceRepository::ResourceRepository(sqlite3 *connection, StatementCache &statementCache, size_t cacheCapacity)
+    : db(connection), statements(statementCache), cache(cacheCapacity), dataVersion(-1), snapshotLoaded(false)
 {
     // Enables foreign keys
     sqlite3_exec(db, "PRAGMA foreign_keys = ON;", nullptr, nullptr, nullptr);
@@ -27,45 +66,95 @@ ResourceRepository::ResourceRepository(sqlite3 *connection) : db(connection)
 
 ResourceRepository::~ResourceRepository() {}
 
+/* *************************************************************************
+                     ---------- CACHE COHERENCE ----------
+   *************************************************************************  */
+
+// Only committed rows are cached. Inside an open transaction the entry is just
+// dropped, so a ROLLBACK can never leave a value behind that the table no
+// longer holds; the next read after the commit reloads it.
+void ResourceRepository::cacheWrite(const Resource &resource)
+{
+    if (sqlite3_get_autocommit(db))
+        cache.put(resource);
+    else
+        cache.erase(resource.getResourceId());
+}
+
+// PRAGMA data_version moves only when another connection commits, such as
+// the pool's writer, a desk server or a second console. This repository's
+// own writes already keep the cache and snapshot current, so any change means
+// they may hold rows the table no longer has. Which rows is unknown, so both
+// start over.
+void ResourceRepository::syncWithOtherWriters()
+{
+    CachedStatement stmt(statements, "PRAGMA data_version;");
+    long long version = (stmt && sqlite3_step(stmt) == SQLITE_ROW) ? sqlite3_column_int64(stmt, 0) : -1;
+    if (version == dataVersion && version != -1)
+        return;
+
+    dataVersion = version;
+    cache.clear();
+    snapshotLoaded = false;
+    snapshotStale.clear();
+}
+
+/* *************************************************************************
+                   ---------- BIND RESOURCE COLUMNS ----------
+   *************************************************************************  */
+
+static const char *insertResourceSql =
+    "INSERT INTO resources (title, author, publisher, publication_year, isbn, category_id,"
+    " total_copies, available_copies, description, added_date, is_active)"
+    " VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?);";
+
+static const char *updateResourceSql =
+    "UPDATE resources SET "
+    "title=?, author=?, publisher=?, publication_year=?, isbn=?, category_id=?, "
+    "total_copies=?, available_copies=?, description=?, added_date=?, is_active=? "
+    "WHERE resource_id=?;";
+
+// Parameters 1-11 are shared by the INSERT and the UPDATE; the UPDATE adds the id as 12.
+bool ResourceRepository::bindResource(sqlite3_stmt *stmt, const Resource &resource)
+{
+    return sqlite3_bind_text(stmt, 1, resource.getTitle().c_str(), -1, SQLITE_TRANSIENT) == SQLITE_OK &&
+           sqlite3_bind_text(stmt, 2, resource.getAuthor().c_str(), -1, SQLITE_TRANSIENT) == SQLITE_OK &&
+           sqlite3_bind_text(stmt, 3, resource.getPublisher().c_str(), -1, SQLITE_TRANSIENT) == SQLITE_OK &&
+           sqlite3_bind_int(stmt, 4, resource.getPublicationYear()) == SQLITE_OK &&
+           sqlite3_bind_text(stmt, 5, resource.getIsbn().c_str(), -1, SQLITE_TRANSIENT) == SQLITE_OK &&
+           sqlite3_bind_int(stmt, 6, resource.getCategoryId()) == SQLITE_OK &&
+           sqlite3_bind_int(stmt, 7, resource.getTotalCopies()) == SQLITE_OK &&
+           sqlite3_bind_int(stmt, 8, resource.getAvailableCopies()) == SQLITE_OK &&
+           sqlite3_bind_text(stmt, 9, resource.getDescription().c_str(), -1, SQLITE_TRANSIENT) == SQLITE_OK &&
+           sqlite3_bind_text(stmt, 10, resource.getAddedDate().c_str(), -1, SQLITE_TRANSIENT) == SQLITE_OK &&
+           sqlite3_bind_int(stmt, 11, resource.getIsActive() ? 1 : 0) == SQLITE_OK;
+}
+
 /* *************************************************************************
                      ---------- INSERT RESOURCES ----------
    *************************************************************************  */
 
 bool ResourceRepository::insertResource(Resource &resource)
 {
-    const char *sql =
-        "INSERT INTO resources (title, author, publisher, publication_year, isbn, category_id,"
-        " total_copies, available_copies, description, added_date, is_active)"
-        " VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?);";
-
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, insertResourceSql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
     {
         cerr << sqlite3_errmsg(db) << endl;
         return false;
     }
 
-    sqlite3_bind_text(stmt, 1, resource.getTitle().c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(stmt, 2, resource.getAuthor().c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(stmt, 3, resource.getPublisher().c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_int(stmt, 4, resource.getPublicationYear());
-    sqlite3_bind_text(stmt, 5, resource.getIsbn().c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_int(stmt, 6, resource.getCategoryId());
-    sqlite3_bind_int(stmt, 7, resource.getTotalCopies());
-    sqlite3_bind_int(stmt, 8, resource.getAvailableCopies());
-    sqlite3_bind_text(stmt, 9, resource.getDescription().c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(stmt, 10, resource.getAddedDate().c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_int(stmt, 11, resource.getIsActive() ? 1 : 0);
-
-    bool success = (sqlite3_step(stmt) == SQLITE_DONE);
+    bool success = bindResource(stmt, resource) && sqlite3_step(stmt) == SQLITE_DONE;
 
     if (success)
+    {
         resource.setResourceId((int)sqlite3_last_insert_rowid(db));
+        cacheWrite(resource);
+        snapshotChanged(resource.getResourceId());
+    }
     else
         cerr << "Insert failed: " << sqlite3_errmsg(db) << endl;
 
-    sqlite3_finalize(stmt);
     return success;
 }
 
@@ -75,39 +164,27 @@ bool ResourceRepository::insertResource(Resource &resource)
 
 bool ResourceRepository::updateResource(const Resource &resource)
 {
-    const char *sql =
-        "UPDATE resources SET "
-        "title=?, author=?, publisher=?, publication_year=?, isbn=?, category_id=?, "
-        "total_copies=?, available_copies=?, description=?, added_date=?, is_active=? "
-        "WHERE resource_id=?;";
+    CachedStatement stmt(statements, updateResourceSql);
 
-    sqlite3_stmt *stmt = nullptr;
-
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
     {
         cerr << sqlite3_errmsg(db) << endl;
         return false;
     }
 
-    sqlite3_bind_text(stmt, 1, resource.getTitle().c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(stmt, 2, resource.getAuthor().c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(stmt, 3, resource.getPublisher().c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_int(stmt, 4, resource.getPublicationYear());
-    sqlite3_bind_text(stmt, 5, resource.getIsbn().c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_int(stmt, 6, resource.getCategoryId());
-    sqlite3_bind_int(stmt, 7, resource.getTotalCopies());
-    sqlite3_bind_int(stmt, 8, resource.getAvailableCopies());
-    sqlite3_bind_text(stmt, 9, resource.getDescription().c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(stmt, 10, resource.getAddedDate().c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_int(stmt, 11, resource.getIsActive() ? 1 : 0);
-    sqlite3_bind_int(stmt, 12, resource.getResourceId());
-
-    bool success = (sqlite3_step(stmt) == SQLITE_DONE);
+    bool success = bindResource(stmt, resource) &&
+                   sqlite3_bind_int(stmt, 12, resource.getResourceId()) == SQLITE_OK &&
+                   sqlite3_step(stmt) == SQLITE_DONE;
 
-    if (!success)
+    snapshotChanged(resource.getResourceId());
+    if (success)
+        cacheWrite(resource);
+    else
+    {
+        cache.erase(resource.getResourceId());
         cerr << "Update failed: " << sqlite3_errmsg(db) << endl;
+    }
 
-    sqlite3_finalize(stmt);
     return success;
 }
 
@@ -122,6 +199,39 @@ bool ResourceRepository::save(Resource &resource)
     return updateResource(resource);
 }
 
+bool ResourceRepository::saveAll(vector<Resource> &resources, BatchSaveResult &result)
+{
+    CachedStatement insertStmt(statements, insertResourceSql);
+    CachedStatement updateStmt(statements, updateResourceSql);
+
+    if (!insertStmt || !updateStmt)
+    {
+        cerr << "Failed to prepare batch save: " << sqlite3_errmsg(db) << endl;
+        return false;
+    }
+
+    // Rows are committed only when the savepoint is released, so the batch
+    // just invalidates what it touches.
+    return runBatchSave(db, resources.size(), result, [&](size_t i)
+                        {
+                            Resource &resource = resources[i];
+                            bool isNew = resource.getResourceId() == 0;
+                            if (!isNew)
+                                cache.erase(resource.getResourceId());
+                            sqlite3_stmt *stmt = isNew ? insertStmt : updateStmt;
+
+                            bool success = bindResource(stmt, resource) &&
+                                           (isNew || sqlite3_bind_int(stmt, 12, resource.getResourceId()) == SQLITE_OK) &&
+                                           sqlite3_step(stmt) == SQLITE_DONE;
+                            sqlite3_reset(stmt);
+
+                            if (success && isNew)
+                                resource.setResourceId(static_cast<int>(sqlite3_last_insert_rowid(db)));
+                            if (success)
+                                snapshotChanged(resource.getResourceId());
+                            return success; });
+}
+
 /* *************************************************************************
                      ---------- DELETE RESOURCES ----------
    *************************************************************************  */
@@ -129,9 +239,9 @@ bool ResourceRepository::save(Resource &resource)
 bool ResourceRepository::deleteResource(int resourceId)
 {
     const char *sql = "DELETE FROM resources WHERE resource_id=?;";
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, sql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
     {
         cerr << sqlite3_errmsg(db) << endl;
         return false;
@@ -139,12 +249,13 @@ bool ResourceRepository::deleteResource(int resourceId)
 
     sqlite3_bind_int(stmt, 1, resourceId);
 
+    cache.erase(resourceId);
+    snapshotChanged(resourceId);
     bool success = (sqlite3_step(stmt) == SQLITE_DONE);
 
     if (!success)
         cerr << "Delete failed: " << sqlite3_errmsg(db) << endl;
 
-    sqlite3_finalize(stmt);
     return success;
 }
 
@@ -154,14 +265,26 @@ bool ResourceRepository::deleteResource(int resourceId)
 
 unique_ptr<Resource> ResourceRepository::getById(int resourceId)
 {
+    unique_ptr<Resource> resource = make_unique<Resource>();
+
+    // Inside a transaction the caller is about to read-modify-write the row
+    // (available_copies on borrow and return), so it must see the table.
+    bool committed = sqlite3_get_autocommit(db) != 0;
+    if (committed)
+    {
+        syncWithOtherWriters();
+        if (cache.get(resourceId, *resource))
+            return resource;
+    }
+
     const char *sql =
         "SELECT resource_id, title, author, publisher, publication_year, isbn,"
         " category_id, total_copies, available_copies, description, added_date, is_active "
         "FROM resources WHERE resource_id=?;";
 
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, sql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
     {
         cerr << sqlite3_errmsg(db) << endl;
         return nullptr;
@@ -169,11 +292,59 @@ unique_ptr<Resource> ResourceRepository::getById(int resourceId)
 
     sqlite3_bind_int(stmt, 1, resourceId);
 
-    unique_ptr<Resource> resource = nullptr;
+    if (sqlite3_step(stmt) != SQLITE_ROW)
+        return nullptr;
+
+    *resource = Resource(
+        sqlite3_column_int(stmt, 0),
+        safeText(stmt, 1),
+        safeText(stmt, 2),
+        safeText(stmt, 3),
+        sqlite3_column_int(stmt, 4),
+        safeText(stmt, 5),
+        sqlite3_column_int(stmt, 6),
+        sqlite3_column_int(stmt, 7),
+        sqlite3_column_int(stmt, 8),
+        safeText(stmt, 9),
+        safeText(stmt, 10),
+        sqlite3_column_int(stmt, 11) == 1);
+
+    // A row read inside a transaction may carry that transaction's own
+    // uncommitted changes, so it is only cached from autocommit reads.
+    if (committed)
+        cache.put(*resource);
+
+    return resource;
+}
+
+/* *************************************************************************
+                     ---------- GET ALL RESOURCES ----------
+   *************************************************************************  */
+
+bool ResourceRepository::forEachResource(const function<void(const Resource &)> &visit)
+{
+    const char *sql =
+        "SELECT resource_id, title, author, publisher, publication_year, isbn,"
+        "category_id, total_copies, available_copies, description, added_date, is_active "
+        "FROM resources;";
+
+    CachedStatement stmt(statements, sql);
+
+    if (!stmt)
+    {
+        cerr << sqlite3_errmsg(db) << endl;
+        return false;
+    }
 
-    if (sqlite3_step(stmt) == SQLITE_ROW)
+    return visitRows(stmt, visit);
+}
+
+bool ResourceRepository::visitRows(sqlite3_stmt *stmt, const function<void(const Resource &)> &visit)
+{
+    int rc;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
     {
-        resource = make_unique<Resource>(
+        Resource row(
             sqlite3_column_int(stmt, 0),
             safeText(stmt, 1),
             safeText(stmt, 2),
@@ -186,33 +357,118 @@ unique_ptr<Resource> ResourceRepository::getById(int resourceId)
             safeText(stmt, 9),
             safeText(stmt, 10),
             sqlite3_column_int(stmt, 11) == 1);
+        visit(row);
     }
 
-    sqlite3_finalize(stmt);
-    return resource;
+    return rc == SQLITE_DONE;
+}
+
+vector<Resource> ResourceRepository::getAll()
+{
+    vector<Resource> results;
+    forEachResource([&results](const Resource &item)
+    {
+        results.push_back(item);
+    });
+    return results;
 }
 
 /* *************************************************************************
-                     ---------- GET ALL RESOURCES ----------
+                  ---------- KEYSET PAGES OF RESOURCES ----------
    *************************************************************************  */
 
-vector<Resource> ResourceRepository::getAll()
+// Pages are addressed by the last (or first) id already shown rather than by
+// OFFSET, so every page is a primary-key range scan no matter how deep it is.
+vector<Resource> ResourceRepository::getPageAfter(int afterId, int limit)
 {
-    vector<Resource> results;
+    vector<Resource> page;
 
     const char *sql =
         "SELECT resource_id, title, author, publisher, publication_year, isbn,"
         "category_id, total_copies, available_copies, description, added_date, is_active "
-        "FROM resources;";
+        "FROM resources WHERE resource_id > ? ORDER BY resource_id LIMIT ?;";
+
+    CachedStatement stmt(statements, sql);
+
+    if (!stmt)
+    {
+        cerr << "Failed to prepare page query: " << sqlite3_errmsg(db) << endl;
+        return page;
+    }
+
+    sqlite3_bind_int(stmt, 1, afterId);
+    sqlite3_bind_int(stmt, 2, limit);
+
+    visitRows(stmt, [&page](const Resource &item)
+    {
+        page.push_back(item);
+    });
+    return page;
+}
+
+vector<Resource> ResourceRepository::getPageBefore(int beforeId, int limit)
+{
+    vector<Resource> page;
+
+    const char *sql =
+        "SELECT resource_id, title, author, publisher, publication_year, isbn,"
+        "category_id, total_copies, available_copies, description, added_date, is_active "
+        "FROM resources WHERE resource_id < ? ORDER BY resource_id DESC LIMIT ?;";
+
+    CachedStatement stmt(statements, sql);
+
+    if (!stmt)
+    {
+        cerr << "Failed to prepare page query: " << sqlite3_errmsg(db) << endl;
+        return page;
+    }
 
-    sqlite3_stmt *stmt = nullptr;
+    sqlite3_bind_int(stmt, 1, beforeId);
+    sqlite3_bind_int(stmt, 2, limit);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    visitRows(stmt, [&page](const Resource &item)
+    {
+        page.push_back(item);
+    });
+
+    // Rows arrive highest id first; hand them back in ascending order.
+    reverse(page.begin(), page.end());
+    return page;
+}
+
+/* *************************************************************************
+                     ---------- SEARCH RESOURCES ----------
+   *************************************************************************  */
+
+vector<Resource> ResourceRepository::search(const string &keywords, int limit, int offset)
+{
+    vector<Resource> results;
+
+    string expression = buildMatchExpression(keywords);
+    if (expression.empty())
+        return results;
+
+    // bm25 weights follow the column order: title, author, publisher, isbn, description.
+    const char *sql =
+        "SELECT r.resource_id, r.title, r.author, r.publisher, r.publication_year, r.isbn,"
+        " r.category_id, r.total_copies, r.available_copies, r.description, r.added_date, r.is_active "
+        "FROM resources_fts JOIN resources r ON r.resource_id = resources_fts.rowid "
+        "WHERE resources_fts MATCH ? AND r.is_active = 1 "
+        "ORDER BY bm25(resources_fts, 10.0, 6.0, 2.0, 8.0, 1.0) "
+        "LIMIT ? OFFSET ?;";
+
+    CachedStatement stmt(statements, sql);
+
+    if (!stmt)
     {
         cerr << sqlite3_errmsg(db) << endl;
         return results;
     }
 
+    sqlite3_bind_text(stmt, 1, expression.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_int(stmt, 2, limit);
+    sqlite3_bind_int(stmt, 3, offset);
+
     while (sqlite3_step(stmt) == SQLITE_ROW)
     {
         results.emplace_back(
@@ -230,6 +486,117 @@ vector<Resource> ResourceRepository::getAll()
             sqlite3_column_int(stmt, 11) == 1);
     }
 
-    sqlite3_finalize(stmt);
     return results;
-}
\ No newline at end of file
+}
+
+/* *************************************************************************
+                    ---------- CATALOGUE SNAPSHOT ----------
+   *************************************************************************  */
+
+static const char *snapshotAllSql =
+    "SELECT resource_id, title, author, publisher, category_id, total_copies, available_copies, is_active "
+    "FROM resources ORDER BY resource_id;";
+
+static const char *snapshotRowSql =
+    "SELECT resource_id, title, author, publisher, category_id, total_copies, available_copies, is_active "
+    "FROM resources WHERE resource_id=?;";
+
+void ResourceRepository::snapshotChanged(int resourceId)
+{
+    // Before the first load there is nothing to patch.
+    if (!snapshotLoaded)
+        return;
+
+    // Past a quarter of the catalogue the next call rebuilds anyway, so stop
+    // collecting ids and let it.
+    if (snapshotStale.size() >= snapshot.rowCount() / 4)
+    {
+        snapshotLoaded = false;
+        snapshotStale.clear();
+        return;
+    }
+    snapshotStale.push_back(resourceId);
+}
+
+static void upsertSnapshotRow(CatalogueSnapshot &snapshot, sqlite3_stmt *stmt)
+{
+    snapshot.upsert(sqlite3_column_int(stmt, 0), columnText(stmt, 1), columnText(stmt, 2), columnText(stmt, 3),
+                    sqlite3_column_int(stmt, 4), sqlite3_column_int(stmt, 5), sqlite3_column_int(stmt, 6),
+                    sqlite3_column_int(stmt, 7) == 1);
+}
+
+bool ResourceRepository::loadSnapshot()
+{
+    snapshot.clear();
+
+    CachedStatement countStmt(statements, "SELECT COUNT(*) FROM resources;");
+    if (countStmt && sqlite3_step(countStmt) == SQLITE_ROW)
+        snapshot.reserve(static_cast<size_t>(sqlite3_column_int64(countStmt, 0)));
+
+    CachedStatement stmt(statements, snapshotAllSql);
+
+    if (!stmt)
+    {
+        cerr << "Failed to prepare catalogue snapshot: " << sqlite3_errmsg(db) << endl;
+        return false;
+    }
+
+    int rc;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
+        upsertSnapshotRow(snapshot, stmt);
+
+    if (rc != SQLITE_DONE)
+    {
+        cerr << "Failed to load catalogue snapshot: " << sqlite3_errmsg(db) << endl;
+        return false;
+    }
+    return true;
+}
+
+bool ResourceRepository::reloadSnapshotRow(int resourceId)
+{
+    CachedStatement stmt(statements, snapshotRowSql);
+
+    if (!stmt)
+    {
+        cerr << "Failed to prepare catalogue snapshot: " << sqlite3_errmsg(db) << endl;
+        return false;
+    }
+
+    sqlite3_bind_int(stmt, 1, resourceId);
+
+    int rc = sqlite3_step(stmt);
+    if (rc == SQLITE_ROW)
+        upsertSnapshotRow(snapshot, stmt);
+    else if (rc == SQLITE_DONE)
+        snapshot.remove(resourceId);
+    else
+        return false;
+    return true;
+}
+
+const CatalogueSnapshot &ResourceRepository::getCatalogueSnapshot()
+{
+    // Rows read inside an open transaction may still be rolled back, so in
+    // that case nothing is marked as up to date and the next call re-reads.
+    bool committed = sqlite3_get_autocommit(db) != 0;
+    syncWithOtherWriters();
+    size_t rows = snapshot.rowCount();
+
+    if (!snapshotLoaded || snapshotStale.size() > rows / 4 || snapshot.holeCount() > rows / 4)
+    {
+        snapshotStale.clear();
+        snapshotLoaded = loadSnapshot() && committed;
+        return snapshot;
+    }
+
+    bool ok = true;
+    for (int resourceId : snapshotStale)
+        ok = reloadSnapshotRow(resourceId) && ok;
+
+    if (!ok)
+        snapshotLoaded = false;
+    else if (committed)
+        snapshotStale.clear();
+    return snapshot;
+}
@@ -3,22 +3,69 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <functional>
+#include "../database/StatementCache.h"
 #include "../../domain/Resource.h"
+#include "../../Utility/StringArena.h"
+#include "BatchSave.h"
+#include "ResourceCache.h"
+#include "CatalogueSnapshot.h"
 
 class ResourceRepository
 {
 private:
     sqlite3 *db;
+    StatementCache &statements;
+    ResourceCache cache;
+    long long dataVersion; // PRAGMA data_version when the cache was last checked
+
+    CatalogueSnapshot snapshot;
+    bool snapshotLoaded;
+    std::vector<int> snapshotStale; // ids written since the snapshot was last refreshed
 
     bool insertResource(Resource &resource);
     bool updateResource(const Resource &resource);
+    bool bindResource(sqlite3_stmt *stmt, const Resource &resource);
+    bool visitRows(sqlite3_stmt *stmt, const std::function<void(const Resource &)> &visit);
+    void cacheWrite(const Resource &resource);
+    void syncWithOtherWriters();
+    void snapshotChanged(int resourceId);
+    bool loadSnapshot();
+    bool reloadSnapshotRow(int resourceId);
 
 public:
-    explicit ResourceRepository(sqlite3 *connection);
+    // getById is served from an LRU cache of cacheCapacity resources (0 = no
+    // cache). It is kept coherent by this repository's own writes, so every
+    // write on this connection must go through one ResourceRepository; a
+    // commit from any other connection empties it. Reads inside an open
+    // transaction always go to the table.
+    explicit ResourceRepository(sqlite3 *connection, StatementCache &statementCache,
+                                std::size_t cacheCapacity = ResourceCache::defaultCapacity);
     ~ResourceRepository();
 
     bool save(Resource &resource);
+    // Inserts new rows (id 0) and updates the rest in one transaction.
+    bool saveAll(std::vector<Resource> &resources, BatchSaveResult &result);
     bool deleteResource(int resourceId);
     std::unique_ptr<Resource> getById(int resourceId);
     std::vector<Resource> getAll();
+    // Calls visit once per row while the statement is still stepping, so
+    // callers can walk the whole table without holding it in memory.
+    bool forEachResource(const std::function<void(const Resource &)> &visit);
+    std::vector<Resource> getPageAfter(int afterId, int limit);
+    std::vector<Resource> getPageBefore(int beforeId, int limit);
+
+    // Full-text search over title, author, publisher, ISBN and description.
+    // Every word is prefix-matched; results are ranked best first and only
+    // active resources are returned.
+    std::vector<Resource> search(const std::string &keywords, int limit, int offset);
+
+    ResourceCacheStats getCacheStats() const { return cache.getStats(); }
+
+    // Columnar copy of the catalogue for browsing. The first call loads the
+    // whole table; later calls re-read only the resources this repository has
+    // written since (or rebuild if that is a large share of the catalogue, or
+    // another connection has committed).
+    // Row positions are valid until the next call.
+    const CatalogueSnapshot &getCatalogueSnapshot();
 };
\ No newline at end of file
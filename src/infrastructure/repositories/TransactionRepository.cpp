@@ -1,5 +1,7 @@
 #include "TransactionRepository.h"
+#include "ArenaColumn.h"
 #include <iostream>
+#include <algorithm>
 
 using namespace std;
 
@@ -8,7 +10,8 @@ using namespace std;
    *************************************************************************  */
 
 // this does not open the database, it only stores the pointer.
-TransactionRepository::TransactionRepository(sqlite3 *connection) : db(connection) {}
+TransactionRepository::TransactionRepository(sqlite3 *connection, StatementCache &statementCache)
+    : db(connection), statements(statementCache) {}
 TransactionRepository::~TransactionRepository() {}
 
 // ---------------------------- Transaction Control --------------------------------------- 
@@ -61,37 +64,51 @@ bool TransactionRepository::rollbackTransaction()
     return true;
 }
 
+/* *************************************************************************
+                 ---------- BIND TRANSACTION COLUMNS ----------
+   *************************************************************************  */
+
+static const char *insertTransactionSql =
+    "INSERT INTO transactions (user_id, resource_id, issue_date, due_date, return_date, "
+    "fine_amount, is_returned, is_overdue, renewal_count, transaction_status) "
+    "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?);";
+
+static const char *updateTransactionSql =
+    "UPDATE transactions SET user_id=?, resource_id=?, issue_date=?, due_date=?, return_date=?, "
+    "fine_amount=?, is_returned=?, is_overdue=?, renewal_count=?, transaction_status=? "
+    "WHERE transaction_id=?;";
+
+// Parameters 1-10 are shared by the INSERT and the UPDATE; the UPDATE adds the id as 11.
+bool TransactionRepository::bindTransaction(sqlite3_stmt *stmt, const Transaction &transaction)
+{
+    return sqlite3_bind_int(stmt, 1, transaction.getUserId()) == SQLITE_OK &&
+           sqlite3_bind_int(stmt, 2, transaction.getResourceId()) == SQLITE_OK &&
+           sqlite3_bind_text(stmt, 3, transaction.getIssueDate().c_str(), -1, SQLITE_TRANSIENT) == SQLITE_OK &&
+           sqlite3_bind_text(stmt, 4, transaction.getDueDate().c_str(), -1, SQLITE_TRANSIENT) == SQLITE_OK &&
+           sqlite3_bind_text(stmt, 5, transaction.getReturnDate().c_str(), -1, SQLITE_TRANSIENT) == SQLITE_OK &&
+           sqlite3_bind_double(stmt, 6, transaction.getFineAmount()) == SQLITE_OK &&
+           sqlite3_bind_int(stmt, 7, transaction.getIsReturned()) == SQLITE_OK &&
+           sqlite3_bind_int(stmt, 8, transaction.getIsOverdue()) == SQLITE_OK &&
+           sqlite3_bind_int(stmt, 9, transaction.getRenewalCount()) == SQLITE_OK &&
+           sqlite3_bind_text(stmt, 10, transaction.getTransactionStatus().c_str(), -1, SQLITE_TRANSIENT) == SQLITE_OK;
+}
+
 /* *************************************************************************
                      ---------- INSERT TRANSACTIONS ----------
    *************************************************************************  */
 
 bool TransactionRepository::insertTransaction(Transaction &transaction)
 {
-    const char *sql =
-        "INSERT INTO transactions (user_id, resource_id, issue_date, due_date, return_date, "
-        "fine_amount, is_returned, is_overdue, renewal_count, transaction_status) "
-        "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?);";
-
-    sqlite3_stmt *stmt = nullptr;
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    CachedStatement stmt(statements, insertTransactionSql);
+    if (!stmt)
     {
         cerr << "Failed to prepare INSERT statement: " << sqlite3_errmsg(db) << endl;
         return false;
     }
 
-    if (sqlite3_bind_int(stmt, 1, transaction.getUserId()) != SQLITE_OK ||
-        sqlite3_bind_int(stmt, 2, transaction.getResourceId()) != SQLITE_OK ||
-        sqlite3_bind_text(stmt, 3, transaction.getIssueDate().c_str(), -1, SQLITE_TRANSIENT) != SQLITE_OK ||
-        sqlite3_bind_text(stmt, 4, transaction.getDueDate().c_str(), -1, SQLITE_TRANSIENT) != SQLITE_OK ||
-        sqlite3_bind_text(stmt, 5, transaction.getReturnDate().c_str(), -1, SQLITE_TRANSIENT) != SQLITE_OK ||
-        sqlite3_bind_double(stmt, 6, transaction.getFineAmount()) != SQLITE_OK ||
-        sqlite3_bind_int(stmt, 7, transaction.getIsReturned()) != SQLITE_OK ||
-        sqlite3_bind_int(stmt, 8, transaction.getIsOverdue()) != SQLITE_OK ||
-        sqlite3_bind_int(stmt, 9, transaction.getRenewalCount()) != SQLITE_OK ||
-        sqlite3_bind_text(stmt, 10, transaction.getTransactionStatus().c_str(), -1, SQLITE_TRANSIENT) != SQLITE_OK)
+    if (!bindTransaction(stmt, transaction))
     {
         cerr << "Failed to bind parameters for INSERT: " << sqlite3_errmsg(db) << endl;
-        sqlite3_finalize(stmt);
         return false;
     }
 
@@ -105,7 +122,6 @@ bool TransactionRepository::insertTransaction(Transaction &transaction)
         sqlite3_int64 lastId = sqlite3_last_insert_rowid(db);
         transaction.setTransactionId(static_cast<int>(lastId));
     }
-    sqlite3_finalize(stmt);
     return success;
 }
 
@@ -115,32 +131,17 @@ bool TransactionRepository::insertTransaction(Transaction &transaction)
 
 bool TransactionRepository::updateTransaction(const Transaction &transaction)
 {
-    const char *sql =
-        "UPDATE transactions SET user_id=?, resource_id=?, issue_date=?, due_date=?, return_date=?, "
-        "fine_amount=?, is_returned=?, is_overdue=?, renewal_count=?, transaction_status=? "
-        "WHERE transaction_id=?;";
-
-    sqlite3_stmt *stmt = nullptr;
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    CachedStatement stmt(statements, updateTransactionSql);
+    if (!stmt)
     {
         cerr << "Failed to prepare UPDATE statement: " << sqlite3_errmsg(db) << endl;
         return false;
     }
 
-    if (sqlite3_bind_int(stmt, 1, transaction.getUserId()) != SQLITE_OK ||
-        sqlite3_bind_int(stmt, 2, transaction.getResourceId()) != SQLITE_OK ||
-        sqlite3_bind_text(stmt, 3, transaction.getIssueDate().c_str(), -1, SQLITE_TRANSIENT) != SQLITE_OK ||
-        sqlite3_bind_text(stmt, 4, transaction.getDueDate().c_str(), -1, SQLITE_TRANSIENT) != SQLITE_OK ||
-        sqlite3_bind_text(stmt, 5, transaction.getReturnDate().c_str(), -1, SQLITE_TRANSIENT) != SQLITE_OK ||
-        sqlite3_bind_double(stmt, 6, transaction.getFineAmount()) != SQLITE_OK ||
-        sqlite3_bind_int(stmt, 7, transaction.getIsReturned()) != SQLITE_OK ||
-        sqlite3_bind_int(stmt, 8, transaction.getIsOverdue()) != SQLITE_OK ||
-        sqlite3_bind_int(stmt, 9, transaction.getRenewalCount()) != SQLITE_OK ||
-        sqlite3_bind_text(stmt, 10, transaction.getTransactionStatus().c_str(), -1, SQLITE_TRANSIENT) != SQLITE_OK ||
+    if (!bindTransaction(stmt, transaction) ||
         sqlite3_bind_int(stmt, 11, transaction.getTransactionId()) != SQLITE_OK)
     {
         cerr << "Failed to bind parameters for UPDATE: " << sqlite3_errmsg(db) << endl;
-        sqlite3_finalize(stmt);
         return false;
     }
 
@@ -150,7 +151,6 @@ bool TransactionRepository::updateTransaction(const Transaction &transaction)
         cerr << "Failed to execute UPDATE: " << sqlite3_errmsg(db) << endl;
     }
 
-    sqlite3_finalize(stmt);
     return success;
 }
 
@@ -161,9 +161,9 @@ bool TransactionRepository::updateTransaction(const Transaction &transaction)
 bool TransactionRepository::deleteTransaction(int transactionId)
 {
     const char *sql = "DELETE FROM transactions WHERE transaction_id=?;";
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, sql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
     {
         cerr << "Failed to prepare DELETE statement: " << sqlite3_errmsg(db) << endl;
         return false;
@@ -172,7 +172,6 @@ bool TransactionRepository::deleteTransaction(int transactionId)
     if (sqlite3_bind_int(stmt, 1, transactionId) != SQLITE_OK)
     {
         cerr << "Failed to bind transactionId for DELETE: " << sqlite3_errmsg(db) << endl;
-        sqlite3_finalize(stmt);
         return false;
     }
 
@@ -180,7 +179,6 @@ bool TransactionRepository::deleteTransaction(int transactionId)
     if (!success)
         cerr << "Failed to execute DELETE: " << sqlite3_errmsg(db) << endl;
 
-    sqlite3_finalize(stmt);
     return success;
 }
 
@@ -194,8 +192,8 @@ std::unique_ptr<Transaction> TransactionRepository::getById(int transactionId)
         "fine_amount, is_returned, is_overdue, renewal_count, transaction_status "
         "FROM transactions WHERE transaction_id=?;";
 
-    sqlite3_stmt *stmt = nullptr;
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    CachedStatement stmt(statements, sql);
+    if (!stmt)
     {
         cerr << "Failed to prepare SELECT statement: " << sqlite3_errmsg(db) << endl;
         return nullptr;
@@ -204,7 +202,6 @@ std::unique_ptr<Transaction> TransactionRepository::getById(int transactionId)
     if (sqlite3_bind_int(stmt, 1, transactionId) != SQLITE_OK)
     {
         cerr << "Failed to bind transactionId in SELECT: " << sqlite3_errmsg(db) << endl;
-        sqlite3_finalize(stmt);
         return nullptr;
     }
 
@@ -233,7 +230,6 @@ std::unique_ptr<Transaction> TransactionRepository::getById(int transactionId)
             safeText(stmt, 10));
     }
 
-    sqlite3_finalize(stmt);
     return transaction;
 }
 
@@ -251,9 +247,9 @@ std::vector<Transaction> TransactionRepository::getByUserId(int userId)
         "fine_amount, is_returned, is_overdue, renewal_count, transaction_status "
         "FROM transactions WHERE user_id=?;";
 
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, sql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
     {
         cerr << "Failed to prepare SELECT BY USER statement: "
              << sqlite3_errmsg(db) << endl;
@@ -264,7 +260,6 @@ std::vector<Transaction> TransactionRepository::getByUserId(int userId)
     {
         cerr << "Failed to bind userId in SELECT: "
              << sqlite3_errmsg(db) << endl;
-        sqlite3_finalize(stmt);
         return transactions;
     }
 
@@ -290,7 +285,6 @@ std::vector<Transaction> TransactionRepository::getByUserId(int userId)
             safeText(stmt, 10));
     }
 
-    sqlite3_finalize(stmt);
     return transactions;
 }
 
@@ -311,37 +305,68 @@ bool TransactionRepository::save(Transaction &transaction)
     }
 }
 
+bool TransactionRepository::saveAll(vector<Transaction> &transactions, BatchSaveResult &result)
+{
+    CachedStatement insertStmt(statements, insertTransactionSql);
+    CachedStatement updateStmt(statements, updateTransactionSql);
+
+    if (!insertStmt || !updateStmt)
+    {
+        cerr << "Failed to prepare batch save: " << sqlite3_errmsg(db) << endl;
+        return false;
+    }
+
+    return runBatchSave(db, transactions.size(), result, [&](size_t i)
+                        {
+                            Transaction &transaction = transactions[i];
+                            bool isNew = transaction.getTransactionId() == 0;
+                            sqlite3_stmt *stmt = isNew ? insertStmt : updateStmt;
+
+                            bool success = bindTransaction(stmt, transaction) &&
+                                           (isNew || sqlite3_bind_int(stmt, 11, transaction.getTransactionId()) == SQLITE_OK) &&
+                                           sqlite3_step(stmt) == SQLITE_DONE;
+                            sqlite3_reset(stmt);
+
+                            if (success && isNew)
+                                transaction.setTransactionId(static_cast<int>(sqlite3_last_insert_rowid(db)));
+                            return success; });
+}
+
 /* *************************************************************************
                      ---------- Get All TRANSACTIONS ----------
    *************************************************************************  */
 
-std::vector<Transaction> TransactionRepository::getAllTransactions()
+bool TransactionRepository::forEachTransaction(const std::function<void(const Transaction &)> &visit)
 {
-    std::vector<Transaction> transactions;
-
     const char *sql =
         "SELECT transaction_id, user_id, resource_id, issue_date, due_date, return_date, "
         "fine_amount, is_returned, is_overdue, renewal_count, transaction_status "
         "FROM transactions;";
 
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, sql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
     {
         std::cerr << "Failed to prepare getAllTransactions statement: "
                   << sqlite3_errmsg(db) << std::endl;
-        return transactions;
+        return false;
     }
 
+    return visitRows(stmt, visit);
+}
+
+bool TransactionRepository::visitRows(sqlite3_stmt *stmt, const std::function<void(const Transaction &)> &visit)
+{
     auto safeText = [](sqlite3_stmt *s, int col) -> std::string
     {
         const unsigned char *text = sqlite3_column_text(s, col);
         return text ? reinterpret_cast<const char *>(text) : "";
     };
 
-    while (sqlite3_step(stmt) == SQLITE_ROW)
+    int rc;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
     {
-        transactions.emplace_back(
+        Transaction row(
             sqlite3_column_int(stmt, 0),
             sqlite3_column_int(stmt, 1),
             sqlite3_column_int(stmt, 2),
@@ -353,10 +378,100 @@ std::vector<Transaction> TransactionRepository::getAllTransactions()
             sqlite3_column_int(stmt, 8),
             sqlite3_column_int(stmt, 9),
             safeText(stmt, 10));
+        visit(row);
     }
 
-    sqlite3_finalize(stmt);
-    return transactions;
+    return rc == SQLITE_DONE;
+}
+
+std::vector<Transaction> TransactionRepository::getAllTransactions()
+{
+    std::vector<Transaction> results;
+    forEachTransaction([&results](const Transaction &item)
+    {
+        results.push_back(item);
+    });
+    return results;
+}
+
+std::vector<TransactionRow> TransactionRepository::readRows(sqlite3_stmt *stmt, StringArena &arena)
+{
+    std::vector<TransactionRow> rows;
+    while (sqlite3_step(stmt) == SQLITE_ROW)
+    {
+        rows.push_back({sqlite3_column_int(stmt, 0),
+                        sqlite3_column_int(stmt, 1),
+                        sqlite3_column_int(stmt, 2),
+                        copyColumn(arena, stmt, 3),
+                        copyColumn(arena, stmt, 4),
+                        copyColumn(arena, stmt, 5),
+                        sqlite3_column_double(stmt, 6),
+                        sqlite3_column_int(stmt, 7) != 0,
+                        sqlite3_column_int(stmt, 8) != 0,
+                        sqlite3_column_int(stmt, 9),
+                        internColumn(arena, stmt, 10)});
+    }
+    return rows;
+}
+
+/* *************************************************************************
+                  ---------- KEYSET PAGES OF TRANSACTIONS ----------
+   *************************************************************************  */
+
+std::vector<Transaction> TransactionRepository::getPageAfter(int afterId, int limit)
+{
+    std::vector<Transaction> page;
+
+    const char *sql =
+        "SELECT transaction_id, user_id, resource_id, issue_date, due_date, return_date, "
+        "fine_amount, is_returned, is_overdue, renewal_count, transaction_status "
+        "FROM transactions WHERE transaction_id > ? ORDER BY transaction_id LIMIT ?;";
+
+    CachedStatement stmt(statements, sql);
+
+    if (!stmt)
+    {
+        std::cerr << "Failed to prepare page query: " << sqlite3_errmsg(db) << std::endl;
+        return page;
+    }
+
+    sqlite3_bind_int(stmt, 1, afterId);
+    sqlite3_bind_int(stmt, 2, limit);
+
+    visitRows(stmt, [&page](const Transaction &item)
+    {
+        page.push_back(item);
+    });
+    return page;
+}
+
+std::vector<Transaction> TransactionRepository::getPageBefore(int beforeId, int limit)
+{
+    std::vector<Transaction> page;
+
+    const char *sql =
+        "SELECT transaction_id, user_id, resource_id, issue_date, due_date, return_date, "
+        "fine_amount, is_returned, is_overdue, renewal_count, transaction_status "
+        "FROM transactions WHERE transaction_id < ? ORDER BY transaction_id DESC LIMIT ?;";
+
+    CachedStatement stmt(statements, sql);
+
+    if (!stmt)
+    {
+        std::cerr << "Failed to prepare page query: " << sqlite3_errmsg(db) << std::endl;
+        return page;
+    }
+
+    sqlite3_bind_int(stmt, 1, beforeId);
+    sqlite3_bind_int(stmt, 2, limit);
+
+    visitRows(stmt, [&page](const Transaction &item)
+    {
+        page.push_back(item);
+    });
+
+    std::reverse(page.begin(), page.end());
+    return page;
 }
 
 /* *************************************************************************
@@ -372,9 +487,9 @@ std::vector<Transaction> TransactionRepository::getActiveIssues()
         "fine_amount, is_returned, is_overdue, renewal_count, transaction_status "
         "FROM transactions WHERE is_returned = 0 AND transaction_status = 'ISSUED';";
 
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, sql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
     {
         std::cerr << "Failed to prepare getActiveIssues statement: "
                   << sqlite3_errmsg(db) << std::endl;
@@ -403,7 +518,113 @@ std::vector<Transaction> TransactionRepository::getActiveIssues()
             safeText(stmt, 10));
     }
 
-    sqlite3_finalize(stmt);
+    return transactions;
+}
+
+/* *************************************************************************
+                  ---------- DATE RANGE QUERIES ----------
+   *************************************************************************  */
+
+std::vector<Transaction> TransactionRepository::getOverdueIssues(const CivilDate &today)
+{
+    std::vector<Transaction> transactions;
+
+    const char *sql =
+        "SELECT transaction_id, user_id, resource_id, issue_date, due_date, return_date, "
+        "fine_amount, is_returned, is_overdue, renewal_count, transaction_status "
+        "FROM transactions WHERE transaction_status = 'ISSUED' AND is_returned = 0 AND due_day < ? "
+        "ORDER BY due_day;";
+
+    CachedStatement stmt(statements, sql);
+
+    if (!stmt)
+    {
+        std::cerr << "Failed to prepare getOverdueIssues statement: "
+                  << sqlite3_errmsg(db) << std::endl;
+        return transactions;
+    }
+
+    sqlite3_bind_int(stmt, 1, today.getDaysSinceEpoch());
+    visitRows(stmt, [&transactions](const Transaction &item)
+    {
+        transactions.push_back(item);
+    });
+    return transactions;
+}
+
+std::vector<TransactionRow> TransactionRepository::getOverdueIssueRows(StringArena &arena, const CivilDate &today)
+{
+    const char *sql =
+        "SELECT transaction_id, user_id, resource_id, issue_date, due_date, return_date, "
+        "fine_amount, is_returned, is_overdue, renewal_count, transaction_status "
+        "FROM transactions WHERE transaction_status = 'ISSUED' AND is_returned = 0 AND due_day < ? "
+        "ORDER BY due_day;";
+
+    CachedStatement stmt(statements, sql);
+
+    if (!stmt)
+    {
+        std::cerr << "Failed to prepare getOverdueIssues statement: "
+                  << sqlite3_errmsg(db) << std::endl;
+        return {};
+    }
+
+    sqlite3_bind_int(stmt, 1, today.getDaysSinceEpoch());
+    return readRows(stmt, arena);
+}
+
+std::vector<Transaction> TransactionRepository::getIssuesDueBetween(const CivilDate &from, const CivilDate &to)
+{
+    std::vector<Transaction> transactions;
+
+    const char *sql =
+        "SELECT transaction_id, user_id, resource_id, issue_date, due_date, return_date, "
+        "fine_amount, is_returned, is_overdue, renewal_count, transaction_status "
+        "FROM transactions WHERE transaction_status = 'ISSUED' AND is_returned = 0 "
+        "AND due_day BETWEEN ? AND ? ORDER BY due_day;";
+
+    CachedStatement stmt(statements, sql);
+
+    if (!stmt)
+    {
+        std::cerr << "Failed to prepare getIssuesDueBetween statement: "
+                  << sqlite3_errmsg(db) << std::endl;
+        return transactions;
+    }
+
+    sqlite3_bind_int(stmt, 1, from.getDaysSinceEpoch());
+    sqlite3_bind_int(stmt, 2, to.getDaysSinceEpoch());
+    visitRows(stmt, [&transactions](const Transaction &item)
+    {
+        transactions.push_back(item);
+    });
+    return transactions;
+}
+
+std::vector<Transaction> TransactionRepository::getIssuedBetween(const CivilDate &from, const CivilDate &to)
+{
+    std::vector<Transaction> transactions;
+
+    const char *sql =
+        "SELECT transaction_id, user_id, resource_id, issue_date, due_date, return_date, "
+        "fine_amount, is_returned, is_overdue, renewal_count, transaction_status "
+        "FROM transactions WHERE issue_day BETWEEN ? AND ? ORDER BY issue_day;";
+
+    CachedStatement stmt(statements, sql);
+
+    if (!stmt)
+    {
+        std::cerr << "Failed to prepare getIssuedBetween statement: "
+                  << sqlite3_errmsg(db) << std::endl;
+        return transactions;
+    }
+
+    sqlite3_bind_int(stmt, 1, from.getDaysSinceEpoch());
+    sqlite3_bind_int(stmt, 2, to.getDaysSinceEpoch());
+    visitRows(stmt, [&transactions](const Transaction &item)
+    {
+        transactions.push_back(item);
+    });
     return transactions;
 }
 
@@ -416,9 +637,9 @@ std::vector<Transaction> TransactionRepository::getbyStatus(const std::string &s
         "fine_amount, is_returned, is_overdue, renewal_count, transaction_status "
         "FROM transactions WHERE transaction_status = ?;";
 
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, sql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
     {
         std::cerr << "Failed to prepare getbyStatus statement: "
                   << sqlite3_errmsg(db) << std::endl;
@@ -429,7 +650,6 @@ std::vector<Transaction> TransactionRepository::getbyStatus(const std::string &s
     {
         std::cerr << "Failed to bind status in getbyStatus: "
                   << sqlite3_errmsg(db) << std::endl;
-        sqlite3_finalize(stmt);
         return transactions;
     }
 
@@ -455,6 +675,41 @@ std::vector<Transaction> TransactionRepository::getbyStatus(const std::string &s
             safeText(stmt, 10));
     }
 
-    sqlite3_finalize(stmt);
     return transactions;
-}
\ No newline at end of file
+}
+
+/* *************************************************************************
+                  ---------- APPLY OVERDUE CHARGES ----------
+   *************************************************************************  */
+
+bool TransactionRepository::applyOverdueCharges(const std::vector<OverdueCharge> &charges, int &updatedCount)
+{
+    updatedCount = 0;
+
+    const char *sql =
+        "UPDATE transactions SET fine_amount=?, is_overdue=1 WHERE transaction_id=?;";
+
+    for (const OverdueCharge &charge : charges)
+    {
+        CachedStatement stmt(statements, sql);
+        if (!stmt)
+        {
+            std::cerr << "Failed to prepare applyOverdueCharges statement: "
+                      << sqlite3_errmsg(db) << std::endl;
+            return false;
+        }
+
+        sqlite3_bind_double(stmt, 1, charge.fineAmount);
+        sqlite3_bind_int(stmt, 2, charge.transactionId);
+
+        if (sqlite3_step(stmt) != SQLITE_DONE)
+        {
+            std::cerr << "Failed to execute applyOverdueCharges: "
+                      << sqlite3_errmsg(db) << std::endl;
+            return false;
+        }
+        updatedCount += sqlite3_changes(db);
+    }
+
+    return true;
+}
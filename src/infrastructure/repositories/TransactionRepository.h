@@ -3,19 +3,33 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <functional>
+#include "../database/StatementCache.h"
 #include "../../domain/Transaction.h"
+#include "../../domain/TransactionRow.h"
+#include "../../Utility/StringArena.h"
+#include "../../Utility/CivilDate.h"
+#include "../../domain/OverdueCharge.h"
+#include "BatchSave.h"
 
 class TransactionRepository
 {
 private:
     sqlite3 *db;
+    StatementCache &statements;
+
+    bool visitRows(sqlite3_stmt *stmt, const std::function<void(const Transaction &)> &visit);
+    std::vector<TransactionRow> readRows(sqlite3_stmt *stmt, StringArena &arena);
+    bool bindTransaction(sqlite3_stmt *stmt, const Transaction &transaction);
 
 public:
-    explicit TransactionRepository(sqlite3 *connection);
+    explicit TransactionRepository(sqlite3 *connection, StatementCache &statementCache);
     ~TransactionRepository();
     
     // Transaction management
     bool save(Transaction &transaction);
+    // Inserts new rows (id 0) and updates the rest in one transaction.
+    bool saveAll(std::vector<Transaction> &transactions, BatchSaveResult &result);
     bool beginTransaction();
     bool commitTransaction();
     bool rollbackTransaction();
@@ -28,7 +42,21 @@ public:
     std::unique_ptr<Transaction> getById(int transactionId);
     std::vector<Transaction> getByUserId(int userId);
     std::vector<Transaction> getAllTransactions();
+    bool forEachTransaction(const std::function<void(const Transaction &)> &visit);
+    std::vector<Transaction> getPageAfter(int afterId, int limit);
+    std::vector<Transaction> getPageBefore(int beforeId, int limit);
 
     std::vector<Transaction> getActiveIssues();
+
+    // Range queries over the integer day columns (schema version 4); each one
+    // is an index range scan. Bounds are inclusive; results are in date order.
+    std::vector<Transaction> getOverdueIssues(const CivilDate &today); // due before today
+    // The same rows as view rows backed by arena, which must outlive them.
+    std::vector<TransactionRow> getOverdueIssueRows(StringArena &arena, const CivilDate &today);
+    std::vector<Transaction> getIssuesDueBetween(const CivilDate &from, const CivilDate &to);
+    std::vector<Transaction> getIssuedBetween(const CivilDate &from, const CivilDate &to);
     std::vector<Transaction> getbyStatus(const std::string &status);
+
+    // Batch fine engine: marks each charged transaction overdue and stores its fine.
+    bool applyOverdueCharges(const std::vector<OverdueCharge> &charges, int &updatedCount);
 };
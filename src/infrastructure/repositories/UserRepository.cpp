@@ -1,5 +1,6 @@
 #include "UserRepository.h"
 #include <iostream>
+#include <algorithm>
 
 using namespace std;
 
@@ -7,44 +8,61 @@ using namespace std;
                  ---------- CONSTRUCTORS & DESTRUCTORS ----------
    *************************************************************************  */
 
-UserRepository::UserRepository(sqlite3 *connection) : db(connection) {}
+UserRepository::UserRepository(sqlite3 *connection, StatementCache &statementCache)
+    : db(connection), statements(statementCache) {}
 UserRepository::~UserRepository() {}
 
+/* *************************************************************************
+                      ---------- BIND USER COLUMNS ----------
+   *************************************************************************  */
+
+static const char *insertUserSql =
+    "INSERT INTO users "
+    "(username, password, first_name, last_name, email, address, phone, "
+    "balance, membership_type_id, registration_date, is_active, deletion_requested) "
+    "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?);"; // Extra question mark to accomodate new attribute
+
+static const char *updateUserSql =
+    "UPDATE users SET "
+    "username=?, password=?, first_name=?, last_name=?, email=?, "
+    "address=?, phone=?, balance=?, membership_type_id=?, "
+    "registration_date=?, is_active=?, deletion_requested=? " // Added the attribute here as well
+    "WHERE user_id=?;";
+
+// Parameters 1-12 are the same in the INSERT and the UPDATE; the UPDATE adds the id as 13.
+bool UserRepository::bindUser(sqlite3_stmt *stmt, const User &user)
+{
+    return sqlite3_bind_text(stmt, 1, user.getUsername().c_str(), -1, SQLITE_TRANSIENT) == SQLITE_OK &&
+           sqlite3_bind_text(stmt, 2, user.getPassword().c_str(), -1, SQLITE_TRANSIENT) == SQLITE_OK &&
+           sqlite3_bind_text(stmt, 3, user.getFirstName().c_str(), -1, SQLITE_TRANSIENT) == SQLITE_OK &&
+           sqlite3_bind_text(stmt, 4, user.getLastName().c_str(), -1, SQLITE_TRANSIENT) == SQLITE_OK &&
+           sqlite3_bind_text(stmt, 5, user.getEmail().c_str(), -1, SQLITE_TRANSIENT) == SQLITE_OK &&
+           sqlite3_bind_text(stmt, 6, user.getAddress().c_str(), -1, SQLITE_TRANSIENT) == SQLITE_OK &&
+           sqlite3_bind_text(stmt, 7, user.getPhone().c_str(), -1, SQLITE_TRANSIENT) == SQLITE_OK &&
+           sqlite3_bind_double(stmt, 8, user.getBalance()) == SQLITE_OK &&
+           sqlite3_bind_int(stmt, 9, user.getMembershipTypeId()) == SQLITE_OK &&
+           sqlite3_bind_text(stmt, 10, user.getRegistrationDate().c_str(), -1, SQLITE_TRANSIENT) == SQLITE_OK &&
+           sqlite3_bind_int(stmt, 11, user.getIsActive() ? 1 : 0) == SQLITE_OK &&
+           sqlite3_bind_int(stmt, 12, user.getDeletionRequested() ? 1 : 0) == SQLITE_OK;
+}
+
 /* *************************************************************************
                         ---------- INSERT USER ----------
    *************************************************************************  */
 
 bool UserRepository::insertUser(User &user)
 {
-    const char *sql =
-        "INSERT INTO users "
-        "(username, password, first_name, last_name, email, address, phone, "
-        "balance, membership_type_id, registration_date, is_active, deletion_requested) "
-        "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?);"; // Extra question mark to accomodate new attribute
+    CachedStatement stmt(statements, insertUserSql);
 
-    sqlite3_stmt *stmt = nullptr;
-
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
     {
         cerr << "Failed to prepare INSERT: " << sqlite3_errmsg(db) << endl;
         return false;
     }
 
-    if (sqlite3_bind_text(stmt, 1, user.getUsername().c_str(), -1, SQLITE_TRANSIENT) != SQLITE_OK ||
-        sqlite3_bind_text(stmt, 2, user.getPassword().c_str(), -1, SQLITE_TRANSIENT) != SQLITE_OK ||
-        sqlite3_bind_text(stmt, 3, user.getFirstName().c_str(), -1, SQLITE_TRANSIENT) != SQLITE_OK ||
-        sqlite3_bind_text(stmt, 4, user.getLastName().c_str(), -1, SQLITE_TRANSIENT) != SQLITE_OK ||
-        sqlite3_bind_text(stmt, 5, user.getEmail().c_str(), -1, SQLITE_TRANSIENT) != SQLITE_OK ||
-        sqlite3_bind_text(stmt, 6, user.getAddress().c_str(), -1, SQLITE_TRANSIENT) != SQLITE_OK ||
-        sqlite3_bind_text(stmt, 7, user.getPhone().c_str(), -1, SQLITE_TRANSIENT) != SQLITE_OK ||
-        sqlite3_bind_double(stmt, 8, user.getBalance()) != SQLITE_OK ||
-        sqlite3_bind_int(stmt, 9, user.getMembershipTypeId()) != SQLITE_OK ||
-        sqlite3_bind_text(stmt, 10, user.getRegistrationDate().c_str(), -1, SQLITE_TRANSIENT) != SQLITE_OK ||
-        sqlite3_bind_int(stmt, 11, user.getIsActive() ? 1 : 0) != SQLITE_OK ||
-        sqlite3_bind_int(stmt, 12, user.getDeletionRequested() ? 1 : 0) != SQLITE_OK)
+    if (!bindUser(stmt, user))
     {
         cerr << "Failed to bind parameters for INSERT: " << sqlite3_errmsg(db) << endl;
-        sqlite3_finalize(stmt);
         return false;
     }
 
@@ -57,7 +75,6 @@ bool UserRepository::insertUser(User &user)
         sqlite3_int64 lastId = sqlite3_last_insert_rowid(db);
         user.setUserId(static_cast<int>(lastId));
     }
-    sqlite3_finalize(stmt);
     return success;
 }
 
@@ -67,39 +84,19 @@ bool UserRepository::insertUser(User &user)
 
 bool UserRepository::updateUser(const User &user)
 {
+    CachedStatement stmt(statements, updateUserSql);
 
-    const char *sql =
-        "UPDATE users SET "
-        "username=?, password=?, first_name=?, last_name=?, email=?, "
-        "address=?, phone=?, balance=?, membership_type_id=?, "
-        "registration_date=?, is_active=?, deletion_requested=? " // Added the attribute here as well
-        "WHERE user_id=?;";
-
-    sqlite3_stmt *stmt = nullptr;
-
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
     {
         cerr << "Failed to prepare UPDATE: " << sqlite3_errmsg(db) << endl;
         return false;
     }
 
-    if (sqlite3_bind_text(stmt, 1, user.getUsername().c_str(), -1, SQLITE_TRANSIENT) != SQLITE_OK ||
-        sqlite3_bind_text(stmt, 2, user.getPassword().c_str(), -1, SQLITE_TRANSIENT) != SQLITE_OK ||
-        sqlite3_bind_text(stmt, 3, user.getFirstName().c_str(), -1, SQLITE_TRANSIENT) != SQLITE_OK ||
-        sqlite3_bind_text(stmt, 4, user.getLastName().c_str(), -1, SQLITE_TRANSIENT) != SQLITE_OK ||
-        sqlite3_bind_text(stmt, 5, user.getEmail().c_str(), -1, SQLITE_TRANSIENT) != SQLITE_OK ||
-        sqlite3_bind_text(stmt, 6, user.getAddress().c_str(), -1, SQLITE_TRANSIENT) != SQLITE_OK ||
-        sqlite3_bind_text(stmt, 7, user.getPhone().c_str(), -1, SQLITE_TRANSIENT) != SQLITE_OK ||
-        sqlite3_bind_double(stmt, 8, user.getBalance()) != SQLITE_OK ||
-        sqlite3_bind_int(stmt, 9, user.getMembershipTypeId()) != SQLITE_OK ||
-        sqlite3_bind_text(stmt, 10, user.getRegistrationDate().c_str(), -1, SQLITE_TRANSIENT) != SQLITE_OK ||
-        sqlite3_bind_int(stmt, 11, user.getIsActive() ? 1 : 0) != SQLITE_OK ||
-        sqlite3_bind_int(stmt, 12, user.getDeletionRequested() ? 1 : 0) || // Added the accomodation
-        sqlite3_bind_int(stmt, 13, user.getUserId()))
+    if (!bindUser(stmt, user) ||
+        sqlite3_bind_int(stmt, 13, user.getUserId()) != SQLITE_OK)
     {
 
         cerr << "Failed to bind parameters for UPDATE: " << sqlite3_errmsg(db) << endl;
-        sqlite3_finalize(stmt);
         return false;
     }
 
@@ -107,7 +104,6 @@ bool UserRepository::updateUser(const User &user)
     if (!success)
         cerr << "Failed to execute UPDATE: " << sqlite3_errmsg(db) << endl;
 
-    sqlite3_finalize(stmt);
     return success;
 }
 
@@ -119,9 +115,9 @@ bool UserRepository::deleteUser(int userId)
 {
 
     const char *sql = "DELETE FROM users WHERE user_id=?;";
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, sql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
     {
         cerr << "Failed to prepare DELETE: " << sqlite3_errmsg(db) << endl;
         return false;
@@ -130,7 +126,6 @@ bool UserRepository::deleteUser(int userId)
     if (sqlite3_bind_int(stmt, 1, userId) != SQLITE_OK)
     {
         cerr << "Failed to bind userId: " << sqlite3_errmsg(db) << endl;
-        sqlite3_finalize(stmt);
         return false;
     }
 
@@ -138,7 +133,6 @@ bool UserRepository::deleteUser(int userId)
     if (!success)
         cerr << "Failed to execute DELETE: " << sqlite3_errmsg(db) << endl;
 
-    sqlite3_finalize(stmt);
     return success;
 }
 
@@ -153,9 +147,9 @@ std::unique_ptr<User> UserRepository::getById(int userId)
         "SELECT user_id, username, password, first_name, last_name, email, "
         "address, phone, balance, membership_type_id, registration_date, is_active, deletion_requested " // Added
         "FROM users WHERE user_id=?;";
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, sql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
     {
         cerr << "Failed to prepare SELECT: " << sqlite3_errmsg(db) << endl;
         return nullptr;
@@ -164,7 +158,6 @@ std::unique_ptr<User> UserRepository::getById(int userId)
     if (sqlite3_bind_int(stmt, 1, userId) != SQLITE_OK)
     {
         cerr << "Failed to bind userId: " << sqlite3_errmsg(db) << endl;
-        sqlite3_finalize(stmt);
         return nullptr;
     }
 
@@ -194,7 +187,6 @@ std::unique_ptr<User> UserRepository::getById(int userId)
             sqlite3_column_int(stmt, 12) == 1); //  Added deletionRequested
     }
 
-    sqlite3_finalize(stmt);
     return user;
 }
 
@@ -210,9 +202,9 @@ std::unique_ptr<User> UserRepository::getByUsername(const std::string &username)
         "address, phone, balance, membership_type_id, registration_date, is_active, deletion_requested "
         "FROM users WHERE username=?;";
 
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, sql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
     {
         cerr << "Failed to prepare SELECT BY USERNAME: " << sqlite3_errmsg(db) << endl;
         return nullptr;
@@ -221,7 +213,6 @@ std::unique_ptr<User> UserRepository::getByUsername(const std::string &username)
     if (sqlite3_bind_text(stmt, 1, username.c_str(), -1, SQLITE_TRANSIENT) != SQLITE_OK)
     {
         cerr << "Failed to bind username: " << sqlite3_errmsg(db) << endl;
-        sqlite3_finalize(stmt);
         return nullptr;
     }
 
@@ -251,7 +242,6 @@ std::unique_ptr<User> UserRepository::getByUsername(const std::string &username)
             sqlite3_column_int(stmt, 12) == 1); //  Added deletionRequested
     }
 
-    sqlite3_finalize(stmt);
     return user;
 }
 
@@ -259,33 +249,36 @@ std::unique_ptr<User> UserRepository::getByUsername(const std::string &username)
                         ---------- GET ALL USERS ----------
    *************************************************************************  */
 
-std::vector<User> UserRepository::getAllUsers()
+bool UserRepository::forEachUser(const std::function<void(const User &)> &visit)
 {
-
-    std::vector<User> users;
-
     const char *sql =
         "SELECT user_id, username, password, first_name, last_name, email, "
         "address, phone, balance, membership_type_id, registration_date, is_active, deletion_requested "
         "FROM users;";
 
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, sql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
     {
         cerr << "Failed to prepare SELECT ALL: " << sqlite3_errmsg(db) << endl;
-        return users;
+        return false;
     }
 
+    return visitRows(stmt, visit);
+}
+
+bool UserRepository::visitRows(sqlite3_stmt *stmt, const std::function<void(const User &)> &visit)
+{
     auto safeText = [](sqlite3_stmt *stmt, int col) -> string
     {
         const unsigned char *text = sqlite3_column_text(stmt, col);
         return text ? reinterpret_cast<const char *>(text) : "";
     };
 
-    while (sqlite3_step(stmt) == SQLITE_ROW)
+    int rc;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
     {
-        users.emplace_back(
+        User row(
             sqlite3_column_int(stmt, 0),
             safeText(stmt, 1),
             safeText(stmt, 2),
@@ -299,10 +292,81 @@ std::vector<User> UserRepository::getAllUsers()
             safeText(stmt, 10),
             sqlite3_column_int(stmt, 11) == 1,
             sqlite3_column_int(stmt, 12) == 1); //  Added deletionRequested
+        visit(row);
     }
 
-    sqlite3_finalize(stmt);
-    return users;
+    return rc == SQLITE_DONE;
+}
+
+std::vector<User> UserRepository::getAllUsers()
+{
+    std::vector<User> results;
+    forEachUser([&results](const User &item)
+    {
+        results.push_back(item);
+    });
+    return results;
+}
+
+/* *************************************************************************
+                  ---------- KEYSET PAGES OF USERS ----------
+   *************************************************************************  */
+
+std::vector<User> UserRepository::getPageAfter(int afterId, int limit)
+{
+    std::vector<User> page;
+
+    const char *sql =
+        "SELECT user_id, username, password, first_name, last_name, email, "
+        "address, phone, balance, membership_type_id, registration_date, is_active, deletion_requested "
+        "FROM users WHERE user_id > ? ORDER BY user_id LIMIT ?;";
+
+    CachedStatement stmt(statements, sql);
+
+    if (!stmt)
+    {
+        std::cerr << "Failed to prepare page query: " << sqlite3_errmsg(db) << std::endl;
+        return page;
+    }
+
+    sqlite3_bind_int(stmt, 1, afterId);
+    sqlite3_bind_int(stmt, 2, limit);
+
+    visitRows(stmt, [&page](const User &item)
+    {
+        page.push_back(item);
+    });
+    return page;
+}
+
+std::vector<User> UserRepository::getPageBefore(int beforeId, int limit)
+{
+    std::vector<User> page;
+
+    const char *sql =
+        "SELECT user_id, username, password, first_name, last_name, email, "
+        "address, phone, balance, membership_type_id, registration_date, is_active, deletion_requested "
+        "FROM users WHERE user_id < ? ORDER BY user_id DESC LIMIT ?;";
+
+    CachedStatement stmt(statements, sql);
+
+    if (!stmt)
+    {
+        std::cerr << "Failed to prepare page query: " << sqlite3_errmsg(db) << std::endl;
+        return page;
+    }
+
+    sqlite3_bind_int(stmt, 1, beforeId);
+    sqlite3_bind_int(stmt, 2, limit);
+
+    visitRows(stmt, [&page](const User &item)
+    {
+        page.push_back(item);
+    });
+
+    // Descending scan; flip back to ascending id order.
+    std::reverse(page.begin(), page.end());
+    return page;
 }
 
 /* *************************************************************************
@@ -318,6 +382,33 @@ bool UserRepository::save(User &user)
     return updateUser(user);
 }
 
+bool UserRepository::saveAll(vector<User> &users, BatchSaveResult &result)
+{
+    CachedStatement insertStmt(statements, insertUserSql);
+    CachedStatement updateStmt(statements, updateUserSql);
+
+    if (!insertStmt || !updateStmt)
+    {
+        cerr << "Failed to prepare batch save: " << sqlite3_errmsg(db) << endl;
+        return false;
+    }
+
+    return runBatchSave(db, users.size(), result, [&](size_t i)
+                        {
+                            User &user = users[i];
+                            bool isNew = user.getUserId() == 0;
+                            sqlite3_stmt *stmt = isNew ? insertStmt : updateStmt;
+
+                            bool success = bindUser(stmt, user) &&
+                                           (isNew || sqlite3_bind_int(stmt, 13, user.getUserId()) == SQLITE_OK) &&
+                                           sqlite3_step(stmt) == SQLITE_DONE;
+                            sqlite3_reset(stmt);
+
+                            if (success && isNew)
+                                user.setUserId(static_cast<int>(sqlite3_last_insert_rowid(db)));
+                            return success; });
+}
+
 /* *************************************************************************
                 ---------- GET PENDING DELETION REQUEST ----------
    *************************************************************************  */
@@ -332,9 +423,9 @@ std::vector<User> UserRepository::getPendingDeletionRequests()
         "address, phone, balance, membership_type_id, registration_date, is_active, deletion_requested "
         "FROM users WHERE deletion_requested=1;"; // Added the condition to only get users with deletion requested
 
-    sqlite3_stmt *stmt = nullptr;
+    CachedStatement stmt(statements, sql);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    if (!stmt)
     {
         cerr << "Failed to prepare SELECT ALL: " << sqlite3_errmsg(db) << endl;
         return users;
@@ -364,6 +455,63 @@ std::vector<User> UserRepository::getPendingDeletionRequests()
             sqlite3_column_int(stmt, 12) == 1); //  Added deletionRequested
     }
 
-    sqlite3_finalize(stmt);
     return users;
 }
+
+/* *************************************************************************
+                ---------- GET CIRCULATION SUMMARY ----------
+   *************************************************************************  */
+
+int UserRepository::countUsers()
+{
+    CachedStatement stmt(statements, "SELECT COUNT(*) FROM users;");
+
+    if (!stmt)
+    {
+        cerr << "Failed to prepare COUNT: " << sqlite3_errmsg(db) << endl;
+        return -1;
+    }
+
+    if (sqlite3_step(stmt) != SQLITE_ROW)
+    {
+        cerr << "Failed to count users: " << sqlite3_errmsg(db) << endl;
+        return -1;
+    }
+    return sqlite3_column_int(stmt, 0);
+}
+
+bool UserRepository::getCirculationSummary(int userId, CirculationSummary &summary)
+{
+    const char *sql =
+        "SELECT active_borrows, pending_requests, unpaid_fine_count, unpaid_fine_total "
+        "FROM user_circulation WHERE user_id=?;";
+
+    CachedStatement stmt(statements, sql);
+
+    if (!stmt)
+    {
+        cerr << "Failed to prepare SELECT: " << sqlite3_errmsg(db) << endl;
+        return false;
+    }
+
+    sqlite3_bind_int(stmt, 1, userId);
+
+    summary = CirculationSummary();
+    summary.userId = userId;
+
+    int rc = sqlite3_step(stmt);
+    if (rc == SQLITE_ROW)
+    {
+        summary.activeBorrows = sqlite3_column_int(stmt, 0);
+        summary.pendingRequests = sqlite3_column_int(stmt, 1);
+        summary.unpaidFineCount = sqlite3_column_int(stmt, 2);
+        summary.unpaidFineTotal = sqlite3_column_double(stmt, 3);
+    }
+    else if (rc != SQLITE_DONE)
+    {
+        cerr << "Failed to read circulation summary: " << sqlite3_errmsg(db) << endl;
+        return false;
+    }
+
+    return true;
+}
@@ -3,25 +3,43 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <functional>
+#include "../database/StatementCache.h"
 #include "../../domain/User.h"
+#include "../../domain/CirculationSummary.h"
+#include "BatchSave.h"
 
 class UserRepository
 {
 private:
     sqlite3 *db;
+    StatementCache &statements;
 
     bool insertUser(User &user);
     bool updateUser(const User &user);
+    bool bindUser(sqlite3_stmt *stmt, const User &user);
+    bool visitRows(sqlite3_stmt *stmt, const std::function<void(const User &)> &visit);
 
 public:
-    explicit UserRepository(sqlite3 *connection);
+    explicit UserRepository(sqlite3 *connection, StatementCache &statementCache);
     ~UserRepository();
 
     bool save(User &user);
+    // Inserts new rows (id 0) and updates the rest in one transaction.
+    bool saveAll(std::vector<User> &users, BatchSaveResult &result);
     bool deleteUser(int userId);
 
     std::unique_ptr<User> getById(int userId);
     std::unique_ptr<User> getByUsername(const std::string &username);
     std::vector<User> getAllUsers();
+    bool forEachUser(const std::function<void(const User &)> &visit);
+    std::vector<User> getPageAfter(int afterId, int limit);
+    std::vector<User> getPageBefore(int beforeId, int limit);
     std::vector<User> getPendingDeletionRequests();
+    // Number of user rows, or -1 if the query fails.
+    int countUsers();
+
+    // Single-row read of user_circulation; a user without a row gets zeros.
+    // Returns false only if the query itself fails.
+    bool getCirculationSummary(int userId, CirculationSummary &summary);
 };
\ No newline at end of file
@@ -1,8 +1,11 @@
+#include <algorithm>
 #include <iostream>
 #include <string>
+#include <thread>
 
 // Database
 #include "infrastructure/database/DatabaseInitializer.h"
+#include "infrastructure/database/ConnectionPool.h"
 
 // Repositories
 #include "infrastructure/repositories/UserRepository.h"
@@ -15,6 +18,7 @@
 #include "infrastructure/repositories/FundRequestRepository.h"
 #include "infrastructure/repositories/MembershipTypeRepository.h"
 #include "infrastructure/repositories/ReservationRepository.h"
+#include "export/TableExporter.h"
 
 // Services
 #include "services/AuthenticationService.h"
@@ -29,6 +33,7 @@
 
 // Utilities
 #include "Utility/date.h"
+#include "Utility/AllocationProfiler.h"
 
 int main()
 {
@@ -51,19 +56,52 @@ int main()
         return 1;
     }
 
-    sqlite3 *db = startDBService.getConnection();
+    // Bring older library.db files up to the current schema version
+    if (!startDBService.runMigrations())
+    {
+        std::cerr << "CRITICAL ERROR: Failed to migrate database schema.\n";
+        return 1;
+    }
+
+    std::cout << "[System] Database settings: " << startDBService.describeActiveSettings() << "\n";
+
+    // Extra connections for reports and exports, so they read beside the
+    // interactive session instead of through its connection. One reader per
+    // core lets the issued/overdue report spread its lookups over every core,
+    // on top of the readers it leaves free for exports and other reports.
+    std::size_t poolReaders = std::max<std::size_t>(ConnectionPool::defaultReaders,
+                                                    std::thread::hardware_concurrency() + ConnectionPool::reservedReaders);
+    ConnectionPool connectionPool("../src/db/library.db", ConnectionProfile(), poolReaders);
+    bool poolReady = connectionPool.open();
+    if (!poolReady)
+    {
+        std::cerr << "[System] WARNING: Connection pool unavailable; reports will share the main connection.\n";
+    }
+
+    // The console reads and writes on the pool's writer, leased for the whole
+    // run, so every write this process makes goes through that one connection.
+    // startDBService's own connection only sets up the schema and runs WAL
+    // maintenance; it takes over only if the writer could not be opened.
+    ConnectionPool::WriteLease consoleWriter = connectionPool.acquireWriter();
+    if (!consoleWriter)
+    {
+        std::cerr << "[System] WARNING: Pool writer unavailable; the console writes on the setup connection.\n";
+    }
+    sqlite3 *db = consoleWriter ? consoleWriter.connection() : startDBService.getConnection();
+    StatementCache &statements = consoleWriter ? consoleWriter.statements() : startDBService.getStatementCache();
 
     // Create repository instances
-    UserRepository userRepo(db);
-    AdministratorRepository adminRepo(db);
-    ResourceRepository resourceRepo(db);
-    CategoryRepository categoryRepo(db);
-    TransactionRepository transactionRepo(db);
-    FineRepository fineRepo(db);
-    BorrowingHistoryRepository historyRepo(db);
-    FundRequestRepository fundReqRepo(db);
-    MembershipTypeRepository membershipRepo(db);
-    ReservationRepository reservationRepo(db);
+    UserRepository userRepo(db, statements);
+    AdministratorRepository adminRepo(db, statements);
+    ResourceRepository resourceRepo(db, statements);
+    CategoryRepository categoryRepo(db, statements);
+    TransactionRepository transactionRepo(db, statements);
+    FineRepository fineRepo(db, statements);
+    BorrowingHistoryRepository historyRepo(db, statements);
+    FundRequestRepository fundReqRepo(db, statements);
+    MembershipTypeRepository membershipRepo(db, statements);
+    ReservationRepository reservationRepo(db, statements);
+    TableExporter tableExporter(db, statements);
 
     // Create service instances
     AuthenticationService authService(userRepo, adminRepo);
@@ -73,7 +111,8 @@ int main()
 
     AdminService adminService(userRepo, fineRepo, resourceRepo, categoryRepo,
                               fundReqRepo, transactionRepo, reservationRepo,
-                              membershipRepo, historyRepo, adminRepo);
+                              membershipRepo, historyRepo, adminRepo, tableExporter,
+                              poolReady ? &connectionPool : nullptr);
 
     // ==========================================
     // 2. MOCK CLOCK & PRE-COMPUTATION
@@ -89,7 +128,15 @@ int main()
     std::cout << "[System] Calculating overdues and updating daily fines for " << systemDate << "...\n";
 
     // Pre-computation: Synchronize DB states prior to user interaction
-    adminService.updateDailyFines(systemDate);
+    FineUpdateSummary fineSummary = adminService.updateDailyFines(systemDate);
+    if (!fineSummary.success)
+    {
+        std::cerr << "[System] WARNING: Daily fine update failed and was rolled back.\n";
+    }
+    std::cout << "[System] Scanned " << fineSummary.transactionsScanned << " issues past due, "
+              << fineSummary.overdueTransactions << " charged (" << fineSummary.finesUpdated << " fines updated, "
+              << fineSummary.finesCreated << " created, " << fineSummary.transactionsUpdated
+              << " transactions stamped) in " << fineSummary.elapsedMs << " ms.\n";
 
     std::cout << "[System] Boot sequence complete. Launching interface...\n\n";
 
@@ -100,31 +147,11 @@ int main()
     AuthMenu authMenu(authService, systemDate);
     bool running = true;
 
-    // ==========================================
-    // Seeder for admin
-    // int v;
-    // cout<<"Enter v";
-    // cin>>v;
-    // Administrator admin(0,"admin","admin","Judy","Hops","hops@zpd.zu","2012-11-11",true);
-    // adminRepo.save(admin);
-    // Seed  for categories
-    // Category booksCat;
-    // booksCat.setName("Books");
-    // booksCat.setDescription("Physical printed books, including fiction, non-fiction, and reference materials.");
-    // adminService.addCategory(booksCat);
-
-    // Category journalsCat;
-    // journalsCat.setName("Journals & Magazines");
-    // journalsCat.setDescription("Periodicals, academic journals, and weekly or monthly magazines.");
-    // adminService.addCategory(journalsCat);
-
-    // Category digitalCat;
-    // digitalCat.setName("Digital Media");
-    // digitalCat.setDescription("E-books, audiobooks, CDs, DVDs, and other digital resources.");
-    // adminService.addCategory(digitalCat);
-    // ==========================================
     while (running)
     {
+        // Checkpoint the WAL and refresh statistics between sessions
+        startDBService.runMaintenanceIfDue();
+
         // 4. THE AUTHENTICATION GATEWAY (Routing)
         ActiveSession session = authMenu.displayMenu();
 
@@ -148,5 +175,27 @@ int main()
         }
     }
 
+    // Queued reports finish before AdminService (and the pool) go away.
+    std::size_t pendingReports = adminService.getActiveReportJobCount();
+    if (pendingReports > 0)
+    {
+        std::cout << "[System] Waiting for " << pendingReports << " report job(s) to finish...\n";
+    }
+
+    std::cout << "[System] Statement cache: " << statements.getHits() << " hits, "
+              << statements.getMisses() << " misses, " << statements.getSize() << " cached queries.\n";
+
+    ResourceCacheStats resourceCache = resourceRepo.getCacheStats();
+    std::cout << "[System] Resource cache: " << resourceCache.hits << " hits, " << resourceCache.misses
+              << " misses (" << static_cast<int>(resourceCache.hitRate() * 100) << "% hit rate), "
+              << resourceCache.evictions << " evictions, " << resourceCache.size << "/"
+              << resourceCache.capacity << " entries.\n";
+
+    if (AllocationProfiler::enabled())
+    {
+        std::cout << "[System] Allocation profile:\n";
+        AllocationProfiler::report(std::cout);
+    }
+
     return 0; // startDBService's destructor safely closes the SQLite connection
 }
\ No newline at end of file
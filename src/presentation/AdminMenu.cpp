@@ -2,8 +2,112 @@
 #include "presentation/ConsoleUtils.h"
 #include "services/AdminService.h"
 #include "../validation/validator.h"
+#include "Utility/AllocationProfiler.h"
+#include "Utility/date.h"
 #include <iostream>
 #include <limits>
+#include <functional>
+#include <vector>
+#include <sstream>
+
+namespace
+{
+    const int listPageSize = 20;
+
+    // Shared pager for the "view all" screens. fetchAfter/fetchBefore return up
+    // to `limit` rows in ascending id order on either side of an id, so every
+    // page is one indexed range query however far into the table it is.
+    template <typename Row>
+    void browseKeysetPages(const std::string &heading, const std::string &emptyMessage,
+                           const std::function<std::vector<Row>(int, int)> &fetchAfter,
+                           const std::function<std::vector<Row>(int, int)> &fetchBefore,
+                           const std::function<int(const Row &)> &idOf,
+                           const std::function<void(const Row &)> &printRow)
+    {
+        // Ask for one extra row so we know whether another page exists
+        std::vector<Row> rows = fetchAfter(0, listPageSize + 1);
+        bool hasNext = static_cast<int>(rows.size()) > listPageSize;
+        bool hasPrev = false;
+        if (hasNext)
+            rows.pop_back();
+
+        int firstId = rows.empty() ? 0 : idOf(rows.front());
+        int lastId = rows.empty() ? 0 : idOf(rows.back());
+
+        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+
+        while (true)
+        {
+            std::cout << "\n--- " << heading;
+            if (!rows.empty())
+                std::cout << " (IDs " << firstId << " - " << lastId << ")";
+            std::cout << " ---\n";
+
+            if (rows.empty())
+                std::cout << emptyMessage << "\n";
+            for (const Row &row : rows)
+                printRow(row);
+
+            std::cout << "\n" << (hasNext ? "[N] Next page  " : "") << (hasPrev ? "[P] Previous page  " : "")
+                      << "[J] Jump to ID  [Enter] Done: ";
+            std::string nav;
+            std::getline(std::cin, nav);
+
+            if (hasNext && (nav == "n" || nav == "N"))
+            {
+                rows = fetchAfter(lastId, listPageSize + 1);
+                hasNext = static_cast<int>(rows.size()) > listPageSize;
+                hasPrev = true;
+                if (hasNext)
+                    rows.pop_back();
+            }
+            else if (hasPrev && (nav == "p" || nav == "P"))
+            {
+                rows = fetchBefore(firstId, listPageSize + 1);
+                hasPrev = static_cast<int>(rows.size()) > listPageSize;
+                hasNext = true;
+                if (hasPrev)
+                    rows.erase(rows.begin());
+            }
+            else if (nav == "j" || nav == "J")
+            {
+                int targetId;
+                std::cout << "Enter ID to jump to: ";
+                if (!(std::cin >> targetId))
+                {
+                    std::cin.clear();
+                    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                    continue;
+                }
+                std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+
+                // Ids start at 1; clamping also keeps targetId - 1 from overflowing.
+                if (targetId < 1)
+                    targetId = 1;
+
+                rows = fetchAfter(targetId - 1, listPageSize + 1);
+                hasNext = static_cast<int>(rows.size()) > listPageSize;
+                hasPrev = !fetchBefore(targetId, 1).empty();
+                if (hasNext)
+                    rows.pop_back();
+
+                // Keeps [P] working even when the jump lands past the last row.
+                firstId = targetId;
+                lastId = targetId - 1;
+            }
+            else
+            {
+                return;
+            }
+
+            if (!rows.empty())
+            {
+                firstId = idOf(rows.front());
+                lastId = idOf(rows.back());
+            }
+        }
+    }
+}
 
 AdminMenu::AdminMenu(AdminService &service, const std::string &today)
     : adminService(service), simulatedToday(today), currentAdminId(-1) {}
@@ -99,6 +203,7 @@ void AdminMenu::displayCatalogMenu()
         std::cout << "6. Edit Category\n";
         std::cout << "7. Delete Category\n";
         std::cout << "8. View All Categories\n";
+        std::cout << "9. Import Resources from File (CSV / JSON Lines)\n";
         std::cout << "0. Back to Main Dashboard\n";
         std::cout << "========================================\n";
         std::cout << "Enter your choice: ";
@@ -136,6 +241,9 @@ void AdminMenu::displayCatalogMenu()
         case 8:
             handleViewAllCategories();
             break;
+        case 9:
+            handleImportResources();
+            break;
 
         case 0:
             running = false;
@@ -354,19 +462,20 @@ void AdminMenu::handleDeleteResource()
 
 void AdminMenu::handleViewAllResources()
 {
-    std::cout << "\n--- ALL RESOURCES ---\n";
-    std::vector<Resource> resources = adminService.viewAllResources();
-    if (resources.empty())
-        std::cout << "No resources found.\n";
-    for (const auto &r : resources)
-    {
-        std::cout << "ID: " << r.getResourceId() << " | Title: '" << r.getTitle()
-                  << "' | Category ID: " << r.getCategoryId()
-                  << " | Avail: " << r.getAvailableCopies() << "/" << r.getTotalCopies() << "\n";
-    }
-    std::cout << "Press Enter to continue...";
-    std::cin.ignore(10000, '\n');
-    std::cin.get();
+    browseKeysetPages<Resource>(
+        "ALL RESOURCES", "No resources found.",
+        [this](int afterId, int limit)
+        { return adminService.viewResourcesAfter(afterId, limit); },
+        [this](int beforeId, int limit)
+        { return adminService.viewResourcesBefore(beforeId, limit); },
+        [](const Resource &r)
+        { return r.getResourceId(); },
+        [](const Resource &r)
+        {
+            std::cout << "ID: " << r.getResourceId() << " | Title: '" << r.getTitle()
+                      << "' | Category ID: " << r.getCategoryId()
+                      << " | Avail: " << r.getAvailableCopies() << "/" << r.getTotalCopies() << "\n";
+        });
 }
 
 void AdminMenu::handleAddCategory()
@@ -487,6 +596,57 @@ void AdminMenu::handleViewAllCategories()
     std::cin.get();
 }
 
+void AdminMenu::handleImportResources()
+{
+    std::string path, rejectsFile;
+
+    std::cout << "\n--- IMPORT RESOURCES ---\n";
+    std::cout << "CSV files need a header row with: title, author, publisher, publication_year,\n"
+              << "isbn, category_id, total_copies (optional: available_copies, description,\n"
+              << "added_date, is_active). .jsonl / .ndjson / .json files hold one object per line.\n\n";
+
+    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n'); // Clear buffer
+
+    std::cout << "Enter file path: ";
+    std::getline(std::cin, path);
+    if (path.empty())
+        return;
+
+    std::cout << "Write rejected rows to (leave blank to skip): ";
+    std::getline(std::cin, rejectsFile);
+
+    ImportOptions options;
+    options.defaultAddedDate = simulatedToday;
+    options.rejectsFile = rejectsFile;
+
+    ImportSummary summary = adminService.importResources(path, options, [](const ImportSummary &soFar)
+                                                         { std::cout << "\r  " << soFar.rowsRead << " rows read, "
+                                                                     << soFar.imported << " imported, "
+                                                                     << soFar.rejected << " rejected" << std::flush; });
+
+    std::cout << "\n\n";
+    if (!summary.success)
+        std::cout << " Import stopped: " << summary.error << "\n";
+
+    std::cout << " Rows read: " << summary.rowsRead << "\n"
+              << " Imported:  " << summary.imported << "\n"
+              << " Rejected:  " << summary.rejected << "\n"
+              << " Time:      " << summary.elapsedMs / 1000.0 << " s\n";
+
+    if (!summary.firstRejections.empty())
+    {
+        std::cout << "\n First rejected rows:\n";
+        for (const ImportRejection &rejection : summary.firstRejections)
+            std::cout << "  - line " << rejection.line << ": " << rejection.reason << "\n";
+        if (summary.rejected > static_cast<long long>(summary.firstRejections.size()))
+            std::cout << "  ... " << summary.rejected - summary.firstRejections.size() << " more"
+                      << (rejectsFile.empty() ? "\n" : " in " + rejectsFile + "\n");
+    }
+
+    std::cout << "Press Enter to continue...";
+    std::cin.get();
+}
+
 /* *************************************************************************
                   ---------- MEMBER MANAGEMENT ----------
    ************************************************************************* */
@@ -858,26 +1018,21 @@ void AdminMenu::handleProcessAccountDeletion()
 
 void AdminMenu::handleViewAllUsers()
 {
-    std::cout << "\n--- ALL REGISTERED MEMBERS ---\n";
-    std::vector<User> users = adminService.viewAllUsers();
-
-    if (users.empty())
-    {
-        std::cout << "No users found in the system.\n";
-    }
-    else
-    {
-        for (const User &u : users)
+    browseKeysetPages<User>(
+        "ALL REGISTERED MEMBERS", "No users found in the system.",
+        [this](int afterId, int limit)
+        { return adminService.viewUsersAfter(afterId, limit); },
+        [this](int beforeId, int limit)
+        { return adminService.viewUsersBefore(beforeId, limit); },
+        [](const User &u)
+        { return u.getUserId(); },
+        [](const User &u)
         {
             std::cout << "ID: " << u.getUserId()
                       << " | Name: " << u.getFirstName() << " " << u.getLastName()
                       << " | Username: " << u.getUsername()
                       << " | Active: " << (u.getIsActive() ? "Yes" : "SUSPENDED") << "\n";
-        }
-    }
-    std::cout << "\nPress Enter to continue...";
-    std::cin.ignore(10000, '\n');
-    std::cin.get();
+        });
 }
 
 /* *************************************************************************
@@ -903,6 +1058,8 @@ void AdminMenu::displayCirculationMenu()
         std::cout << "6. View All Reservations\n";
         std::cout << "7. View Reservations By User\n";
         std::cout << "8. Cancel a Reservation\n";
+        std::cout << "9. View Loans Due Soon\n";
+        std::cout << "10. View Expired Reservations\n";
         std::cout << "0. Back to Main Dashboard\n";
         std::cout << "========================================\n";
         std::cout << "Enter your choice: ";
@@ -962,6 +1119,12 @@ void AdminMenu::displayCirculationMenu()
         case 8:
             handleCancelReservation();
             break;
+        case 9:
+            handleViewDueSoon();
+            break;
+        case 10:
+            handleViewExpiredReservations();
+            break;
 
         case 0:
             running = false;
@@ -1041,18 +1204,19 @@ void AdminMenu::handleProcessReturn()
 
 void AdminMenu::handleViewAllTransactions()
 {
-    std::cout << "\n--- ALL TRANSACTIONS ---\n";
-    std::vector<Transaction> txns = adminService.viewAllTransactions();
-    if (txns.empty())
-        std::cout << "No transactions found.\n";
-    for (const auto &t : txns)
-    {
-        std::cout << "Txn ID: " << t.getTransactionId() << " | User: " << t.getUserId()
-                  << " | Res: " << t.getResourceId() << " | Status: " << t.getTransactionStatus() << "\n";
-    }
-    std::cout << "Press Enter to continue...";
-    std::cin.ignore(10000, '\n');
-    std::cin.get();
+    browseKeysetPages<Transaction>(
+        "ALL TRANSACTIONS", "No transactions found.",
+        [this](int afterId, int limit)
+        { return adminService.viewTransactionsAfter(afterId, limit); },
+        [this](int beforeId, int limit)
+        { return adminService.viewTransactionsBefore(beforeId, limit); },
+        [](const Transaction &t)
+        { return t.getTransactionId(); },
+        [](const Transaction &t)
+        {
+            std::cout << "Txn ID: " << t.getTransactionId() << " | User: " << t.getUserId()
+                      << " | Res: " << t.getResourceId() << " | Status: " << t.getTransactionStatus() << "\n";
+        });
 }
 
 void AdminMenu::handleViewUserTransactions()
@@ -1083,14 +1247,15 @@ void AdminMenu::handleViewUserTransactions()
 void AdminMenu::handleViewAllReservations()
 {
     std::cout << "\n--- ALL RESERVATIONS ---\n";
-    std::vector<Reservation> holds = adminService.viewAllReservations();
-    if (holds.empty())
-        std::cout << "No active reservations found.\n";
-    for (const auto &r : holds)
+    int count = 0;
+    adminService.forEachReservation([&count](const Reservation &r)
     {
         std::cout << "Hold ID: " << r.getReservationId() << " | User: " << r.getUserId()
                   << " | Res: " << r.getResourceId() << " | Status: " << r.getStatus() << "\n";
-    }
+        count++;
+    });
+    if (count == 0)
+        std::cout << "No active reservations found.\n";
     std::cout << "Press Enter to continue...";
     std::cin.ignore(10000, '\n');
     std::cin.get();
@@ -1144,6 +1309,47 @@ void AdminMenu::handleCancelReservation()
     std::cin.get();
 }
 
+void AdminMenu::handleViewDueSoon()
+{
+    int days;
+    std::cout << "\nShow loans due within how many days? ";
+    if (!(std::cin >> days) || days < 0)
+    {
+        std::cin.clear();
+        std::cin.ignore(10000, '\n');
+        return;
+    }
+
+    std::cout << "\n--- LOANS DUE BY " << getDueDate(days, simulatedToday) << " ---\n";
+    std::vector<Transaction> due = adminService.viewIssuesDueSoon(simulatedToday, days);
+    if (due.empty())
+        std::cout << "No loans fall due in that window.\n";
+    for (const auto &txn : due)
+    {
+        std::cout << "Txn ID: " << txn.getTransactionId() << " | User: " << txn.getUserId()
+                  << " | Res: " << txn.getResourceId() << " | Due: " << txn.getDueDate() << "\n";
+    }
+    std::cout << "Press Enter to continue...";
+    std::cin.ignore(10000, '\n');
+    std::cin.get();
+}
+
+void AdminMenu::handleViewExpiredReservations()
+{
+    std::cout << "\n--- RESERVATIONS PAST EXPIRY ---\n";
+    std::vector<Reservation> expired = adminService.viewExpiredReservations(simulatedToday);
+    if (expired.empty())
+        std::cout << "No pending reservations have expired.\n";
+    for (const auto &r : expired)
+    {
+        std::cout << "Hold ID: " << r.getReservationId() << " | User: " << r.getUserId()
+                  << " | Res: " << r.getResourceId() << " | Expired: " << r.getExpiryDate() << "\n";
+    }
+    std::cout << "Press Enter to continue...";
+    std::cin.ignore(10000, '\n');
+    std::cin.get();
+}
+
 /* *************************************************************************
                     ---------- FINANCIAL DESK ----------
    ************************************************************************* */
@@ -1364,26 +1570,21 @@ void AdminMenu::handleReceiveFinePayment()
 
 void AdminMenu::handleViewAllFines()
 {
-    std::cout << "\n--- ALL SYSTEM FINES ---\n";
-    std::vector<Fine> fines = adminService.viewAllFines();
-
-    if (fines.empty())
-    {
-        std::cout << "No fines exist in the system.\n";
-    }
-    else
-    {
-        for (const Fine &f : fines)
+    browseKeysetPages<Fine>(
+        "ALL SYSTEM FINES", "No fines exist in the system.",
+        [this](int afterId, int limit)
+        { return adminService.viewFinesAfter(afterId, limit); },
+        [this](int beforeId, int limit)
+        { return adminService.viewFinesBefore(beforeId, limit); },
+        [](const Fine &f)
+        { return f.getFineId(); },
+        [](const Fine &f)
         {
             std::cout << "Fine ID: " << f.getFineId()
                       << " | User ID: " << f.getUserId()
                       << " | Amount: $" << f.getFineAmount()
                       << " | Status: " << (f.getIsPaid() ? "PAID" : "UNPAID") << "\n";
-        }
-    }
-    std::cout << "\nPress Enter to continue...";
-    std::cin.ignore(10000, '\n');
-    std::cin.get();
+        });
 }
 
 void AdminMenu::handleImposeFine()
@@ -1549,6 +1750,8 @@ void AdminMenu::displayReportingMenu()
         std::cout << "========================================\n";
         std::cout << "1. User Borrowing History Report\n";
         std::cout << "2. Issued/Overdue Resources Report\n";
+        std::cout << "3. Export Table (CSV / JSON Lines)\n";
+        std::cout << "4. Report Jobs (" << adminService.getActiveReportJobCount() << " running or queued)\n";
         std::cout << "0. Back to Main Dashboard\n";
         std::cout << "========================================\n";
         std::cout << "Enter your choice: ";
@@ -1568,6 +1771,12 @@ void AdminMenu::displayReportingMenu()
         case 2:
             handleGenerateIssue_OverdueReport();
             break;
+        case 3:
+            handleExportTable();
+            break;
+        case 4:
+            handleViewReportJobs();
+            break;
         case 0:
             running = false;
             break;
@@ -1596,7 +1805,17 @@ void AdminMenu::handleGenerateHistoryReport()
         std::cout << "No filename provided. Defaulting to: " << filename << "\n";
     }
 
-    if (adminService.generateUserHistoryReport(filename))
+    int jobId = adminService.queueUserHistoryReport(filename);
+    if (jobId > 0)
+    {
+        std::cout << " Queued as report job #" << jobId << ". Track it under Report Jobs.\n";
+    }
+    else if (jobId == ReportJobQueue::fileInUse)
+    {
+        std::cout << " A report job is already writing " << filename
+                  << ". Wait for it under Report Jobs or choose another filename.\n";
+    }
+    else if (adminService.generateUserHistoryReport(filename))
     {
         std::cout << " Report generated successfully!\n";
     }
@@ -1625,7 +1844,17 @@ void AdminMenu::handleGenerateIssue_OverdueReport()
         std::cout << "No filename provided. Defaulting to: " << filename << "\n";
     }
 
-    if (adminService.generateIssuedAndOverdueReport(filename))
+    int jobId = adminService.queueIssuedAndOverdueReport(filename);
+    if (jobId > 0)
+    {
+        std::cout << " Queued as report job #" << jobId << ". Track it under Report Jobs.\n";
+    }
+    else if (jobId == ReportJobQueue::fileInUse)
+    {
+        std::cout << " A report job is already writing " << filename
+                  << ". Wait for it under Report Jobs or choose another filename.\n";
+    }
+    else if (adminService.generateIssuedAndOverdueReport(filename))
     {
         std::cout << " Report generated successfully!\n";
     }
@@ -1638,6 +1867,135 @@ void AdminMenu::handleGenerateIssue_OverdueReport()
     std::cin.get();
 }
 
+void AdminMenu::handleViewReportJobs()
+{
+    std::cout << "\n--- REPORT JOBS ---\n";
+    std::vector<ReportJobStatus> jobs = adminService.viewReportJobs();
+    if (jobs.empty())
+        std::cout << "No report jobs. Reports queue here when you generate them.\n";
+
+    for (const auto &job : jobs)
+    {
+        std::cout << "Job #" << job.jobId << " | " << job.title << " -> " << job.filename << " | ";
+        switch (job.state)
+        {
+        case ReportJobState::Queued:
+            std::cout << "QUEUED";
+            break;
+        case ReportJobState::Running:
+            std::cout << "RUNNING " << job.done;
+            if (job.total > 0)
+                std::cout << "/" << job.total << " (" << job.done * 100 / job.total << "%)";
+            break;
+        case ReportJobState::Succeeded:
+            std::cout << "DONE";
+            break;
+        case ReportJobState::Failed:
+            std::cout << "FAILED";
+            break;
+        }
+        if (job.state != ReportJobState::Queued)
+            std::cout << " | " << static_cast<long long>(job.elapsedMs) << " ms";
+        std::cout << "\n";
+    }
+
+    std::cout << "\nClear finished jobs from the list? (y/n): ";
+    char confirm;
+    std::cin >> confirm;
+    if (confirm == 'y' || confirm == 'Y')
+        std::cout << " Cleared " << adminService.clearFinishedReportJobs() << " jobs.\n";
+
+    std::cout << "Press Enter to continue...";
+    std::cin.ignore(10000, '\n');
+    std::cin.get();
+}
+
+void AdminMenu::handleExportTable()
+{
+    const std::vector<std::string> &tables = TableExporter::getExportableTables();
+    int tableChoice;
+
+    std::cout << "\n--- EXPORT TABLE ---\n";
+    for (std::size_t t = 0; t < tables.size(); t++)
+        std::cout << t + 1 << ". " << tables[t] << "\n";
+    std::cout << "Select table: ";
+    if (!(std::cin >> tableChoice) || tableChoice < 1 || tableChoice > static_cast<int>(tables.size()))
+    {
+        std::cin.clear();
+        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        return;
+    }
+    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+
+    ExportOptions options;
+    options.table = tables[tableChoice - 1];
+
+    std::cout << "\nColumns:";
+    for (const std::string &column : adminService.getExportColumns(options.table))
+        std::cout << " " << column;
+    std::cout << "\nColumns to export, comma-separated (leave blank for all): ";
+
+    std::string line;
+    std::getline(std::cin, line);
+    std::size_t start = 0;
+    while (start < line.size())
+    {
+        std::size_t comma = line.find(',', start);
+        if (comma == std::string::npos)
+            comma = line.size();
+        std::string column = line.substr(start, comma - start);
+        column.erase(0, column.find_first_not_of(" \t"));
+        column.erase(column.find_last_not_of(" \t") + 1);
+        if (!column.empty())
+            options.columns.push_back(column);
+        start = comma + 1;
+    }
+
+    std::cout << "Filters, one per line as <column> <operator> <value>, e.g. status = ISSUED\n"
+              << "(operators: = != < <= > >= LIKE; leave blank to finish):\n";
+    while (true)
+    {
+        std::cout << "> ";
+        std::getline(std::cin, line);
+        if (line.find_first_not_of(" \t") == std::string::npos)
+            break;
+
+        ExportFilter filter;
+        std::istringstream parts(line);
+        parts >> filter.column >> filter.op;
+        std::getline(parts >> std::ws, filter.value);
+        if (filter.column.empty() || filter.op.empty())
+        {
+            std::cout << "  Expected: <column> <operator> <value>\n";
+            continue;
+        }
+        options.filters.push_back(filter);
+    }
+
+    std::string filename;
+    std::cout << "Enter the name of the file to save (.csv, or .jsonl for JSON Lines): ";
+    std::getline(std::cin, filename);
+    if (filename.empty())
+    {
+        filename = options.table + ".csv";
+        std::cout << "No filename provided. Defaulting to: " << filename << "\n";
+    }
+
+    ExportSummary summary = adminService.exportTable(options, filename);
+    if (summary.success)
+    {
+        std::cout << " Exported " << summary.rows << " rows (" << summary.bytes << " bytes) in "
+                  << summary.elapsedMs / 1000.0 << " s.\n";
+    }
+    else
+    {
+        std::cout << " Export failed: " << summary.error << "\n";
+    }
+
+    std::cout << "Press Enter to continue...";
+    std::cin.get();
+}
+
 /* *************************************************************************
                  ---------- SYSTEM & ADMIN SETTINGS ----------
    ************************************************************************* */
@@ -1662,6 +2020,8 @@ void AdminMenu::displaySystemMenu()
         std::cout << "5. View All Administrators\n";
         std::cout << "6. Add New Administrator\n";
         std::cout << "7. Delete Administrator Account\n";
+        std::cout << "\n--- Diagnostics ---\n";
+        std::cout << "8. Memory Allocation Profile\n";
         std::cout << "0. Back to Main Dashboard\n";
         std::cout << "========================================\n";
         std::cout << "Enter your choice: ";
@@ -1696,6 +2056,9 @@ void AdminMenu::displaySystemMenu()
         case 7:
             handleDeleteAdministrator();
             break;
+        case 8:
+            handleViewAllocationProfile();
+            break;
         case 0:
             running = false;
             break;
@@ -1947,4 +2310,25 @@ void AdminMenu::handleDeleteAdministrator()
     std::cout << "Press Enter to continue...";
     std::cin.ignore(10000, '\n');
     std::cin.get();
-}
\ No newline at end of file
+}
+
+void AdminMenu::handleViewAllocationProfile()
+{
+    std::cout << "\n--- MEMORY ALLOCATION PROFILE ---\n";
+    AllocationProfiler::report(std::cout);
+
+    if (AllocationProfiler::enabled())
+    {
+        std::cout << "\nReset the counters? (y/n): ";
+        char confirm;
+        std::cin >> confirm;
+        if (confirm == 'y' || confirm == 'Y')
+        {
+            AllocationProfiler::reset();
+            std::cout << " Counters reset.\n";
+        }
+    }
+    std::cout << "Press Enter to continue...";
+    std::cin.ignore(10000, '\n');
+    std::cin.get();
+}
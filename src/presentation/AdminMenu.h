@@ -38,6 +38,7 @@ private:
     void handleDeleteResource();
     void handleViewAllResources();
     void handleViewAllCategories();
+    void handleImportResources();
 
     //Category
     void handleAddCategory();
@@ -68,17 +69,22 @@ private:
     void handleViewAllReservations();
     void handleViewUserReservations();
     void handleCancelReservation();
+    void handleViewDueSoon();
+    void handleViewExpiredReservations();
 
     void displaySystemMenu();
 
     // Reports
     void handleGenerateHistoryReport();
     void handleGenerateIssue_OverdueReport();
+    void handleExportTable();
+    void handleViewReportJobs();
 
 
     void handleViewAllAdministrators();
     void handleAddAdministrator();
     void handleDeleteAdministrator();
+    void handleViewAllocationProfile();
 
     void handleViewAllMembershipTypes();
     void handleAddMembershipType();
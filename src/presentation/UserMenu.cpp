@@ -229,44 +229,69 @@ void UserMenu::requestBalanceTopUp()
 
 void UserMenu::browseCatalogue()
 {
-    std::vector<Resource> resources = userService.showAllAvailableCatalogue();
     std::cout << "\n=== AVAILABLE RESOURCES ===\n";
-    if (resources.empty())
+    // Active resources with copies on the shelf
+    const CatalogueSnapshot &catalogue = userService.getCatalogueSnapshot();
+    std::vector<std::uint32_t> rows;
+    std::size_t count = catalogue.collectAvailable(rows);
+    for (std::uint32_t row : rows)
     {
-        std::cout << "No resources are currently available.\n";
+        std::cout << "ID: " << catalogue.resourceId(row) << " | Title: " << catalogue.title(row) << " | Author: " << catalogue.author(row) << " | Available: " << catalogue.availableCopiesAt(row) << "\n";
     }
-    else
+    if (count == 0)
     {
-        for (const auto &res : resources)
-        {
-            std::cout << "ID: " << res.getResourceId() << " | Title: " << res.getTitle() << " | Author: " << res.getAuthor() << " | Available: " << res.getAvailableCopies() << "\n";
-        }
+        std::cout << "No resources are currently available.\n";
     }
     pauseAndClear();
 }
 
 void UserMenu::searchCatalogue()
 {
+    const int pageSize = 20;
     std::string keyword;
     std::cout << "\n=== SEARCH CATALOGUE ===\n";
-    std::cout << "Enter title or author keyword: ";
+    std::cout << "Enter title, author, publisher or ISBN keywords: ";
     std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
     std::getline(std::cin, keyword);
 
-    std::vector<Resource> matches = userService.searchCatalogue(keyword);
-    std::cout << "\n--- Search Results ---\n";
-    if (matches.empty())
-    {
-        std::cout << "No matching resources found.\n";
-    }
-    else
+    int page = 0;
+    while (true)
     {
-        for (const auto &book : matches)
+        // Ask for one extra row so we know whether a next page exists
+        std::vector<Resource> matches = userService.searchCatalogue(keyword, pageSize + 1, page * pageSize);
+        bool hasNext = static_cast<int>(matches.size()) > pageSize;
+        if (hasNext)
+            matches.pop_back();
+
+        std::cout << "\n--- Search Results (page " << page + 1 << ") ---\n";
+        if (matches.empty())
         {
-            std::cout << "ID: " << book.getResourceId() << " | Title: " << book.getTitle()
-                      << " | Author: " << book.getAuthor()
-                      << " | Available: " << book.getAvailableCopies() << "\n";
+            std::cout << "No matching resources found.\n";
         }
+        else
+        {
+            for (const auto &book : matches)
+            {
+                std::cout << "ID: " << book.getResourceId() << " | Title: " << book.getTitle()
+                          << " | Author: " << book.getAuthor()
+                          << " | Available: " << book.getAvailableCopies() << "\n";
+            }
+        }
+
+        if (!hasNext && page == 0)
+            break;
+
+        std::cout << "\n" << (hasNext ? "[N] Next page  " : "") << (page > 0 ? "[P] Previous page  " : "")
+                  << "[Enter] Done: ";
+        std::string nav;
+        std::getline(std::cin, nav);
+
+        if (hasNext && (nav == "n" || nav == "N"))
+            page++;
+        else if (page > 0 && (nav == "p" || nav == "P"))
+            page--;
+        else
+            return;
     }
     pauseAndClear();
 }
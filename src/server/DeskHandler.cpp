@@ -0,0 +1,271 @@
+#include "DeskHandler.h"
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+namespace
+{
+    const char *const commandHelp[] = {
+        "PING | HELP",
+        "LOGIN_USER <username> <password>",
+        "LOGIN_ADMIN <username> <password>",
+        "LOGOUT",
+        "QUIT",
+        "user: SEARCH <keywords> | BORROW <resourceId> | CANCEL <transactionId> | LOANS | REQUESTS | FINES",
+        "admin: PENDING | APPROVE <transactionId> | REJECT <transactionId> | RETURN <transactionId> | DUE_SOON <days>",
+    };
+
+    std::string money(double amount)
+    {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%.2f", amount);
+        return buffer;
+    }
+
+    DeskReply message(const std::string &text)
+    {
+        DeskReply reply;
+        reply.rows.push_back(text);
+        return reply;
+    }
+
+    // Argument check shared by every command that takes one id.
+    bool singleId(const DeskRequest &request, int &id)
+    {
+        return DeskProtocol::parseId(request.arguments, id);
+    }
+
+    void addTransactionRows(DeskReply &reply, const std::vector<Transaction> &transactions)
+    {
+        for (const Transaction &transaction : transactions)
+        {
+            reply.rows.push_back(DeskProtocol::row({std::to_string(transaction.getTransactionId()),
+                                                    std::to_string(transaction.getUserId()),
+                                                    std::to_string(transaction.getResourceId()),
+                                                    transaction.getTransactionStatus(),
+                                                    transaction.getIssueDate(),
+                                                    transaction.getDueDate()}));
+        }
+    }
+}
+
+/* *************************************************************************
+                 ---------- CONSTRUCTORS & DESTRUCTORS ----------
+   *************************************************************************  */
+
+// Every worker writes resources through its own repository, so the
+// per-repository LRU cache would go stale; it is turned off here (capacity 0).
+DeskHandler::Services::Services(sqlite3 *db, StatementCache &statements)
+    : userRepo(db, statements), adminRepo(db, statements), resourceRepo(db, statements, 0),
+      categoryRepo(db, statements), transactionRepo(db, statements), fineRepo(db, statements),
+      historyRepo(db, statements), fundReqRepo(db, statements), membershipRepo(db, statements),
+      reservationRepo(db, statements), tableExporter(db, statements),
+      authService(userRepo, adminRepo),
+      userService(userRepo, resourceRepo, transactionRepo, fineRepo, historyRepo, fundReqRepo, membershipRepo),
+      adminService(userRepo, fineRepo, resourceRepo, categoryRepo, fundReqRepo, transactionRepo, reservationRepo,
+                   membershipRepo, historyRepo, adminRepo, tableExporter) {}
+
+DeskHandler::DeskHandler(ConnectionPool &connectionPool, const std::string &date)
+    : pool(connectionPool), systemDate(date), reader(connectionPool.tryAcquireReader())
+{
+    if (!reader)
+        return;
+    reads = std::make_unique<Services>(reader.connection(), reader.statements());
+
+    ConnectionPool::WriteLease writer = pool.acquireWriter();
+    if (writer)
+        writes = std::make_unique<Services>(writer.connection(), writer.statements());
+}
+
+/* *************************************************************************
+                        ---------- DISPATCH ----------
+   *************************************************************************  */
+
+DeskReply DeskHandler::handle(const std::string &line, ActiveSession &session)
+{
+    DeskRequest request;
+    if (!DeskProtocol::parseRequest(line, request))
+        return DeskProtocol::failure("Empty request.");
+
+    if (request.command == "PING")
+        return message("PONG " + systemDate);
+
+    if (request.command == "HELP")
+    {
+        DeskReply reply;
+        for (const char *entry : commandHelp)
+            reply.rows.push_back(entry);
+        return reply;
+    }
+
+    if (request.command == "QUIT")
+    {
+        session.isExit = true;
+        return message("Goodbye.");
+    }
+
+    if (request.command == "LOGIN_USER" || request.command == "LOGIN_ADMIN")
+        return handleLogin(request, session);
+
+    if (request.command == "LOGOUT")
+    {
+        session = ActiveSession();
+        return message("Logged out.");
+    }
+
+    if (session.userId != -1)
+        return handleUserCommand(request, session.userId);
+    if (session.adminId != -1)
+        return handleAdminCommand(request);
+
+    return DeskProtocol::failure("Log in first (LOGIN_USER or LOGIN_ADMIN).");
+}
+
+DeskReply DeskHandler::handleLogin(const DeskRequest &request, ActiveSession &session)
+{
+    std::vector<std::string> fields;
+    if (!DeskProtocol::splitArguments(request.arguments, 2, fields))
+        return DeskProtocol::failure("Usage: " + request.command + " <username> <password>");
+
+    session = ActiveSession();
+    if (request.command == "LOGIN_USER")
+    {
+        std::unique_ptr<User> user = reads->authService.loginUser(fields[0], fields[1]);
+        if (!user)
+            return DeskProtocol::failure("Invalid username or password.");
+        if (!user->getIsActive())
+            return DeskProtocol::failure("This account is suspended.");
+
+        session.userId = user->getUserId();
+        return message(DeskProtocol::row({std::to_string(user->getUserId()), user->getFirstName() + " " + user->getLastName()}));
+    }
+
+    std::unique_ptr<Administrator> admin = reads->authService.loginAdmin(fields[0], fields[1]);
+    if (!admin)
+        return DeskProtocol::failure("Invalid username or password.");
+
+    session.adminId = admin->getAdminId();
+    return message(DeskProtocol::row({std::to_string(admin->getAdminId()), admin->getFirstName() + " " + admin->getLastName()}));
+}
+
+/* *************************************************************************
+                      ---------- USER COMMANDS ----------
+   *************************************************************************  */
+
+DeskReply DeskHandler::handleUserCommand(const DeskRequest &request, int userId)
+{
+    int id = 0;
+
+    if (request.command == "SEARCH")
+    {
+        if (request.arguments.empty())
+            return DeskProtocol::failure("Usage: SEARCH <keywords>");
+
+        DeskReply reply;
+        for (const Resource &resource : reads->userService.searchCatalogue(request.arguments))
+        {
+            reply.rows.push_back(DeskProtocol::row({std::to_string(resource.getResourceId()), resource.getTitle(),
+                                                    resource.getAuthor(), std::to_string(resource.getAvailableCopies())}));
+        }
+        return reply;
+    }
+
+    if (request.command == "BORROW")
+    {
+        if (!singleId(request, id))
+            return DeskProtocol::failure("Usage: BORROW <resourceId>");
+        ConnectionPool::WriteLease writer = pool.acquireWriter();
+        return message(writes->userService.requestToBorrow(userId, id));
+    }
+
+    if (request.command == "CANCEL")
+    {
+        if (!singleId(request, id))
+            return DeskProtocol::failure("Usage: CANCEL <transactionId>");
+        ConnectionPool::WriteLease writer = pool.acquireWriter();
+        if (!writes->userService.cancelPendingBorrowRequest(id, userId))
+            return DeskProtocol::failure("No pending request " + std::to_string(id) + " for this account.");
+        return message("Request cancelled.");
+    }
+
+    if (request.command == "LOANS" || request.command == "REQUESTS")
+    {
+        DeskReply reply;
+        addTransactionRows(reply, request.command == "LOANS" ? reads->userService.getCurrentlyBorrowedResources(userId)
+                                                             : reads->userService.getPendingBorrowRequests(userId));
+        return reply;
+    }
+
+    if (request.command == "FINES")
+    {
+        DeskReply reply;
+        for (const Fine &fine : reads->userService.getCurrentFines(userId))
+        {
+            reply.rows.push_back(DeskProtocol::row({std::to_string(fine.getFineId()), std::to_string(fine.getTransactionId()),
+                                                    std::to_string(fine.getDaysOverdue()), money(fine.getFineAmount()),
+                                                    fine.getIsPaid() ? "PAID" : "UNPAID"}));
+        }
+        return reply;
+    }
+
+    return DeskProtocol::failure("Unknown user command: " + request.command);
+}
+
+/* *************************************************************************
+                      ---------- ADMIN COMMANDS ----------
+   *************************************************************************  */
+
+DeskReply DeskHandler::handleAdminCommand(const DeskRequest &request)
+{
+    int id = 0;
+
+    if (request.command == "PENDING")
+    {
+        DeskReply reply;
+        addTransactionRows(reply, reads->adminService.viewPendingBorrowRequests());
+        return reply;
+    }
+
+    if (request.command == "APPROVE" || request.command == "REJECT")
+    {
+        if (!singleId(request, id))
+            return DeskProtocol::failure("Usage: " + request.command + " <transactionId>");
+
+        std::string today = systemDate;
+        ConnectionPool::WriteLease writer = pool.acquireWriter();
+        if (!writes->adminService.processBorrowRequest(id, request.command == "APPROVE", today))
+            return DeskProtocol::failure("Request " + std::to_string(id) + " is not pending or could not be processed.");
+        return message(request.command == "APPROVE" ? "Request approved." : "Request rejected.");
+    }
+
+    if (request.command == "RETURN")
+    {
+        if (!singleId(request, id))
+            return DeskProtocol::failure("Usage: RETURN <transactionId>");
+
+        std::string today = systemDate;
+        ConnectionPool::WriteLease writer = pool.acquireWriter();
+        if (!writes->adminService.processReturn(id, today))
+            return DeskProtocol::failure("Transaction " + std::to_string(id) + " is not an open issue.");
+        return message("Return processed.");
+    }
+
+    if (request.command == "DUE_SOON")
+    {
+        int days = 7;
+        if (!request.arguments.empty() && !DeskProtocol::parseId(request.arguments, days))
+            return DeskProtocol::failure("Usage: DUE_SOON [days]");
+
+        DeskReply reply;
+        addTransactionRows(reply, reads->adminService.viewIssuesDueSoon(systemDate, days));
+        return reply;
+    }
+
+    return DeskProtocol::failure("Unknown admin command: " + request.command);
+}
+
+FineUpdateSummary DeskHandler::updateDailyFines()
+{
+    ConnectionPool::WriteLease writer = pool.acquireWriter();
+    return writes->adminService.updateDailyFines(systemDate);
+}
@@ -0,0 +1,87 @@
+#pragma once
+extern "C"
+{
+#include "sqlite3.h"
+}
+#include <memory>
+#include <string>
+
+#include "DeskProtocol.h"
+#include "../presentation/Session.h"
+#include "../infrastructure/database/StatementCache.h"
+#include "../infrastructure/database/ConnectionPool.h"
+#include "../infrastructure/repositories/UserRepository.h"
+#include "../infrastructure/repositories/AdministratorRepository.h"
+#include "../infrastructure/repositories/ResourceRepository.h"
+#include "../infrastructure/repositories/CategoryRepository.h"
+#include "../infrastructure/repositories/TransactionRepository.h"
+#include "../infrastructure/repositories/FineRepository.h"
+#include "../infrastructure/repositories/BorrowingHistoryRepository.h"
+#include "../infrastructure/repositories/FundRequestRepository.h"
+#include "../infrastructure/repositories/MembershipTypeRepository.h"
+#include "../infrastructure/repositories/ReservationRepository.h"
+#include "../export/TableExporter.h"
+#include "../services/AuthenticationService.h"
+#include "../services/UserService.h"
+#include "../services/AdminService.h"
+
+// One desk server worker's view of the library: the same repositories and
+// services main() wires up, built once so prepared statements stay warm
+// between requests.
+//
+// Reads run on a reader leased from the server's ConnectionPool for the
+// handler's lifetime, side by side with the other workers under WAL. Requests
+// that write go through a second set of services on the pool's writer and
+// only while holding acquireWriter(), so desks never race each other into
+// SQLITE_BUSY.
+class DeskHandler
+{
+private:
+    struct Services
+    {
+        UserRepository userRepo;
+        AdministratorRepository adminRepo;
+        ResourceRepository resourceRepo;
+        CategoryRepository categoryRepo;
+        TransactionRepository transactionRepo;
+        FineRepository fineRepo;
+        BorrowingHistoryRepository historyRepo;
+        FundRequestRepository fundReqRepo;
+        MembershipTypeRepository membershipRepo;
+        ReservationRepository reservationRepo;
+        TableExporter tableExporter;
+
+        AuthenticationService authService;
+        UserService userService;
+        AdminService adminService;
+
+        Services(sqlite3 *db, StatementCache &statements);
+    };
+
+    ConnectionPool &pool;
+    std::string systemDate;
+
+    ConnectionPool::ReadLease reader;
+    std::unique_ptr<Services> reads;  // on reader
+    std::unique_ptr<Services> writes; // on the pool's writer; used only under acquireWriter()
+
+    DeskReply handleLogin(const DeskRequest &request, ActiveSession &session);
+    DeskReply handleUserCommand(const DeskRequest &request, int userId);
+    DeskReply handleAdminCommand(const DeskRequest &request);
+
+public:
+    // Leases one of connectionPool's readers without waiting; check isReady().
+    DeskHandler(ConnectionPool &connectionPool, const std::string &date);
+
+    DeskHandler(const DeskHandler &) = delete;
+    DeskHandler &operator=(const DeskHandler &) = delete;
+
+    // False when no reader was free or the pool is not open.
+    bool isReady() const { return reads && writes; }
+
+    // Runs one request line for a client. Logins and LOGOUT update session;
+    // QUIT sets session.isExit.
+    DeskReply handle(const std::string &line, ActiveSession &session);
+
+    FineUpdateSummary updateDailyFines();
+};
@@ -0,0 +1,142 @@
+#include "DeskProtocol.h"
+#include <cctype>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+
+namespace
+{
+    void appendClean(std::string &out, std::string_view field)
+    {
+        for (char c : field)
+            out.push_back((c == '\t' || c == '\n' || c == '\r') ? ' ' : c);
+    }
+}
+
+namespace DeskProtocol
+{
+    bool parseRequest(std::string_view line, DeskRequest &request)
+    {
+        while (!line.empty() && (line.back() == '\n' || line.back() == '\r' || line.back() == ' '))
+            line.remove_suffix(1);
+        while (!line.empty() && line.front() == ' ')
+            line.remove_prefix(1);
+        if (line.empty())
+            return false;
+
+        std::size_t space = line.find(' ');
+        std::string_view command = line.substr(0, space);
+
+        request.command.clear();
+        for (char c : command)
+            request.command.push_back(static_cast<char>(std::toupper(static_cast<unsigned char>(c))));
+
+        request.arguments.clear();
+        if (space != std::string_view::npos)
+        {
+            std::string_view rest = line.substr(space + 1);
+            while (!rest.empty() && rest.front() == ' ')
+                rest.remove_prefix(1);
+            request.arguments.assign(rest);
+        }
+        return true;
+    }
+
+    bool splitArguments(const std::string &arguments, std::size_t count, std::vector<std::string> &fields)
+    {
+        fields.clear();
+        if (count == 0)
+            return true;
+
+        std::size_t position = 0;
+        while (fields.size() + 1 < count)
+        {
+            std::size_t space = arguments.find(' ', position);
+            if (space == std::string::npos)
+                return false;
+            fields.push_back(arguments.substr(position, space - position));
+            position = arguments.find_first_not_of(' ', space);
+            if (position == std::string::npos)
+                return false;
+        }
+
+        if (position >= arguments.size())
+            return false;
+        fields.push_back(arguments.substr(position));
+        return true;
+    }
+
+    bool parseId(const std::string &text, int &id)
+    {
+        if (text.empty())
+            return false;
+        errno = 0;
+        char *end = nullptr;
+        long value = std::strtol(text.c_str(), &end, 10);
+        if (errno != 0 || *end != '\0' || value <= 0 || value > INT_MAX)
+            return false;
+        id = static_cast<int>(value);
+        return true;
+    }
+
+    std::string row(std::initializer_list<std::string_view> fields)
+    {
+        std::string out;
+        bool first = true;
+        for (std::string_view field : fields)
+        {
+            if (!first)
+                out.push_back('\t');
+            appendClean(out, field);
+            first = false;
+        }
+        return out;
+    }
+
+    DeskReply failure(const std::string &message)
+    {
+        DeskReply reply;
+        reply.ok = false;
+        reply.error = message;
+        return reply;
+    }
+
+    std::string formatReply(const DeskReply &reply)
+    {
+        std::string out;
+        if (!reply.ok)
+        {
+            out = "ERR ";
+            appendClean(out, reply.error);
+            out.push_back('\n');
+            return out;
+        }
+
+        out = "OK " + std::to_string(reply.rows.size()) + "\n";
+        for (const std::string &line : reply.rows)
+        {
+            // Rows keep their tab separators; a stray line break would
+            // desynchronise the client's row count.
+            for (char c : line)
+                out.push_back((c == '\n' || c == '\r') ? ' ' : c);
+            out.push_back('\n');
+        }
+        return out;
+    }
+
+    bool parseReplyHeader(std::string_view line, bool &ok, std::size_t &rowCount)
+    {
+        if (line.substr(0, 4) == "ERR ")
+        {
+            ok = false;
+            rowCount = 0;
+            return true;
+        }
+        if (line.substr(0, 3) != "OK ")
+            return false;
+
+        ok = true;
+        rowCount = static_cast<std::size_t>(std::strtoul(std::string(line.substr(3)).c_str(), nullptr, 10));
+        return true;
+    }
+}
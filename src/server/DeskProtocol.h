@@ -0,0 +1,53 @@
+#pragma once
+#include <cstddef>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Line protocol between LibraryDeskServer and the desk clients.
+//
+// A request is one line: a command word, then its arguments separated by
+// spaces. A command's last argument takes the rest of the line, so search
+// keywords and passwords may contain spaces.
+//
+// A reply is either "OK <n>" followed by n rows (fields separated by tabs),
+// or a single "ERR <message>" line.
+
+struct DeskRequest
+{
+    std::string command;   // upper-cased
+    std::string arguments; // everything after the command word
+};
+
+struct DeskReply
+{
+    bool ok = true;
+    std::string error;
+    std::vector<std::string> rows;
+};
+
+namespace DeskProtocol
+{
+    // Longest request line a server accepts before dropping the client.
+    constexpr std::size_t maxLineBytes = 64 * 1024;
+    // Most unread input a server holds for one client, e.g. lines sent ahead
+    // while an earlier request is still running; past it the client is dropped.
+    constexpr std::size_t maxPendingBytes = 4 * maxLineBytes;
+
+    bool parseRequest(std::string_view line, DeskRequest &request);
+
+    // Splits arguments into exactly count fields; the last one keeps any
+    // remaining spaces. False when there are fewer than count.
+    bool splitArguments(const std::string &arguments, std::size_t count, std::vector<std::string> &fields);
+    bool parseId(const std::string &text, int &id);
+
+    // Joins fields with tabs. Tabs and line breaks inside a field become spaces.
+    std::string row(std::initializer_list<std::string_view> fields);
+
+    DeskReply failure(const std::string &message);
+    std::string formatReply(const DeskReply &reply);
+
+    // Reads an "OK <n>" / "ERR ..." header line on the client side.
+    bool parseReplyHeader(std::string_view line, bool &ok, std::size_t &rowCount);
+}
@@ -0,0 +1,484 @@
+#include "DeskServer.h"
+#include "../Utility/date.h"
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    constexpr std::uint64_t listenTag = 0;
+    constexpr std::uint64_t wakeTag = 1;
+    constexpr int maintenanceTickMs = 1000;
+}
+
+/* *************************************************************************
+                 ---------- CONSTRUCTORS & DESTRUCTORS ----------
+   *************************************************************************  */
+
+// Every client has at most one job queued, so with maxClients as the capacity
+// the event loop's push() can never block.
+DeskServer::DeskServer(const DeskServerOptions &serverOptions)
+    : options(serverOptions), database(serverOptions.dbFile, serverOptions.profile),
+      pool(serverOptions.dbFile, serverOptions.profile, serverOptions.workers),
+      jobs(serverOptions.maxClients > 0 ? serverOptions.maxClients : 1)
+{
+    if (options.systemDate.empty())
+        options.systemDate = getCurrentDate();
+    if (options.workers == 0)
+        options.workers = 1;
+    if (options.maxClients == 0)
+        options.maxClients = 1;
+}
+
+DeskServer::~DeskServer()
+{
+    shutdown();
+}
+
+#ifdef __linux__
+
+/* *************************************************************************
+                          ---------- START-UP ----------
+   *************************************************************************  */
+
+bool DeskServer::start()
+{
+    if (!database.open() || !database.createTables() || !database.runMigrations())
+    {
+        std::cerr << "Desk server: could not prepare database " << options.dbFile << std::endl;
+        return false;
+    }
+
+    // Readers are opened read-only, so the pool waits for the migrated schema.
+    if (!pool.open() || pool.getReaderCount() < options.workers)
+    {
+        std::cerr << "Desk server: could not open the worker connections." << std::endl;
+        return false;
+    }
+
+    if (!openWorkers())
+        return false;
+
+    // One fine pass per process start, as the console does at boot.
+    FineUpdateSummary fines = workers.front()->handler->updateDailyFines();
+    if (!fines.success)
+        std::cerr << "Desk server: daily fine update failed and was rolled back." << std::endl;
+    else
+        std::cout << "[Desk] Fines for " << options.systemDate << ": " << fines.overdueTransactions << " of "
+                  << fines.transactionsScanned << " issues past due charged in " << fines.elapsedMs << " ms.\n";
+
+    if (!openSocket())
+        return false;
+
+    for (auto &worker : workers)
+    {
+        Worker *owned = worker.get();
+        worker->thread = std::thread([this, owned]
+                                     { workerLoop(*owned); });
+    }
+
+    std::cout << "[Desk] Listening on " << options.socketPath << " with " << workers.size() << " workers.\n";
+    return true;
+}
+
+bool DeskServer::openWorkers()
+{
+    for (std::size_t i = 0; i < options.workers; i++)
+    {
+        auto worker = std::make_unique<Worker>();
+        worker->handler = std::make_unique<DeskHandler>(pool, options.systemDate);
+        if (!worker->handler->isReady())
+        {
+            std::cerr << "Desk server: no pooled connection left for worker " << i + 1 << "." << std::endl;
+            return false;
+        }
+        workers.push_back(std::move(worker));
+    }
+    return true;
+}
+
+bool DeskServer::openSocket()
+{
+    sockaddr_un address{};
+    if (options.socketPath.size() >= sizeof(address.sun_path))
+    {
+        std::cerr << "Desk server: socket path is too long." << std::endl;
+        return false;
+    }
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, options.socketPath.c_str(), options.socketPath.size() + 1);
+
+    listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listenFd < 0)
+    {
+        std::cerr << "Desk server: socket() failed: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    // A socket file left behind by a previous run would make bind() fail.
+    // bind() creates the file under the umask; it is narrowed to the owner
+    // and group before listen(), so no other user can connect in between.
+    unlink(options.socketPath.c_str());
+    if (bind(listenFd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 ||
+        chmod(options.socketPath.c_str(), 0660) != 0 ||
+        listen(listenFd, SOMAXCONN) != 0)
+    {
+        std::cerr << "Desk server: cannot listen on " << options.socketPath << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epollFd < 0 || wakeFd < 0)
+    {
+        std::cerr << "Desk server: epoll/eventfd set-up failed: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.u64 = listenTag;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event);
+    event.data.u64 = wakeTag;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event);
+    return true;
+}
+
+/* *************************************************************************
+                           ---------- WORKERS ----------
+   *************************************************************************  */
+
+void DeskServer::workerLoop(Worker &worker)
+{
+    while (std::optional<Job> job = jobs.pop())
+    {
+        DeskReply reply = worker.handler->handle(job->line, job->session);
+
+        {
+            std::lock_guard<std::mutex> lock(completionsMutex);
+            completions.push_back(Completion{job->clientId, DeskProtocol::formatReply(reply), job->session});
+        }
+
+        std::uint64_t one = 1;
+        ssize_t written = write(wakeFd, &one, sizeof(one));
+        (void)written; // the counter only overflows after 2^64 wake-ups
+    }
+}
+
+/* *************************************************************************
+                         ---------- EVENT LOOP ----------
+   *************************************************************************  */
+
+void DeskServer::run()
+{
+    epoll_event events[64];
+
+    while (!stopping.load())
+    {
+        int ready = epoll_wait(epollFd, events, 64, maintenanceTickMs);
+        if (ready < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            std::cerr << "Desk server: epoll_wait failed: " << std::strerror(errno) << std::endl;
+            break;
+        }
+
+        for (int i = 0; i < ready; i++)
+        {
+            std::uint64_t tag = events[i].data.u64;
+            if (tag == listenTag)
+            {
+                acceptClients();
+                continue;
+            }
+            if (tag == wakeTag)
+            {
+                std::uint64_t count;
+                while (read(wakeFd, &count, sizeof(count)) > 0)
+                {
+                }
+                drainCompletions();
+                continue;
+            }
+
+            auto found = clients.find(tag);
+            if (found == clients.end())
+                continue; // closed earlier in this batch
+
+            if (events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR))
+                readClient(tag, found->second);
+
+            found = clients.find(tag);
+            if (found != clients.end() && (events[i].events & EPOLLOUT))
+                flushClient(tag, found->second);
+        }
+
+        database.runMaintenanceIfDue();
+    }
+}
+
+void DeskServer::stop()
+{
+    stopping.store(true);
+    if (wakeFd >= 0)
+    {
+        std::uint64_t one = 1;
+        ssize_t written = write(wakeFd, &one, sizeof(one));
+        (void)written;
+    }
+}
+
+void DeskServer::acceptClients()
+{
+    while (true)
+    {
+        int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0)
+            return; // EAGAIN once the backlog is empty
+
+        if (clients.size() >= options.maxClients)
+        {
+            static const char busyReply[] = "ERR Server is at its desk limit.\n";
+            send(fd, busyReply, sizeof(busyReply) - 1, MSG_NOSIGNAL);
+            close(fd);
+            continue;
+        }
+
+        std::uint64_t id = nextClientId++;
+        Client &client = clients[id];
+        client.fd = fd;
+
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.u64 = id;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+    }
+}
+
+void DeskServer::readClient(std::uint64_t id, Client &client)
+{
+    char buffer[4096];
+    while (true)
+    {
+        ssize_t count = recv(client.fd, buffer, sizeof(buffer), 0);
+        if (count > 0)
+        {
+            client.inbox.append(buffer, static_cast<std::size_t>(count));
+            if (client.inbox.size() > DeskProtocol::maxPendingBytes)
+            {
+                closeClient(id);
+                return;
+            }
+            continue;
+        }
+        if (count == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR))
+            client.peerClosed = true;
+        if (count < 0 && errno == EINTR)
+            continue;
+        break;
+    }
+
+    // The unfinished line at the end; complete ones are checked as they are dispatched.
+    std::size_t lastNewline = client.inbox.rfind('\n');
+    std::size_t partial = lastNewline == std::string::npos ? client.inbox.size() : client.inbox.size() - lastNewline - 1;
+    if (partial > DeskProtocol::maxLineBytes)
+    {
+        closeClient(id);
+        return;
+    }
+
+    // Nothing more will arrive after EOF; stop polling for input but let the
+    // queued requests finish.
+    if (client.peerClosed)
+        updatePolling(id, client);
+
+    dispatchNext(id, client);
+}
+
+// Hands the client's next complete line to the workers, unless one of its
+// requests is already running.
+void DeskServer::dispatchNext(std::uint64_t id, Client &client)
+{
+    if (client.busy)
+        return;
+
+    std::size_t newline = client.inbox.find('\n');
+    if (newline == std::string::npos || client.closeAfterSend)
+    {
+        if (client.peerClosed && client.outboxSent == client.outbox.size())
+            closeClient(id);
+        return;
+    }
+
+    if (newline > DeskProtocol::maxLineBytes)
+    {
+        closeClient(id);
+        return;
+    }
+
+    Job job{id, client.inbox.substr(0, newline), client.session};
+    client.inbox.erase(0, newline + 1);
+    client.busy = true;
+    jobs.push(std::move(job));
+}
+
+void DeskServer::drainCompletions()
+{
+    std::vector<Completion> finished;
+    {
+        std::lock_guard<std::mutex> lock(completionsMutex);
+        finished.swap(completions);
+    }
+
+    for (Completion &completion : finished)
+    {
+        requestsServed++;
+        auto found = clients.find(completion.clientId);
+        if (found == clients.end())
+            continue; // desk went away while its request ran
+
+        Client &client = found->second;
+        client.busy = false;
+        client.session = completion.session;
+        client.closeAfterSend = client.session.isExit;
+        client.outbox += completion.reply;
+        flushClient(completion.clientId, client);
+
+        found = clients.find(completion.clientId);
+        if (found != clients.end())
+            dispatchNext(completion.clientId, found->second);
+    }
+}
+
+void DeskServer::flushClient(std::uint64_t id, Client &client)
+{
+    while (client.outboxSent < client.outbox.size())
+    {
+        ssize_t sent = send(client.fd, client.outbox.data() + client.outboxSent,
+                            client.outbox.size() - client.outboxSent, MSG_NOSIGNAL);
+        if (sent > 0)
+        {
+            client.outboxSent += static_cast<std::size_t>(sent);
+            continue;
+        }
+        if (sent < 0 && errno == EINTR)
+            continue;
+        if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            watchWrites(id, client, true);
+            return;
+        }
+        closeClient(id);
+        return;
+    }
+
+    client.outbox.clear();
+    client.outboxSent = 0;
+    watchWrites(id, client, false);
+
+    if (client.closeAfterSend || (client.peerClosed && !client.busy && client.inbox.find('\n') == std::string::npos))
+        closeClient(id);
+}
+
+void DeskServer::watchWrites(std::uint64_t id, Client &client, bool enable)
+{
+    if (client.wantsWrite == enable)
+        return;
+    client.wantsWrite = enable;
+    updatePolling(id, client);
+}
+
+// A half-closed socket reports EPOLLHUP on every wait, so once the desk has
+// hung up it is only registered while a reply is waiting to be written.
+void DeskServer::updatePolling(std::uint64_t id, Client &client)
+{
+    std::uint32_t wanted = (client.peerClosed ? 0u : static_cast<std::uint32_t>(EPOLLIN | EPOLLRDHUP)) |
+                           (client.wantsWrite ? static_cast<std::uint32_t>(EPOLLOUT) : 0u);
+
+    epoll_event event{};
+    event.events = wanted;
+    event.data.u64 = id;
+    if (wanted == 0)
+    {
+        if (client.polled)
+            epoll_ctl(epollFd, EPOLL_CTL_DEL, client.fd, nullptr);
+        client.polled = false;
+        return;
+    }
+    epoll_ctl(epollFd, client.polled ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, client.fd, &event);
+    client.polled = true;
+}
+
+void DeskServer::closeClient(std::uint64_t id)
+{
+    auto found = clients.find(id);
+    if (found == clients.end())
+        return;
+    close(found->second.fd); // also drops it from the epoll set
+    clients.erase(found);
+}
+
+/* *************************************************************************
+                          ---------- SHUTDOWN ----------
+   *************************************************************************  */
+
+void DeskServer::shutdown()
+{
+    jobs.close();
+    for (auto &worker : workers)
+    {
+        if (worker->thread.joinable())
+            worker->thread.join();
+    }
+    // Handlers hold reader leases and statements on the pool's connections,
+    // so they go first.
+    for (auto &worker : workers)
+        worker->handler.reset();
+    workers.clear();
+    pool.close();
+
+    while (!clients.empty())
+        closeClient(clients.begin()->first);
+
+    if (listenFd >= 0)
+    {
+        close(listenFd);
+        unlink(options.socketPath.c_str());
+        listenFd = -1;
+    }
+    if (epollFd >= 0)
+    {
+        close(epollFd);
+        epollFd = -1;
+    }
+    if (wakeFd >= 0)
+    {
+        close(wakeFd);
+        wakeFd = -1;
+    }
+}
+
+#else
+
+bool DeskServer::start()
+{
+    std::cerr << "Desk server: this platform has no epoll; the desk server runs on Linux only." << std::endl;
+    return false;
+}
+
+void DeskServer::run() {}
+void DeskServer::stop() { stopping.store(true); }
+void DeskServer::shutdown() { jobs.close(); }
+
+#endif
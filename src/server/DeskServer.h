@@ -0,0 +1,129 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "DeskHandler.h"
+#include "../Utility/BoundedQueue.h"
+#include "../infrastructure/database/DatabaseInitializer.h"
+#include "../infrastructure/database/ConnectionPool.h"
+#include "../infrastructure/database/ConnectionProfile.h"
+
+struct DeskServerOptions
+{
+    std::string socketPath = "/tmp/library-desk.sock";
+    std::string dbFile = "../src/db/library.db";
+    std::string systemDate; // empty: today's date
+    std::size_t workers = 4;
+    std::size_t maxClients = 256;
+    ConnectionProfile profile;
+};
+
+// Long-running front-end that lets many desk consoles share one warm process.
+//
+// One thread runs an epoll loop over a Unix-domain socket: it accepts desks,
+// reads request lines and writes replies without ever blocking. Each request
+// is handed to a pool of workers, and every worker owns a DeskHandler that
+// reads on its own pooled reader and writes through the pool's writer. Finished replies come back through a completion list
+// and an eventfd that wakes the loop. A desk has at most one request in
+// flight, so its replies always arrive in the order it asked.
+//
+// Linux only (epoll / eventfd); start() fails elsewhere.
+class DeskServer
+{
+private:
+    struct Client
+    {
+        int fd = -1;
+        std::string inbox;
+        std::string outbox;
+        std::size_t outboxSent = 0;
+        ActiveSession session;
+        bool busy = false;        // a worker holds this client's request
+        bool peerClosed = false;  // read side hit EOF
+        bool closeAfterSend = false;
+        bool wantsWrite = false;  // a reply is waiting for EPOLLOUT
+        bool polled = true;       // registered with epoll
+    };
+
+    struct Job
+    {
+        std::uint64_t clientId;
+        std::string line;
+        ActiveSession session;
+    };
+
+    struct Completion
+    {
+        std::uint64_t clientId;
+        std::string reply;
+        ActiveSession session;
+    };
+
+    struct Worker
+    {
+        std::unique_ptr<DeskHandler> handler;
+        std::thread thread;
+    };
+
+    DeskServerOptions options;
+
+    // The loop's own connection: schema set-up and periodic maintenance.
+    DatabaseInitializer database;
+    // One reader per worker plus the shared writer.
+    ConnectionPool pool;
+
+    int listenFd = -1;
+    int epollFd = -1;
+    int wakeFd = -1;
+    std::atomic<bool> stopping{false};
+
+    std::unordered_map<std::uint64_t, Client> clients;
+    std::uint64_t nextClientId = 2; // 0 and 1 tag the listening socket and the eventfd
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    BoundedQueue<Job> jobs;
+
+    std::mutex completionsMutex;
+    std::vector<Completion> completions;
+
+    std::size_t requestsServed = 0;
+
+    bool openSocket();
+    bool openWorkers();
+    void workerLoop(Worker &worker);
+
+    void acceptClients();
+    void readClient(std::uint64_t id, Client &client);
+    void dispatchNext(std::uint64_t id, Client &client);
+    void flushClient(std::uint64_t id, Client &client);
+    void watchWrites(std::uint64_t id, Client &client, bool enable);
+    void updatePolling(std::uint64_t id, Client &client);
+    void closeClient(std::uint64_t id);
+    void drainCompletions();
+    void shutdown();
+
+public:
+    explicit DeskServer(const DeskServerOptions &serverOptions);
+    ~DeskServer();
+
+    DeskServer(const DeskServer &) = delete;
+    DeskServer &operator=(const DeskServer &) = delete;
+
+    // Migrates the schema, runs the daily fine update, binds the socket and
+    // starts the workers.
+    bool start();
+    // Serves desks until stop() is called.
+    void run();
+    // Safe to call from a signal handler.
+    void stop();
+
+    std::size_t getClientCount() const { return clients.size(); }
+    std::size_t getRequestsServed() const { return requestsServed; }
+};
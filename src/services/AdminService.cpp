@@ -1,7 +1,12 @@
 #include "AdminService.h"
 #include "../PDFGenerator/PdfGenerator.h"
 #include "../Utility/date.h"
-#include <sstream>
+#include "../Utility/CivilDate.h"
+#include "../Utility/AllocationProfiler.h"
+#include "../Utility/PartitionRunner.h"
+#include <chrono>
+#include <algorithm>
+#include <thread>
 
 #include "../infrastructure/repositories/UserRepository.h"
 #include "../infrastructure/repositories/FineRepository.h"
@@ -13,6 +18,7 @@
 #include "../infrastructure/repositories/MembershipTypeRepository.h"
 #include "../infrastructure/repositories/BorrowingHistoryRepository.h"
 #include "../infrastructure/repositories/AdministratorRepository.h"
+#include "../infrastructure/database/ConnectionPool.h"
 
 /* *************************************************************************
                  ---------- CONSTRUCTORS & DESTRUCTORS ----------
@@ -21,10 +27,12 @@
 AdminService::AdminService(UserRepository &userRepo, FineRepository &fineRepo, ResourceRepository &resourceRepo,
                            CategoryRepository &categoryRepo, FundRequestRepository &fundRequestRepo, TransactionRepository &transactionRepo,
                            ReservationRepository &reservationRepo, MembershipTypeRepository &membershipTypeRepo,
-                           BorrowingHistoryRepository &borrowingHistoryRepo, AdministratorRepository &administratorRepo)
+                           BorrowingHistoryRepository &borrowingHistoryRepo, AdministratorRepository &administratorRepo,
+                           TableExporter &exporter, ConnectionPool *pool)
     : userRepository(userRepo), fineRepository(fineRepo), resourceRepository(resourceRepo), categoryRepository(categoryRepo),
       fundRequestRepository(fundRequestRepo), transactionRepository(transactionRepo), reservationRepository(reservationRepo),
-      membershipTypeRepository(membershipTypeRepo), borrowingHistoryRepository(borrowingHistoryRepo), administratorRepository(administratorRepo) {}
+      membershipTypeRepository(membershipTypeRepo), borrowingHistoryRepository(borrowingHistoryRepo), administratorRepository(administratorRepo),
+      tableExporter(exporter), connectionPool(pool) {}
 
 /* *************************************************************************
                  ---------- RESOURCE MANAGEMENT ----------
@@ -52,9 +60,33 @@ std::unique_ptr<Resource> AdminService::getResourceById(int resourceId)
 
 std::vector<Resource> AdminService::viewAllResources()
 {
+  PROFILE_ALLOCATIONS("AdminService::viewAllResources");
   return resourceRepository.getAll();
 }
 
+bool AdminService::forEachResource(const std::function<void(const Resource &)> &visit)
+{
+  return resourceRepository.forEachResource(visit);
+}
+
+std::vector<Resource> AdminService::viewResourcesAfter(int afterId, int limit)
+{
+  return resourceRepository.getPageAfter(afterId, limit);
+}
+
+std::vector<Resource> AdminService::viewResourcesBefore(int beforeId, int limit)
+{
+  return resourceRepository.getPageBefore(beforeId, limit);
+}
+
+ImportSummary AdminService::importResources(const std::string &path, const ImportOptions &options,
+                                            const ImportProgress &progress)
+{
+  PROFILE_ALLOCATIONS("AdminService::importResources");
+  CatalogueImporter importer(resourceRepository);
+  return importer.importFile(path, options, progress);
+}
+
 std::vector<Category> AdminService::viewAllCategories()
 {
   return categoryRepository.getAll();
@@ -122,9 +154,25 @@ bool AdminService::reactivateUserAccount(int userId)
 
 std::vector<User> AdminService::viewAllUsers()
 {
+  PROFILE_ALLOCATIONS("AdminService::viewAllUsers");
   return userRepository.getAllUsers();
 }
 
+bool AdminService::forEachUser(const std::function<void(const User &)> &visit)
+{
+  return userRepository.forEachUser(visit);
+}
+
+std::vector<User> AdminService::viewUsersAfter(int afterId, int limit)
+{
+  return userRepository.getPageAfter(afterId, limit);
+}
+
+std::vector<User> AdminService::viewUsersBefore(int beforeId, int limit)
+{
+  return userRepository.getPageBefore(beforeId, limit);
+}
+
 std::vector<User> AdminService::viewDeletionRequests()
 {
   return userRepository.getPendingDeletionRequests();
@@ -176,9 +224,25 @@ bool AdminService::deleteFine(int fineId)
 
 std::vector<Fine> AdminService::viewAllFines()
 {
+  PROFILE_ALLOCATIONS("AdminService::viewAllFines");
   return fineRepository.getAllFines();
 }
 
+bool AdminService::forEachFine(const std::function<void(const Fine &)> &visit)
+{
+  return fineRepository.forEachFine(visit);
+}
+
+std::vector<Fine> AdminService::viewFinesAfter(int afterId, int limit)
+{
+  return fineRepository.getPageAfter(afterId, limit);
+}
+
+std::vector<Fine> AdminService::viewFinesBefore(int beforeId, int limit)
+{
+  return fineRepository.getPageBefore(beforeId, limit);
+}
+
 std::vector<Fine> AdminService::viewFinesByUser(int userId)
 {
   return fineRepository.getByUserId(userId);
@@ -239,171 +303,372 @@ bool AdminService::waiveFine(int fineId)
   return true;
 }
 
-void AdminService::updateDailyFines(const std::string &dateToday)
+FineUpdateSummary AdminService::updateDailyFines(const std::string &dateToday)
 {
-  std::vector<Transaction> activeTransactions = transactionRepository.getActiveIssues();
+  PROFILE_ALLOCATIONS("AdminService::updateDailyFines");
+  FineUpdateSummary summary;
+  auto started = std::chrono::steady_clock::now();
 
-  for (Transaction &txn : activeTransactions)
+  CivilDate today;
+  if (!CivilDate::parse(dateToday, today))
   {
-    if (dateToday > txn.getDueDate())
-    {
-      txn.setIsOverdue(true);
-
-      int daysLate = calculateDaysOverdue(txn.getDueDate(), dateToday);
+    summary.elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+    return summary;
+  }
 
-      if (daysLate > 0)
-      {
-        double currentFineAmount = daysLate * 5.0;
+  // Pass 1: work out every overdue charge in memory, no per-row queries.
+  // The due_day index hands back only loans already past due, and the rows
+  // view one arena, so the scan costs a handful of block allocations.
+  StringArena arena;
+  std::vector<TransactionRow> overdueTransactions = transactionRepository.getOverdueIssueRows(arena, today);
+  summary.transactionsScanned = static_cast<int>(overdueTransactions.size());
 
-        bool fineExists = false;
-        std::vector<Fine> userFines = fineRepository.getByUserId(txn.getUserId());
+  std::vector<OverdueCharge> charges;
+  charges.reserve(overdueTransactions.size());
 
-        for (Fine &existingFine : userFines)
-        {
-          if (existingFine.getTransactionId() == txn.getTransactionId())
-          {
-            existingFine.setDaysOverdue(daysLate);
-            existingFine.setFineAmount(currentFineAmount);
-            existingFine.setFineDate(dateToday);
-            fineRepository.save(existingFine);
-            fineExists = true;
-            break;
-          }
-        }
+  for (const TransactionRow &txn : overdueTransactions)
+  {
+    // SQLite rolls impossible dates (2023-2-29) forward; CivilDate rejects them.
+    CivilDate due;
+    if (CivilDate::parse(txn.dueDate, due) && due < today)
+    {
+      int daysLate = today - due;
+      charges.push_back({txn.transactionId, txn.userId, daysLate, daysLate * 5.0});
+    }
+  }
+  summary.overdueTransactions = static_cast<int>(charges.size());
 
-        if (!fineExists)
-        {
-          Fine newFine;
-          newFine.setTransactionId(txn.getTransactionId());
-          newFine.setUserId(txn.getUserId());
-          newFine.setDaysOverdue(daysLate);
-          newFine.setFineAmount(currentFineAmount);
-          newFine.setFineDate(dateToday);
-          newFine.setIsPaid(false);
-
-          fineRepository.save(newFine);
-        }
+  // Pass 2: write the whole batch inside one SQLite transaction.
+  if (!charges.empty())
+  {
+    transactionRepository.beginTransaction();
 
-        txn.setFineAmount(currentFineAmount);
-        transactionRepository.updateTransaction(txn);
-      }
+    if (fineRepository.upsertOverdueFines(charges, dateToday, summary.finesUpdated, summary.finesCreated) &&
+        transactionRepository.applyOverdueCharges(charges, summary.transactionsUpdated))
+    {
+      transactionRepository.commitTransaction();
+    }
+    else
+    {
+      transactionRepository.rollbackTransaction();
+      summary.success = false;
+      summary.finesUpdated = 0;
+      summary.finesCreated = 0;
+      summary.transactionsUpdated = 0;
     }
   }
+
+  summary.elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+  return summary;
 }
 
 /* *************************************************************************
                  ---------- REPORTING ----------
    ************************************************************************* */
 
-bool AdminService::generateUserHistoryReport(const std::string &filename)
+namespace
 {
-  std::stringstream reportContent;
+  // progress, when given, counts customers written out of the users table.
+  bool writeUserHistoryReport(BorrowingHistoryRepository &borrowingHistoryRepository, UserRepository &userRepository,
+                              const std::string &filename, ReportProgress *progress)
+  {
+    bool queryOk = true;
+    if (progress)
+      progress->total = userRepository.countUsers();
 
-  reportContent << endl;
-  reportContent << "Complete Customer Borrowing History\n";
-  reportContent << "===================================\n";
+    // One JOIN ordered by user; each row is written to the report as it arrives.
+    auto writeReport = [&](std::ostream &out)
+    {
+      out << endl;
+      out << "Complete Customer Borrowing History\n";
+      out << "===================================\n";
 
-  std::vector<User> allUsers = userRepository.getAllUsers();
+      int currentUserId = -1;
 
-  if (allUsers.empty())
+      queryOk = borrowingHistoryRepository.forEachUserHistory([&](const UserHistoryRow &row)
+      {
+        if (row.userId != currentUserId)
+        {
+          currentUserId = row.userId;
+          if (progress)
+            progress->done.fetch_add(1, std::memory_order_relaxed);
+
+          out << "-------------------------------------------------\n";
+          out << "Customer ID: " << row.userId << "\n";
+          out << "Name: " << row.firstName << " " << row.lastName << "\n";
+          out << "Email: " << row.email << "\n";
+          out << "-------------------------------------------------\n";
+        }
+
+        if (!row.hasHistory)
+        {
+          out << "[No Borrowing History Found]\n\n";
+          return;
+        }
+
+        out << "   * Borrowed: '" << (row.hasResource ? row.resourceTitle : std::string_view("Unknown Resource"))
+            << "' (Resource ID: " << row.resourceId << ")\n"
+            << "     Issue Date: " << (row.issueDate.empty() ? std::string_view("Pending") : row.issueDate) << "\n"
+            << "     Due Date:   " << (row.dueDate.empty() ? std::string_view("Pending") : row.dueDate) << "\n"
+            << "     Returned:   " << (row.returnDate.empty() ? std::string_view("Not Returned Yet") : row.returnDate) << "\n"
+            << "     Fine Paid:  $" << row.fineAmount << "\n\n";
+      });
+
+      if (currentUserId == -1)
+      {
+        out << "No customers found in the system.\n";
+      }
+    };
+
+    bool written = makePdf(filename, "Customer Borrowing History Report", writeReport);
+
+    return queryOk && written;
+  }
+
+  // Point lookups for one report worker, on that worker's own connection.
+  struct IssuedReportLookups
   {
-    reportContent << "No customers found in the system.\n";
+    ResourceRepository &resources;
+    UserRepository &users;
+  };
+
+  // One partition's share of the report, rendered without touching any other.
+  struct IssuedReportPart
+  {
+    std::string overdue;
+    std::string issued;
+    int overdueCount = 0;
+    int issuedCount = 0;
+  };
+
+  constexpr std::size_t partitionsPerWorker = 8; // spare partitions give idle workers something to steal
+  constexpr std::size_t minRowsPerPartition = 256;
+
+  void renderIssuedPart(const Transaction *first, const Transaction *last, IssuedReportLookups &lookups,
+                        IssuedReportPart &part)
+  {
+    for (const Transaction *txn = first; txn != last; ++txn)
+    {
+      std::unique_ptr<Resource> resource = lookups.resources.getById(txn->getResourceId());
+      std::unique_ptr<User> user = lookups.users.getById(txn->getUserId());
+
+      std::string &section = txn->getIsOverdue() ? part.overdue : part.issued;
+      (txn->getIsOverdue() ? part.overdueCount : part.issuedCount)++;
+
+      section += "   * '";
+      section += resource ? resource->getTitle() : "Unknown Resource";
+      section += "' (Resource ID: " + std::to_string(txn->getResourceId()) + ")\n";
+      section += "     Borrowed by: ";
+      if (user)
+        section += user->getFirstName() + " " + user->getLastName();
+      else
+        section += "Unknown User";
+      section += " (User ID: " + std::to_string(txn->getUserId()) + ")\n";
+      section += "     Issue Date: ";
+      section += txn->getIssueDate().empty() ? "Pending" : txn->getIssueDate();
+      section += "\n     Due Date:   ";
+      section += txn->getDueDate().empty() ? "Pending" : txn->getDueDate();
+      section += "\n\n";
+    }
   }
 
-  for (const User &user : allUsers)
+  // The active issues are cut into contiguous slices, one per partition, and
+  // the workers (one per entry in lookups) render them in parallel. Each
+  // section is then the slices' buffers concatenated in order, so the report
+  // is the same whatever the number of workers.
+  // progress, when given, counts active issues written.
+  bool writeIssuedAndOverdueReport(const std::vector<Transaction> &activeTransactions,
+                                   std::vector<IssuedReportLookups> &lookups, const std::string &filename,
+                                   ReportProgress *progress)
   {
+    if (progress)
+      progress->total = static_cast<long long>(activeTransactions.size());
 
-    reportContent << "-------------------------------------------------\n";
-    reportContent << "Customer ID: " << user.getUserId() << "\n";
-    reportContent << "Name: " << user.getFirstName() << " " << user.getLastName() << "\n";
-    reportContent << "Email: " << user.getEmail() << "\n";
-    reportContent << "-------------------------------------------------\n";
+    if (activeTransactions.empty())
+    {
+      return makePdf(filename, "Issued and Overdue Resources Report", [](std::ostream &out)
+                     { out << endl
+                           << "Issued and Overdue Resources Report\n"
+                           << "===================================\n"
+                           << "No active issued resources found.\n"; });
+    }
 
-    std::vector<BorrowingHistory> history = borrowingHistoryRepository.getByUserId(user.getUserId());
+    std::size_t rows = activeTransactions.size();
+    std::size_t partitions = std::min(lookups.size() * partitionsPerWorker,
+                                      (rows + minRowsPerPartition - 1) / minRowsPerPartition);
+    std::vector<IssuedReportPart> parts(partitions);
+
+    AllocationScope *reportScope = AllocationScope::current();
+    runPartitions(partitions, lookups.size(), [&](std::size_t partition, std::size_t worker)
+                  {
+                    PROFILE_WORKER_ALLOCATIONS(reportScope);
+                    std::size_t first = rows * partition / partitions;
+                    std::size_t last = rows * (partition + 1) / partitions;
+                    renderIssuedPart(activeTransactions.data() + first, activeTransactions.data() + last,
+                                     lookups[worker], parts[partition]);
+                    if (progress)
+                      progress->done.fetch_add(static_cast<long long>(last - first), std::memory_order_relaxed); });
+
+    int overdueCount = 0;
+    int issuedCount = 0;
+    for (const IssuedReportPart &part : parts)
+    {
+      overdueCount += part.overdueCount;
+      issuedCount += part.issuedCount;
+    }
 
-    if (history.empty())
+    auto writeReport = [&](std::ostream &out)
     {
+      out << endl;
+      out << "Issued and Overdue Resources Report\n";
+      out << "===================================\n";
+
+      out << "--- OVERDUE RESOURCES (" << overdueCount << ") ---\n";
+      if (overdueCount == 0)
+        out << "   [None]\n";
+      for (const IssuedReportPart &part : parts)
+        out << part.overdue;
+      out << "\n";
+
+      out << "--- CURRENTLY ISSUED IN GOOD STANDING (" << issuedCount << ") ---\n";
+      if (issuedCount == 0)
+        out << "   [None]\n";
+      for (const IssuedReportPart &part : parts)
+        out << part.issued;
+      out << "\n";
+    };
+
+    return makePdf(filename, "Issued and Overdue Report", writeReport);
+  }
+}
 
-      reportContent << "[No Borrowing History Found]\n\n";
-      continue;
+// With a connection pool the reports read through their own pooled
+// connection, so they are safe to run on a worker thread beside circulation.
+bool AdminService::buildUserHistoryReport(const std::string &filename, ReportProgress *progress)
+{
+  PROFILE_ALLOCATIONS("AdminService::generateUserHistoryReport");
+  if (connectionPool)
+  {
+    ConnectionPool::ReadLease lease = connectionPool->acquireReader();
+    if (lease)
+    {
+      BorrowingHistoryRepository history(lease.connection(), lease.statements());
+      UserRepository users(lease.connection(), lease.statements());
+      return writeUserHistoryReport(history, users, filename, progress);
     }
+  }
+  return writeUserHistoryReport(borrowingHistoryRepository, userRepository, filename, progress);
+}
 
-    for (const BorrowingHistory &record : history)
+// With a pool, the report takes one reader for the active issue list and up
+// to one more per core for the per-issue lookups, always leaving
+// reservedReaders idle so exports and another report can still start.
+bool AdminService::buildIssuedAndOverdueReport(const std::string &filename, ReportProgress *progress)
+{
+  PROFILE_ALLOCATIONS("AdminService::generateIssuedAndOverdueReport");
+  if (connectionPool)
+  {
+    ConnectionPool::ReadLease lease = connectionPool->acquireReader();
+    if (lease)
     {
-      std::string bookTitle = "Unknown Resource";
+      TransactionRepository transactions(lease.connection(), lease.statements());
+      std::vector<Transaction> activeTransactions = transactions.getActiveIssues();
 
-      std::unique_ptr<Resource> resource = resourceRepository.getById(record.getResourceId());
-      if (resource)
+      std::vector<ConnectionPool::ReadLease> extraLeases;
+      std::size_t wanted = std::max(1u, std::thread::hardware_concurrency());
+      while (extraLeases.size() + 1 < wanted)
       {
-        bookTitle = resource->getTitle();
+        ConnectionPool::ReadLease extra = connectionPool->tryAcquireReader(ConnectionPool::reservedReaders);
+        if (!extra)
+          break;
+        extraLeases.push_back(std::move(extra));
       }
-      reportContent << "   * Borrowed: '" << bookTitle << "' (Resource ID: " << record.getResourceId() << ")\n"
-                    << "     Issue Date: " << (record.getIssueDate().empty() ? "Pending" : record.getIssueDate()) << "\n"
-                    << "     Due Date:   " << (record.getDueDate().empty() ? "Pending" : record.getDueDate()) << "\n"
-                    << "     Returned:   " << (record.getReturnDate().empty() ? "Not Returned Yet" : record.getReturnDate()) << "\n"
-                    << "     Fine Paid:  $" << record.getFineAmount() << "\n\n";
+
+      std::vector<std::unique_ptr<ResourceRepository>> resources;
+      std::vector<std::unique_ptr<UserRepository>> users;
+      resources.push_back(std::make_unique<ResourceRepository>(lease.connection(), lease.statements()));
+      users.push_back(std::make_unique<UserRepository>(lease.connection(), lease.statements()));
+      for (const ConnectionPool::ReadLease &extra : extraLeases)
+      {
+        resources.push_back(std::make_unique<ResourceRepository>(extra.connection(), extra.statements()));
+        users.push_back(std::make_unique<UserRepository>(extra.connection(), extra.statements()));
+      }
+
+      std::vector<IssuedReportLookups> lookups;
+      for (std::size_t i = 0; i < resources.size(); i++)
+        lookups.push_back(IssuedReportLookups{*resources[i], *users[i]});
+
+      return writeIssuedAndOverdueReport(activeTransactions, lookups, filename, progress);
     }
   }
-  std::string finalString = reportContent.str();
 
-  makePdf(filename, "Customer Borrowing History Report", finalString);
+  std::vector<IssuedReportLookups> lookups{IssuedReportLookups{resourceRepository, userRepository}};
+  return writeIssuedAndOverdueReport(transactionRepository.getActiveIssues(), lookups, filename, progress);
+}
 
-  return true;
+bool AdminService::generateUserHistoryReport(const std::string &filename)
+{
+  return buildUserHistoryReport(filename, nullptr);
 }
 
 bool AdminService::generateIssuedAndOverdueReport(const std::string &filename)
 {
-  std::stringstream reportContent;
-
-  reportContent << endl;
-  reportContent << "Issued and Overdue Resources Report\n";
-  reportContent << "===================================\n";
+  return buildIssuedAndOverdueReport(filename, nullptr);
+}
 
-  std::vector<Transaction> activeTransactions = transactionRepository.getActiveIssues();
-  if (activeTransactions.empty())
-  {
-    reportContent << "No active issued resources found.\n";
-    makePdf(filename, "Issued and Overdue Resources Report", reportContent.str());
-    return true;
-  }
+// Background jobs must not touch the console's connection, so without a
+// pool the caller is told to build the report in the foreground instead.
+int AdminService::queueUserHistoryReport(const std::string &filename)
+{
+  if (!connectionPool || connectionPool->getReaderCount() == 0)
+    return -1;
+  return reportJobs.submit("User Borrowing History", filename, [this, filename](ReportProgress &progress)
+                           { return buildUserHistoryReport(filename, &progress); });
+}
 
-  std::stringstream issuedSection;
-  std::stringstream overdueSection;
+int AdminService::queueIssuedAndOverdueReport(const std::string &filename)
+{
+  if (!connectionPool || connectionPool->getReaderCount() == 0)
+    return -1;
+  return reportJobs.submit("Issued/Overdue Resources", filename, [this, filename](ReportProgress &progress)
+                           { return buildIssuedAndOverdueReport(filename, &progress); });
+}
 
-  int overdueCount = 0;
-  int issuedCount = 0;
+std::vector<ReportJobStatus> AdminService::viewReportJobs()
+{
+  return reportJobs.getStatuses();
+}
 
-  for (const Transaction &txn : activeTransactions)
-  {
-    std::unique_ptr<Resource> resource = resourceRepository.getById(txn.getResourceId());
-    std::unique_ptr<User> user = userRepository.getById(txn.getUserId());
+std::size_t AdminService::getActiveReportJobCount()
+{
+  return reportJobs.getActiveCount();
+}
 
-    std::string resourceTitle = resource ? resource->getTitle() : "Unknown Resource";
-    std::string userName = (user) ? (user->getFirstName() + " " + user->getLastName()) : "Unknown User";
+std::size_t AdminService::clearFinishedReportJobs()
+{
+  return reportJobs.clearFinished();
+}
 
-    std::string entry = "   * '" + resourceTitle + "' (Resource ID: " + std::to_string(txn.getResourceId()) + ")\n" + "     Borrowed by: " + userName + " (User ID: " + std::to_string(txn.getUserId()) + ")\n" + "     Issue Date: " + (txn.getIssueDate().empty() ? "Pending" : txn.getIssueDate()) + "\n" + "     Due Date:   " + (txn.getDueDate().empty() ? "Pending" : txn.getDueDate()) + "\n\n";
+std::vector<std::string> AdminService::getExportColumns(const std::string &table)
+{
+  return tableExporter.getColumns(table);
+}
 
-    if (txn.getIsOverdue())
-    {
-      overdueSection << entry;
-      overdueCount++;
-    }
-    else
+ExportSummary AdminService::exportTable(const ExportOptions &options, const std::string &filename)
+{
+  PROFILE_ALLOCATIONS("AdminService::exportTable");
+  if (connectionPool)
+  {
+    // The export runs on the console thread, so it never waits for a reader:
+    // with all of them out to reports it reads on the session's connection.
+    ConnectionPool::ReadLease lease = connectionPool->tryAcquireReader();
+    if (lease)
     {
-      issuedSection << entry;
-      issuedCount++;
+      TableExporter exporter(lease.connection(), lease.statements());
+      return exporter.exportTable(options, filename);
     }
   }
-
-  reportContent << "--- OVERDUE RESOURCES (" << overdueCount << ") ---\n";
-  reportContent << (overdueCount > 0 ? overdueSection.str() : "   [None]\n") << "\n";
-
-  reportContent << "--- CURRENTLY ISSUED IN GOOD STANDING (" << issuedCount << ") ---\n";
-  reportContent << (issuedCount > 0 ? issuedSection.str() : "   [None]\n") << "\n";
-
-  makePdf(filename, "Issued and Overdue Report", reportContent.str());
-
-  return true;
+  return tableExporter.exportTable(options, filename);
 }
 
 /* *************************************************************************
@@ -417,11 +682,17 @@ std::vector<Transaction> AdminService::viewPendingBorrowRequests()
 
 bool AdminService::processBorrowRequest(int transactionId, bool approve, std::string &dateToday)
 {
+  PROFILE_ALLOCATIONS("AdminService::processBorrowRequest");
+  transactionRepository.beginTransaction();
+
+  // Read inside the transaction so a request already approved or rejected by
+  // another desk is refused instead of being issued (and counted) twice.
   std::unique_ptr<Transaction> transaction = transactionRepository.getById(transactionId);
-  if (!transaction)
+  if (!transaction || transaction->getTransactionStatus() != "PENDING")
+  {
+    transactionRepository.rollbackTransaction();
     return false;
-
-  transactionRepository.beginTransaction();
+  }
 
   if (approve)
   {
@@ -475,6 +746,7 @@ bool AdminService::processBorrowRequest(int transactionId, bool approve, std::st
 
 bool AdminService::processReturn(int transactionId, std::string &dateToday)
 {
+  PROFILE_ALLOCATIONS("AdminService::processReturn");
   std::unique_ptr<Transaction> txn = transactionRepository.getById(transactionId);
 
   if (!txn || txn->getTransactionStatus() != "ISSUED")
@@ -536,11 +808,35 @@ std::vector<Transaction> AdminService::viewTransactionsByUser(int userId)
   return transactionRepository.getByUserId(userId);
 }
 
+std::vector<Transaction> AdminService::viewIssuesDueSoon(const std::string &dateToday, int days)
+{
+  CivilDate today;
+  if (!CivilDate::parse(dateToday, today) || days < 0)
+    return {};
+  return transactionRepository.getIssuesDueBetween(today, today.addDays(days));
+}
+
 std::vector<Transaction> AdminService::viewAllTransactions()
 {
+  PROFILE_ALLOCATIONS("AdminService::viewAllTransactions");
   return transactionRepository.getAllTransactions();
 }
 
+bool AdminService::forEachTransaction(const std::function<void(const Transaction &)> &visit)
+{
+  return transactionRepository.forEachTransaction(visit);
+}
+
+std::vector<Transaction> AdminService::viewTransactionsAfter(int afterId, int limit)
+{
+  return transactionRepository.getPageAfter(afterId, limit);
+}
+
+std::vector<Transaction> AdminService::viewTransactionsBefore(int beforeId, int limit)
+{
+  return transactionRepository.getPageBefore(beforeId, limit);
+}
+
 /* *************************************************************************
                  ---------- FUND REQUEST PROCESSING ----------
    ************************************************************************* */
@@ -552,6 +848,7 @@ std::vector<FundRequest> AdminService::viewPendingFundRequests()
 
 bool AdminService::processFundRequest(int fundRequestId, bool approve, std::string &dateToday)
 {
+  PROFILE_ALLOCATIONS("AdminService::processFundRequest");
   std::unique_ptr<FundRequest> request = fundRequestRepository.getById(fundRequestId);
 
   if (!request || request->getStatus() != "PENDING")
@@ -646,14 +943,28 @@ std::unique_ptr<MembershipType> AdminService::getMembershipTypeById(int typeId)
 
 std::vector<Reservation> AdminService::viewAllReservations()
 {
+  PROFILE_ALLOCATIONS("AdminService::viewAllReservations");
   return reservationRepository.getAllReservations();
 }
 
+bool AdminService::forEachReservation(const std::function<void(const Reservation &)> &visit)
+{
+  return reservationRepository.forEachReservation(visit);
+}
+
 std::vector<Reservation> AdminService::viewReservationsByUser(int userId)
 {
   return reservationRepository.getByUserId(userId);
 }
 
+std::vector<Reservation> AdminService::viewExpiredReservations(const std::string &dateToday)
+{
+  CivilDate today;
+  if (!CivilDate::parse(dateToday, today))
+    return {};
+  return reservationRepository.getExpiredBefore(today);
+}
+
 bool AdminService::cancelReservation(int reservationId)
 {
   std::unique_ptr<Reservation> reservation = reservationRepository.getById(reservationId);
@@ -3,6 +3,7 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <functional>
 
 #include "../domain/User.h"
 #include "../domain/Fine.h"
@@ -14,6 +15,21 @@
 #include "../domain/Administrator.h"
 #include "../domain/MembershipType.h"
 #include "../domain/BorrowingHistory.h"
+#include "../import/CatalogueImporter.h"
+#include "../export/TableExporter.h"
+#include "ReportJobQueue.h"
+
+// Outcome of one run of the daily fine engine, reported back to the boot sequence.
+struct FineUpdateSummary
+{
+   bool success = true;
+   int transactionsScanned = 0;
+   int overdueTransactions = 0;
+   int finesUpdated = 0;
+   int finesCreated = 0;
+   int transactionsUpdated = 0;
+   double elapsedMs = 0.0;
+};
 
 class UserRepository;
 class FineRepository;
@@ -25,6 +41,7 @@ class ReservationRepository;
 class MembershipTypeRepository;
 class AdministratorRepository;
 class BorrowingHistoryRepository;
+class ConnectionPool;
 
 class AdminService
 {
@@ -39,6 +56,12 @@ private:
     MembershipTypeRepository &membershipTypeRepository;
     BorrowingHistoryRepository &borrowingHistoryRepository;
     AdministratorRepository &administratorRepository;
+    TableExporter &tableExporter;
+    ConnectionPool *connectionPool; // optional: reports and exports borrow a reader from it
+    ReportJobQueue reportJobs;      // last member: its destructor waits for jobs still using the others
+
+    bool buildUserHistoryReport(const std::string &filename, ReportProgress *progress);
+    bool buildIssuedAndOverdueReport(const std::string &filename, ReportProgress *progress);
 
 public:
     /* **************************************************************************
@@ -47,7 +70,8 @@ public:
    AdminService(UserRepository &userRepo, FineRepository &fineRepo, ResourceRepository &resourceRepo,
                 CategoryRepository &categoryRepo, FundRequestRepository &fundRequestRepo, TransactionRepository &transactionRepo,
                 ReservationRepository &reservationRepo, MembershipTypeRepository &membershipTypeRepo,
-                BorrowingHistoryRepository &borrowingHistoryRepo, AdministratorRepository &administratorRepo);
+                BorrowingHistoryRepository &borrowingHistoryRepo, AdministratorRepository &administratorRepo,
+                TableExporter &exporter, ConnectionPool *pool = nullptr);
 
    /* **************************************************************************
              --------- CATALOG & CATEGORY MANAGEMENT ---------
@@ -57,6 +81,11 @@ public:
    bool editResource(Resource &updatedResource);
    std::unique_ptr<Resource> getResourceById(int resourceId);
    std::vector<Resource> viewAllResources();
+   bool forEachResource(const std::function<void(const Resource &)> &visit);
+   std::vector<Resource> viewResourcesAfter(int afterId, int limit);
+   std::vector<Resource> viewResourcesBefore(int beforeId, int limit);
+   ImportSummary importResources(const std::string &path, const ImportOptions &options,
+                                 const ImportProgress &progress = nullptr);
    
    bool deleteCategory(int categoryId);
    bool addCategory(Category &category);
@@ -79,6 +108,9 @@ public:
    bool suspendUserAccount(int userId);
    bool reactivateUserAccount(int userId);
    std::vector<User> viewAllUsers();
+   bool forEachUser(const std::function<void(const User &)> &visit);
+   std::vector<User> viewUsersAfter(int afterId, int limit);
+   std::vector<User> viewUsersBefore(int beforeId, int limit);
    std::vector<User> viewDeletionRequests();
    std::unique_ptr<User> getUserById(int userId);
 
@@ -86,13 +118,16 @@ public:
              --------- FINE MANAGEMENT ---------
       ************************************************************************** */
    std::vector<Fine> viewAllFines();
+   bool forEachFine(const std::function<void(const Fine &)> &visit);
+   std::vector<Fine> viewFinesAfter(int afterId, int limit);
+   std::vector<Fine> viewFinesBefore(int beforeId, int limit);
    std::vector<Fine> viewFinesByUser(int userId);
    bool imposeFine(Fine &fine);
    bool markFineAsPaid(int fineId);
    bool waiveFine(int fineId);
    bool deleteFine(int fineId);
    bool updateFine(Fine &fine);
-   void updateDailyFines(const std::string &simulatedToday);
+   FineUpdateSummary updateDailyFines(const std::string &simulatedToday);
    std::unique_ptr<Fine> getFineById(int fineId);
 
    /* **************************************************************************
@@ -100,6 +135,17 @@ public:
       ************************************************************************** */
    bool generateUserHistoryReport(const std::string &filename);
    bool generateIssuedAndOverdueReport(const std::string &filename);
+   // Background builds on the report job threads. Return the job id,
+   // ReportJobQueue::fileInUse when an unfinished job already writes that
+   // file, or -1 when there is no connection pool and the report must run in
+   // the foreground.
+   int queueUserHistoryReport(const std::string &filename);
+   int queueIssuedAndOverdueReport(const std::string &filename);
+   std::vector<ReportJobStatus> viewReportJobs();
+   std::size_t getActiveReportJobCount();
+   std::size_t clearFinishedReportJobs();
+   std::vector<std::string> getExportColumns(const std::string &table);
+   ExportSummary exportTable(const ExportOptions &options, const std::string &filename);
 
    /* **************************************************************************
              --------- PROCESS & WORKFLOW ---------
@@ -122,7 +168,10 @@ public:
              --------- Reservation Management ---------
       ************************************************************************** */
    std::vector<Reservation> viewAllReservations();
+   bool forEachReservation(const std::function<void(const Reservation &)> &visit);
    std::vector<Reservation> viewReservationsByUser(int userId);
+   // Holds still PENDING after their expiry date.
+   std::vector<Reservation> viewExpiredReservations(const std::string &dateToday);
    bool cancelReservation(int reservationId);
 
    /* **************************************************************************
@@ -130,6 +179,11 @@ public:
       ************************************************************************** */
    std::vector<Transaction> viewTransactionsByUser(int userId);
    std::vector<Transaction> viewAllTransactions();
+   bool forEachTransaction(const std::function<void(const Transaction &)> &visit);
+   std::vector<Transaction> viewTransactionsAfter(int afterId, int limit);
+   std::vector<Transaction> viewTransactionsBefore(int beforeId, int limit);
+   // Loans still out that fall due between today and today + days.
+   std::vector<Transaction> viewIssuesDueSoon(const std::string &dateToday, int days);
 
    /* **************************************************************************
              --------- Admin Management ---------
@@ -0,0 +1,135 @@
+#include "ReportJobQueue.h"
+#include <algorithm>
+
+/* *************************************************************************
+                 ---------- CONSTRUCTORS & DESTRUCTORS ----------
+   *************************************************************************  */
+
+ReportJobQueue::ReportJobQueue(std::size_t workers) : workerCount(workers > 0 ? workers : 1) {}
+
+ReportJobQueue::~ReportJobQueue()
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        closing = true;
+    }
+    jobReady.notify_all();
+
+    for (std::thread &worker : workers)
+        worker.join();
+}
+
+/* *************************************************************************
+                          ---------- WORKERS ----------
+   *************************************************************************  */
+
+void ReportJobQueue::workerLoop()
+{
+    while (true)
+    {
+        std::shared_ptr<Job> job;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            jobReady.wait(guard, [this]
+                          { return closing || !pending.empty(); });
+            if (pending.empty())
+                return; // closing, and nothing left to build
+
+            job = pending.front();
+            pending.pop_front();
+            job->state = ReportJobState::Running;
+            job->started = std::chrono::steady_clock::now();
+        }
+
+        bool succeeded = job->task(job->progress);
+        double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - job->started).count();
+
+        std::lock_guard<std::mutex> guard(lock);
+        job->state = succeeded ? ReportJobState::Succeeded : ReportJobState::Failed;
+        job->elapsedMs = elapsed;
+        job->task = nullptr; // release whatever the task captured
+    }
+}
+
+/* *************************************************************************
+                        ---------- SUBMISSION ----------
+   *************************************************************************  */
+
+int ReportJobQueue::submit(const std::string &title, const std::string &filename, Task task)
+{
+    auto job = std::make_shared<Job>();
+    job->title = title;
+    job->filename = filename;
+    job->task = std::move(task);
+
+    int jobId;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        // Two builds writing one file would interleave into a corrupt report.
+        for (const std::shared_ptr<Job> &active : jobs)
+        {
+            if (active->filename == filename &&
+                (active->state == ReportJobState::Queued || active->state == ReportJobState::Running))
+                return fileInUse;
+        }
+
+        jobId = nextJobId++;
+        job->jobId = jobId;
+        jobs.push_back(job);
+        pending.push_back(job);
+
+        if (workers.size() < workerCount)
+            workers.emplace_back([this]
+                                 { workerLoop(); });
+    }
+    jobReady.notify_one();
+    return jobId;
+}
+
+/* *************************************************************************
+                          ---------- STATUS ----------
+   *************************************************************************  */
+
+std::vector<ReportJobStatus> ReportJobQueue::getStatuses() const
+{
+    std::vector<ReportJobStatus> statuses;
+    auto now = std::chrono::steady_clock::now();
+
+    std::lock_guard<std::mutex> guard(lock);
+    statuses.reserve(jobs.size());
+    for (const std::shared_ptr<Job> &job : jobs)
+    {
+        ReportJobStatus status;
+        status.jobId = job->jobId;
+        status.title = job->title;
+        status.filename = job->filename;
+        status.state = job->state;
+        status.done = job->progress.done.load(std::memory_order_relaxed);
+        status.total = job->progress.total.load(std::memory_order_relaxed);
+        if (job->state == ReportJobState::Running)
+            status.elapsedMs = std::chrono::duration<double, std::milli>(now - job->started).count();
+        else
+            status.elapsedMs = job->elapsedMs;
+        statuses.push_back(status);
+    }
+    return statuses;
+}
+
+std::size_t ReportJobQueue::getActiveCount() const
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return static_cast<std::size_t>(std::count_if(jobs.begin(), jobs.end(), [](const std::shared_ptr<Job> &job)
+                                                  { return job->state == ReportJobState::Queued ||
+                                                           job->state == ReportJobState::Running; }));
+}
+
+std::size_t ReportJobQueue::clearFinished()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    std::size_t before = jobs.size();
+    jobs.erase(std::remove_if(jobs.begin(), jobs.end(), [](const std::shared_ptr<Job> &job)
+                              { return job->state == ReportJobState::Succeeded ||
+                                       job->state == ReportJobState::Failed; }),
+               jobs.end());
+    return before - jobs.size();
+}
@@ -0,0 +1,96 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Counters a running report updates as it goes. total stays 0 until the
+// report knows how much work there is.
+struct ReportProgress
+{
+    std::atomic<long long> done{0};
+    std::atomic<long long> total{0};
+};
+
+enum class ReportJobState
+{
+    Queued,
+    Running,
+    Succeeded,
+    Failed
+};
+
+// Copy of one job's state for display.
+struct ReportJobStatus
+{
+    int jobId = 0;
+    std::string title;
+    std::string filename;
+    ReportJobState state = ReportJobState::Queued;
+    long long done = 0;
+    long long total = 0;
+    double elapsedMs = 0.0; // time running so far, or in total once finished
+};
+
+// Runs report builds on a few background threads so the admin console stays
+// usable while they write. Jobs start in submission order; the threads are
+// only created by the first submit(). The destructor lets every queued and
+// running job finish, so no report file is left half written.
+class ReportJobQueue
+{
+public:
+    using Task = std::function<bool(ReportProgress &)>;
+
+    static constexpr std::size_t defaultWorkers = 2;
+    // submit() result when a queued or running job already writes that file.
+    static constexpr int fileInUse = 0;
+
+private:
+    struct Job
+    {
+        int jobId = 0;
+        std::string title;
+        std::string filename;
+        Task task;
+        ReportJobState state = ReportJobState::Queued;
+        ReportProgress progress;
+        std::chrono::steady_clock::time_point started;
+        double elapsedMs = 0.0;
+    };
+
+    std::size_t workerCount;
+    std::vector<std::thread> workers;
+
+    mutable std::mutex lock;
+    std::condition_variable jobReady;
+    std::deque<std::shared_ptr<Job>> pending;
+    std::vector<std::shared_ptr<Job>> jobs; // every job not yet cleared, oldest first
+    int nextJobId = 1;
+    bool closing = false;
+
+    void workerLoop();
+
+public:
+    explicit ReportJobQueue(std::size_t workers = defaultWorkers);
+    ~ReportJobQueue();
+
+    ReportJobQueue(const ReportJobQueue &) = delete;
+    ReportJobQueue &operator=(const ReportJobQueue &) = delete;
+
+    // Queues task and returns its job id (ids start at 1), or fileInUse
+    // without queueing anything when an active job has the same filename.
+    int submit(const std::string &title, const std::string &filename, Task task);
+
+    std::vector<ReportJobStatus> getStatuses() const;
+    // Jobs that are queued or running.
+    std::size_t getActiveCount() const;
+    // Forgets finished jobs; returns how many were removed.
+    std::size_t clearFinished();
+};
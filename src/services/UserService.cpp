@@ -1,8 +1,8 @@
 #include "UserService.h"
-#include <cctype>
 #include <string>
 #include <vector>
 #include <memory>
+#include "../Utility/AllocationProfiler.h"
 // Include all repositories
 #include "../infrastructure/repositories/UserRepository.h"
 #include "../infrastructure/repositories/ResourceRepository.h"
@@ -23,39 +23,24 @@ bool UserService::updateProfile(User &user)
 {
     return userRepo.save(user);
 }
-std::string UserService::toLowerCase(const std::string &str)
+std::string UserService::requestAccountDeletion(int userId)
 {
-    std::string lowerStr = str;
-
-    // for every character c
-    for (char &c : lowerStr)
+    CirculationSummary circulation;
+    if (!userRepo.getCirculationSummary(userId, circulation))
     {
-        c = std::tolower(c);
+        return "Some error occurred while requesting account deletion";
     }
 
-    return lowerStr;
-}
-std::string UserService::requestAccountDeletion(int userId)
-{
     // Unpaid Fine Check
-    std::vector<Fine> userFines = fineRepo.getByUserId(userId);
-    for (const auto &fine : userFines)
+    if (circulation.unpaidFineCount > 0)
     {
-        if (!fine.getIsPaid())
-        {
-            return "Cannot request deletion: You have unpaid fines. Please clear your dues first.";
-        }
+        return "Cannot request deletion: You have unpaid fines. Please clear your dues first.";
     }
 
-    // Active borrowal check
-    std::vector<Transaction> userTransactions = transactionRepo.getByUserId(userId);
-    for (const auto &txn : userTransactions)
+    // Active borrowal check (issued items and pending requests)
+    if (circulation.activeBorrows + circulation.pendingRequests > 0)
     {
-        if (!txn.getIsReturned() &&
-            (txn.getTransactionStatus() == "PENDING" || txn.getTransactionStatus() == "ISSUED"))
-        {
-            return "Cannot request deletion: You have active borrowed resources. Please return them first.";
-        }
+        return "Cannot request deletion: You have active borrowed resources. Please return them first.";
     }
 
     // No pending dues or borrowals
@@ -72,46 +57,21 @@ std::string UserService::requestAccountDeletion(int userId)
     return "Some error occurred while requesting account deletion";
 }
 
-std::vector<Resource> UserService::showAllAvailableCatalogue()
+const CatalogueSnapshot &UserService::getCatalogueSnapshot()
 {
-    std::vector<Resource> all = resourceRepo.getAll();
-    std::vector<Resource> available;
-    // Checks if active or not & available copies are greater than zero
-    for (const auto &resource : all)
-    {
-        if (resource.getIsActive() && resource.getAvailableCopies() > 0)
-        {
-            available.push_back(resource);
-        }
-    }
-    return available;
+    PROFILE_ALLOCATIONS("UserService::getCatalogueSnapshot");
+    return resourceRepo.getCatalogueSnapshot();
 }
 
-std::vector<Resource> UserService::searchCatalogue(const std::string &keyword)
+std::vector<Resource> UserService::searchCatalogue(const std::string &keyword, int limit, int offset)
 {
-    std::vector<Resource> allResources = resourceRepo.getAll();
-    std::vector<Resource> matchedResources;
-    std::string searchKey = toLowerCase(keyword);
-
-    for (const auto &res : allResources)
-    {
-        if (!res.getIsActive())
-            continue;
-
-        std::string titleLower = toLowerCase(res.getTitle());
-        std::string authorLower = toLowerCase(res.getAuthor());
-
-        // Check if keyword exists in title or author
-        if (titleLower.find(searchKey) != std::string::npos ||
-            authorLower.find(searchKey) != std::string::npos)
-        {
-            matchedResources.push_back(res);
-        }
-    }
-    return matchedResources;
+    PROFILE_ALLOCATIONS("UserService::searchCatalogue");
+    // Served by the resources_fts index; inactive resources are filtered in the query
+    return resourceRepo.search(keyword, limit, offset);
 }
 std::string UserService::requestToBorrow(int userId, int resourceId)
 {
+    PROFILE_ALLOCATIONS("UserService::requestToBorrow");
     // Simple resource Checks
     std::unique_ptr<Resource> resource = resourceRepo.getById(resourceId);
     if (!resource || !resource->getIsActive() || resource->getAvailableCopies() <= 0)
@@ -119,14 +79,17 @@ std::string UserService::requestToBorrow(int userId, int resourceId)
         return "Resource is currently unavailable.";
     }
 
+    // Fines and open loans come from the user's circulation summary row
+    CirculationSummary circulation;
+    if (!userRepo.getCirculationSummary(userId, circulation))
+    {
+        return "System error: Could not process request.";
+    }
+
     // User has any unpaid fines
-    std::vector<Fine> userFines = fineRepo.getByUserId(userId);
-    for (const auto &fine : userFines)
+    if (circulation.unpaidFineCount > 0)
     {
-        if (!fine.getIsPaid())
-        {
-            return "Cannot borrow: You have unpaid overdue fines.";
-        }
+        return "Cannot borrow: You have unpaid overdue fines.";
     }
 
     // If limit reached of max borrowals
@@ -138,17 +101,8 @@ std::string UserService::requestToBorrow(int userId, int resourceId)
     std::unique_ptr<MembershipType> membership = membershipRepo.getById(user->getMembershipTypeId());
     int maxLimit = (membership != nullptr) ? membership->getMaxBorrowingLimit() : 2; // Default to 2 if missing
 
-    std::vector<Transaction> userTransactions = transactionRepo.getByUserId(userId);
-    int activeBorrows = 0;
-    for (const auto &txn : userTransactions)
-    {
-        // Count active pending requests AND currently issued items
-        if (!txn.getIsReturned() &&
-            (txn.getTransactionStatus() == "PENDING" || txn.getTransactionStatus() == "ISSUED"))
-        {
-            activeBorrows++;
-        }
-    }
+    // Count active pending requests AND currently issued items
+    int activeBorrows = circulation.activeBorrows + circulation.pendingRequests;
 
     if (activeBorrows >= maxLimit)
     {
@@ -177,15 +131,18 @@ std::string UserService::requestToBorrow(int userId, int resourceId)
 
 std::vector<BorrowingHistory> UserService::getBorrowingHistory(int userId)
 {
+    PROFILE_ALLOCATIONS("UserService::getBorrowingHistory");
     return historyRepo.getByUserId(userId);
 }
 std::vector<Transaction> UserService::getTransactionHistory(int userId)
 {
+    PROFILE_ALLOCATIONS("UserService::getTransactionHistory");
     return transactionRepo.getByUserId(userId);
 }
 // Current is the same as Unpaid
 std::vector<Fine> UserService::getCurrentFines(int userId)
 {
+    PROFILE_ALLOCATIONS("UserService::getCurrentFines");
     std::vector<Fine> all = fineRepo.getByUserId(userId);
     std::vector<Fine> unpaid;
     for (const auto &fine : all)
@@ -2,6 +2,7 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <functional>
 
 // Including all Domains
 
@@ -12,6 +13,7 @@
 #include "../domain/BorrowingHistory.h"
 #include "../domain/FundRequest.h"
 #include "../domain/MembershipType.h"
+#include "../infrastructure/repositories/CatalogueSnapshot.h"
 
 // Forward declarations ( in this scope, only benificial for comiplation time otherwise no impact on runtime performance)
 
@@ -36,9 +38,6 @@ private:
     FundRequestRepository &fundReqRepo;
     MembershipTypeRepository &membershipRepo;
 
-    // the helper function
-    std::string toLowerCase(const std::string &str);
-
 public:
     UserService(UserRepository &usrRepo, ResourceRepository &resRepo, TransactionRepository &tranRepo,
                 FineRepository &finRepo, BorrowingHistoryRepository &brhRepo, FundRequestRepository &frRepo,
@@ -50,8 +49,10 @@ public:
     std::string requestAccountDeletion(int userId);
 
     // Catalogue
-    std::vector<Resource> showAllAvailableCatalogue();
-    std::vector<Resource> searchCatalogue(const std::string &keyword);
+    // Columnar snapshot of the catalogue; collectAvailable() lists what can be borrowed.
+    const CatalogueSnapshot &getCatalogueSnapshot();
+    // Ranked, prefix-matching search; limit/offset page through the results.
+    std::vector<Resource> searchCatalogue(const std::string &keyword, int limit = 20, int offset = 0);
 
     // Borrowing & Transactions
     std::string requestToBorrow(int userId, int resourceId);
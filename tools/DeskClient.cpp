@@ -0,0 +1,151 @@
+// Thin desk console for LibraryDeskServer. Sends each line typed (or piped)
+// on stdin as one request and prints the reply; HELP lists the commands.
+//
+//     LibraryDeskClient [--socket PATH]
+
+#include "server/DeskProtocol.h"
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#ifdef __linux__
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace
+{
+    // Buffered line reader over a blocking socket.
+    class LineReader
+    {
+    private:
+        int fd;
+        std::string buffer;
+
+    public:
+        explicit LineReader(int socketFd) : fd(socketFd) {}
+
+        bool next(std::string &line)
+        {
+            while (true)
+            {
+                std::size_t newline = buffer.find('\n');
+                if (newline != std::string::npos)
+                {
+                    line = buffer.substr(0, newline);
+                    buffer.erase(0, newline + 1);
+                    return true;
+                }
+
+                char chunk[4096];
+                ssize_t count = recv(fd, chunk, sizeof(chunk), 0);
+                if (count <= 0)
+                    return false;
+                buffer.append(chunk, static_cast<std::size_t>(count));
+            }
+        }
+    };
+
+    void printRow(const std::string &row)
+    {
+        std::string shown;
+        for (char c : row)
+        {
+            if (c == '\t')
+                shown += " | ";
+            else
+                shown.push_back(c);
+        }
+        std::cout << "  " << shown << "\n";
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    std::string socketPath = "/tmp/library-desk.sock";
+    for (int i = 1; i < argc; i++)
+    {
+        std::string option = argv[i];
+        if (option == "--socket" && i + 1 < argc)
+            socketPath = argv[++i];
+        else
+        {
+            std::cerr << "Usage: LibraryDeskClient [--socket PATH]\n";
+            return option == "--help" ? 0 : 1;
+        }
+    }
+
+    sockaddr_un address{};
+    if (socketPath.size() >= sizeof(address.sun_path))
+    {
+        std::cerr << "Socket path is too long.\n";
+        return 1;
+    }
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0)
+    {
+        std::cerr << "Cannot reach the desk server at " << socketPath << ": " << std::strerror(errno) << "\n";
+        return 1;
+    }
+
+    bool interactive = isatty(STDIN_FILENO);
+    LineReader replies(fd);
+    std::string request;
+    std::string line;
+
+    while (true)
+    {
+        if (interactive)
+            std::cout << "desk> " << std::flush;
+        if (!std::getline(std::cin, request))
+            break;
+        if (request.empty())
+            continue;
+
+        request.push_back('\n');
+        if (send(fd, request.data(), request.size(), MSG_NOSIGNAL) != static_cast<ssize_t>(request.size()))
+        {
+            std::cerr << "Connection lost.\n";
+            break;
+        }
+
+        bool ok = false;
+        std::size_t rows = 0;
+        if (!replies.next(line) || !DeskProtocol::parseReplyHeader(line, ok, rows))
+        {
+            std::cerr << "Connection lost.\n";
+            break;
+        }
+
+        if (!ok)
+        {
+            std::cout << line << "\n";
+            continue;
+        }
+
+        std::cout << "OK (" << rows << ")\n";
+        for (std::size_t i = 0; i < rows && replies.next(line); i++)
+            printRow(line);
+
+        DeskRequest sent;
+        if (DeskProtocol::parseRequest(request, sent) && sent.command == "QUIT")
+            break;
+    }
+
+    close(fd);
+    return 0;
+}
+
+#else
+
+int main()
+{
+    std::cerr << "LibraryDeskClient needs Unix-domain sockets; it runs on Linux only.\n";
+    return 1;
+}
+
+#endif
@@ -0,0 +1,86 @@
+// Circulation desk service: one long-running process that serves many desk
+// consoles over a Unix-domain socket (see src/server/DeskProtocol.h).
+//
+//     LibraryDeskServer [--db FILE] [--socket PATH] [--workers N]
+//                       [--max-clients N] [--date YYYY-MM-DD]
+//
+// Runs until SIGINT or SIGTERM.
+
+#include "server/DeskServer.h"
+#include "Utility/CivilDate.h"
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+static DeskServer *runningServer = nullptr;
+
+static void handleStopSignal(int)
+{
+    if (runningServer)
+        runningServer->stop();
+}
+
+static void printUsage()
+{
+    std::cerr << "Usage: LibraryDeskServer [--db FILE] [--socket PATH] [--workers N]\n"
+              << "                         [--max-clients N] [--date YYYY-MM-DD]\n";
+}
+
+int main(int argc, char *argv[])
+{
+    DeskServerOptions options;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string option = argv[i];
+        if (option == "--help")
+        {
+            printUsage();
+            return 0;
+        }
+        if (i + 1 >= argc)
+        {
+            printUsage();
+            return 1;
+        }
+
+        std::string value = argv[++i];
+        if (option == "--db")
+            options.dbFile = value;
+        else if (option == "--socket")
+            options.socketPath = value;
+        else if (option == "--workers")
+            options.workers = static_cast<std::size_t>(std::atoi(value.c_str()));
+        else if (option == "--max-clients")
+            options.maxClients = static_cast<std::size_t>(std::atoi(value.c_str()));
+        else if (option == "--date")
+            options.systemDate = value;
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+
+    CivilDate checked;
+    if (!options.systemDate.empty() && !CivilDate::parse(options.systemDate, checked))
+    {
+        std::cerr << "Invalid --date: " << options.systemDate << "\n";
+        return 1;
+    }
+
+    DeskServer server(options);
+    if (!server.start())
+        return 1;
+
+    runningServer = &server;
+    std::signal(SIGINT, handleStopSignal);
+    std::signal(SIGTERM, handleStopSignal);
+
+    server.run();
+
+    runningServer = nullptr;
+    std::cout << "[Desk] Stopped after " << server.getRequestsServed() << " requests.\n";
+    return 0;
+}